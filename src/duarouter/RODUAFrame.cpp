@@ -117,7 +117,7 @@ RODUAFrame::addImportOptions() {
     oc.addDescription("astar.landmark-distances", "Processing", "Initialize lookup table for astar ALT-variant from the given file");
 
     oc.doRegister("astar.save-landmark-distances", new Option_FileName());
-    oc.addDescription("astar.save-landmark-distances", "Processing", "Save lookup table for astar ALT-variant to the given file");
+    oc.addDescription("astar.save-landmark-distances", "Processing", "Save lookup table for astar ALT-variant to the given file (in binary format if it ends with '.bin')");
 }
 
 
@@ -226,8 +226,8 @@ namespace PHEMlightdll {
 
     double CEP::GetEmission(const std::string& pollutant, double power, double speed, Helpers* VehicleClass) {
         //Declaration
-        std::vector<double> emissionCurve;
-        std::vector<double> powerPattern;
+        std::vector<double>* emissionCurve;
+        std::vector<double>* powerPattern;
 
         // bisection search to find correct position in power pattern	
         int upperIndex;
@@ -250,8 +250,8 @@ namespace PHEMlightdll {
         }
 
         if (pollutant == "FC") {
-            emissionCurve = _cepCurveFC;
-            powerPattern = _powerPatternFC;
+            emissionCurve = &_cepCurveFC;
+            powerPattern = &_powerPatternFC;
         }
         else {
             if (_cepCurvePollutants.find(pollutant) == _cepCurvePollutants.end()) {
@@ -259,30 +259,30 @@ namespace PHEMlightdll {
                 return 0;
             }
 
-            emissionCurve = _cepCurvePollutants[pollutant];
-            powerPattern = _powerPatternPollutants;
+            emissionCurve = &_cepCurvePollutants[pollutant];
+            powerPattern = &_powerPatternPollutants;
         }
 
-        if (emissionCurve.empty()) {
+        if (emissionCurve->empty()) {
             VehicleClass->setErrMsg(std::string("Empty emission curve for ") + pollutant + std::string(" found!"));
             return 0;
         }
-        if (emissionCurve.size() == 1) {
-            return emissionCurve[0];
+        if (emissionCurve->size() == 1) {
+            return (*emissionCurve)[0];
         }
 
         // in case that the demanded power is smaller than the first entry (smallest) in the power pattern the first is returned (should never happen)
-        if (power <= powerPattern.front()) {
-            return emissionCurve[0];
+        if (power <= powerPattern->front()) {
+            return (*emissionCurve)[0];
         }
 
         // if power bigger than all entries in power pattern return the last (should never happen)
-        if (power >= powerPattern.back()) {
-            return emissionCurve.back();
+        if (power >= powerPattern->back()) {
+            return emissionCurve->back();
         }
 
-        FindLowerUpperInPattern(lowerIndex, upperIndex, powerPattern, power);
-        return Interpolate(power, powerPattern[lowerIndex], powerPattern[upperIndex], emissionCurve[lowerIndex], emissionCurve[upperIndex]);
+        FindLowerUpperInPattern(lowerIndex, upperIndex, *powerPattern, power);
+        return Interpolate(power, (*powerPattern)[lowerIndex], (*powerPattern)[upperIndex], (*emissionCurve)[lowerIndex], (*emissionCurve)[upperIndex]);
     }
 
     double CEP::GetCO2Emission(double _FC, double _CO, double _HC, Helpers* VehicleClass) {
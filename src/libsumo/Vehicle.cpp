@@ -24,6 +24,7 @@
 #include <config.h>
 #endif
 
+#include <limits>
 #include <utils/geom/GeomHelper.h>
 #include <utils/common/StringTokenizer.h>
 #include <utils/common/StringUtils.h>
@@ -32,6 +33,7 @@
 #include <utils/xml/SUMOVehicleParserHelper.h>
 #include <microsim/traffic_lights/MSTrafficLightLogic.h>
 #include <microsim/lcmodels/MSAbstractLaneChangeModel.h>
+#include <microsim/cfmodels/MSCFModel_CC.h>
 #include <microsim/devices/MSDevice.h>
 #include <microsim/MSEdgeWeightsStorage.h>
 #include <microsim/MSVehicle.h>
@@ -52,20 +54,69 @@ namespace libsumo {
 // ===========================================================================
 // member definitions
 // ===========================================================================
+SUMOVehicle*
+Vehicle::findVehicle(const std::string& id) {
+    const MSVehicleControl& c = MSNet::getInstance()->getVehicleControl();
+    SUMOVehicle* sumoVehicle = c.getVehicle(id);
+    if (sumoVehicle == 0 && id.size() > 1 && id.size() < 11 && id[0] == '#') {
+        // real ids take precedence, only then try to interpret it as a handle
+        long long int handle = 0;
+        for (std::string::const_iterator it = id.begin() + 1; it != id.end(); ++it) {
+            if (*it < '0' || *it > '9') {
+                return 0;
+            }
+            handle = 10 * handle + (*it - '0');
+        }
+        if (handle > std::numeric_limits<int>::max()) {
+            return 0;
+        }
+        sumoVehicle = findVehicleByHandle((int)handle);
+    }
+    return sumoVehicle;
+}
+
+
+SUMOVehicle*
+Vehicle::findVehicleByHandle(int handle) {
+    return MSNet::getInstance()->getVehicleControl().getVehicleByHandle(handle);
+}
+
+
 MSVehicle*
 Vehicle::getVehicle(const std::string& id) {
-    SUMOVehicle* sumoVehicle = MSNet::getInstance()->getVehicleControl().getVehicle(id);
+    return checkMicroVehicle(findVehicle(id), "Vehicle '" + id + "'");
+}
+
+
+MSVehicle*
+Vehicle::getVehicle(int handle) {
+    return checkMicroVehicle(findVehicleByHandle(handle), "Vehicle with handle " + toString(handle));
+}
+
+
+MSVehicle*
+Vehicle::checkMicroVehicle(SUMOVehicle* sumoVehicle, const std::string& description) {
     if (sumoVehicle == 0) {
-        throw TraCIException("Vehicle '" + id + "' is not known");
+        throw TraCIException(description + " is not known");
     }
     MSVehicle* v = dynamic_cast<MSVehicle*>(sumoVehicle);
     if (v == 0) {
-        throw TraCIException("Vehicle '" + id + "' is not a micro-simulation vehicle");
+        throw TraCIException(description + " is not a micro-simulation vehicle");
     }
     return v;
 }
 
 
+const MSCFModel_CC&
+Vehicle::getCCModel(const MSVehicle* veh) {
+    const MSCFModel_CC* model = dynamic_cast<const MSCFModel_CC*>(&veh->getCarFollowModel());
+    if (model == 0) {
+        throw TraCIException("Vehicle '" + veh->getID() + "' does not use the CC car following model");
+    }
+    return *model;
+}
+
+
 bool
 Vehicle::isVisible(const MSVehicle* veh) {
     return veh->isOnRoad() || veh->isParking() || veh->wasRemoteControlled();
@@ -95,16 +146,44 @@ Vehicle::getIDCount() {
     return (int)getIDList().size();
 }
 
+
+int
+Vehicle::getHandle(const std::string& vehicleID) {
+    return MSNet::getInstance()->getVehicleControl().getHandle(getVehicle(vehicleID)->getID());
+}
+
 double
 Vehicle::getSpeed(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
+    return getSpeed(getVehicle(vehicleID));
+}
+
+
+double
+Vehicle::getSpeed(int handle) {
+    return getSpeed(getVehicle(handle));
+}
+
+
+double
+Vehicle::getSpeed(const MSVehicle* veh) {
     return isVisible(veh) ? veh->getSpeed() : INVALID_DOUBLE_VALUE;
 }
 
 
 double
 Vehicle::getAcceleration(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
+    return getAcceleration(getVehicle(vehicleID));
+}
+
+
+double
+Vehicle::getAcceleration(int handle) {
+    return getAcceleration(getVehicle(handle));
+}
+
+
+double
+Vehicle::getAcceleration(const MSVehicle* veh) {
     return isVisible(veh) ? veh->getAcceleration() : INVALID_DOUBLE_VALUE;
 }
 
@@ -118,7 +197,18 @@ Vehicle::getSpeedWithoutTraCI(const std::string& vehicleID) {
 
 TraCIPosition
 Vehicle::getPosition(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
+    return getPosition(getVehicle(vehicleID));
+}
+
+
+TraCIPosition
+Vehicle::getPosition(int handle) {
+    return getPosition(getVehicle(handle));
+}
+
+
+TraCIPosition
+Vehicle::getPosition(const MSVehicle* veh) {
     if (isVisible(veh)) {
         return Helper::makeTraCIPosition(veh->getPosition());
     } else {
@@ -133,7 +223,18 @@ Vehicle::getPosition(const std::string& vehicleID) {
 
 double
 Vehicle::getAngle(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
+    return getAngle(getVehicle(vehicleID));
+}
+
+
+double
+Vehicle::getAngle(int handle) {
+    return getAngle(getVehicle(handle));
+}
+
+
+double
+Vehicle::getAngle(const MSVehicle* veh) {
     return isVisible(veh) ? GeomHelper::naviDegree(veh->getAngle()) : INVALID_DOUBLE_VALUE;
 }
 
@@ -147,21 +248,54 @@ Vehicle::getSlope(const std::string& vehicleID) {
 
 std::string
 Vehicle::getRoadID(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
+    return getRoadID(getVehicle(vehicleID));
+}
+
+
+std::string
+Vehicle::getRoadID(int handle) {
+    return getRoadID(getVehicle(handle));
+}
+
+
+std::string
+Vehicle::getRoadID(const MSVehicle* veh) {
     return isVisible(veh) ? veh->getLane()->getEdge().getID() : "";
 }
 
 
 std::string
 Vehicle::getLaneID(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
+    return getLaneID(getVehicle(vehicleID));
+}
+
+
+std::string
+Vehicle::getLaneID(int handle) {
+    return getLaneID(getVehicle(handle));
+}
+
+
+std::string
+Vehicle::getLaneID(const MSVehicle* veh) {
     return veh->isOnRoad() ? veh->getLane()->getID() : "";
 }
 
 
 int
 Vehicle::getLaneIndex(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
+    return getLaneIndex(getVehicle(vehicleID));
+}
+
+
+int
+Vehicle::getLaneIndex(int handle) {
+    return getLaneIndex(getVehicle(handle));
+}
+
+
+int
+Vehicle::getLaneIndex(const MSVehicle* veh) {
     return veh->isOnRoad() ? veh->getLane()->getIndex() : INVALID_INT_VALUE;
 }
 
@@ -188,7 +322,18 @@ Vehicle::getColor(const std::string& vehicleID) {
 
 double
 Vehicle::getLanePosition(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
+    return getLanePosition(getVehicle(vehicleID));
+}
+
+
+double
+Vehicle::getLanePosition(int handle) {
+    return getLanePosition(getVehicle(handle));
+}
+
+
+double
+Vehicle::getLanePosition(const MSVehicle* veh) {
     return veh->isOnRoad() ? veh->getPositionOnLane() : INVALID_DOUBLE_VALUE;
 }
 
@@ -1325,6 +1470,55 @@ Vehicle::setParameter(const std::string& vehicleID, const std::string& key, cons
 
 
 
+void
+Vehicle::setPlatoonLeaderData(const std::string& vehicleID, const Plexe::SPEED_AND_ACCELERATION& data) {
+    MSVehicle* veh = getVehicle(vehicleID);
+    getCCModel(veh).setLeaderInformation(veh, data);
+}
+
+
+void
+Vehicle::setPlatoonFrontData(const std::string& vehicleID, const Plexe::SPEED_AND_ACCELERATION& data) {
+    MSVehicle* veh = getVehicle(vehicleID);
+    getCCModel(veh).setFrontInformation(veh, data);
+}
+
+
+void
+Vehicle::setPlatoonVehicleData(const std::string& vehicleID, const Plexe::VEHICLE_DATA& data) {
+    MSVehicle* veh = getVehicle(vehicleID);
+    getCCModel(veh).setVehicleData(veh, data);
+}
+
+
+void
+Vehicle::setPlatoonLeaderFakeData(const std::string& vehicleID, double speed, double acceleration, double controllerAcceleration) {
+    MSVehicle* veh = getVehicle(vehicleID);
+    getCCModel(veh).setLeaderFakeData(veh, speed, acceleration, controllerAcceleration);
+}
+
+
+void
+Vehicle::setPlatoonFrontFakeData(const std::string& vehicleID, double speed, double acceleration, double distance, double controllerAcceleration) {
+    MSVehicle* veh = getVehicle(vehicleID);
+    getCCModel(veh).setFrontFakeData(veh, speed, acceleration, distance, controllerAcceleration);
+}
+
+
+void
+Vehicle::getPlatoonSpeedAndAcceleration(const std::string& vehicleID, Plexe::SPEED_AND_ACCELERATION& into, bool realisticSensor) {
+    MSVehicle* veh = getVehicle(vehicleID);
+    getCCModel(veh).getSpeedAndAcceleration(veh, into, realisticSensor);
+}
+
+
+void
+Vehicle::getPlatoonVehicleData(const std::string& vehicleID, int index, Plexe::VEHICLE_DATA& into, bool realisticSensor) {
+    MSVehicle* veh = getVehicle(vehicleID);
+    getCCModel(veh).getVehicleData(veh, index, into, realisticSensor);
+}
+
+
 }
 
 /****************************************************************************/
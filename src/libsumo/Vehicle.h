@@ -32,6 +32,9 @@
 #include <vector>
 #include <libsumo/TraCIDefs.h>
 #include <traci-server/TraCIConstants.h>
+#ifndef SWIG
+#include <microsim/cfmodels/CC_Const.h>
+#endif
 
 
 // ===========================================================================
@@ -39,6 +42,8 @@
 // ===========================================================================
 class MSVehicle;
 class MSVehicleType;
+class SUMOVehicle;
+class MSCFModel_CC;
 
 
 // ===========================================================================
@@ -55,6 +60,8 @@ public:
     /// @{
     static std::vector<std::string> getIDList();
     static int getIDCount();
+    /// @brief returns the numerical handle of the vehicle which may be used as id "#<handle>" while the vehicle exists
+    static int getHandle(const std::string& vehicleID);
     static double getSpeed(const std::string& vehicleID);
     static double getAcceleration(const std::string& vehicleID);
     static double getSpeedWithoutTraCI(const std::string& vehicleID);
@@ -190,9 +197,55 @@ public:
     static void setParameter(const std::string& vehicleID, const std::string& key, const std::string& value);
     /// @}
 
+    /// @name Value retrieval by numerical handle (see getHandle), avoiding the string id lookup
+    /// @{
+    static double getSpeed(int handle);
+    static double getAcceleration(int handle);
+    static TraCIPosition getPosition(int handle);
+    static double getAngle(int handle);
+    static std::string getRoadID(int handle);
+    static std::string getLaneID(int handle);
+    static int getLaneIndex(int handle);
+    static double getLanePosition(int handle);
+    /// @}
+
+#ifndef SWIG
+    /// @name Typed platooning (Plexe) data exchange, vehicles need to use the CC car following model
+    /// @{
+    static void setPlatoonLeaderData(const std::string& vehicleID, const Plexe::SPEED_AND_ACCELERATION& data);
+    static void setPlatoonFrontData(const std::string& vehicleID, const Plexe::SPEED_AND_ACCELERATION& data);
+    static void setPlatoonVehicleData(const std::string& vehicleID, const Plexe::VEHICLE_DATA& data);
+    static void setPlatoonLeaderFakeData(const std::string& vehicleID, double speed, double acceleration, double controllerAcceleration);
+    static void setPlatoonFrontFakeData(const std::string& vehicleID, double speed, double acceleration, double distance, double controllerAcceleration);
+    static void getPlatoonSpeedAndAcceleration(const std::string& vehicleID, Plexe::SPEED_AND_ACCELERATION& into, bool realisticSensor = false);
+    static void getPlatoonVehicleData(const std::string& vehicleID, int index, Plexe::VEHICLE_DATA& into, bool realisticSensor = false);
+    /// @}
+
+    /// @brief returns the vehicle with the given id (or numerical handle "#<handle>"), 0 if there is none
+    static SUMOVehicle* findVehicle(const std::string& id);
+
+    /// @brief returns the vehicle with the given numerical handle, 0 if the handle is unknown or stale
+    static SUMOVehicle* findVehicleByHandle(int handle);
+#endif
+
 private:
     static MSVehicle* getVehicle(const std::string& id);
 
+    static MSVehicle* getVehicle(int handle);
+
+    static MSVehicle* checkMicroVehicle(SUMOVehicle* sumoVehicle, const std::string& description);
+
+    static double getSpeed(const MSVehicle* veh);
+    static double getAcceleration(const MSVehicle* veh);
+    static TraCIPosition getPosition(const MSVehicle* veh);
+    static double getAngle(const MSVehicle* veh);
+    static std::string getRoadID(const MSVehicle* veh);
+    static std::string getLaneID(const MSVehicle* veh);
+    static int getLaneIndex(const MSVehicle* veh);
+    static double getLanePosition(const MSVehicle* veh);
+
+    static const MSCFModel_CC& getCCModel(const MSVehicle* veh);
+
     static bool isVisible(const MSVehicle* veh);
 
     static bool isOnInit(const std::string& vehicleID);
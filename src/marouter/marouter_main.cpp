@@ -125,21 +125,22 @@ computeAllPairs(RONet& net, OptionsCont& oc) {
     ConstROEdgeVector into;
     const int numInternalEdges = net.getInternalEdgeNumber();
     const int numTotalEdges = (int)net.getEdgeNumber();
+    const ROEdgeVector& edges = ROEdge::getAllEdges();
     for (int i = numInternalEdges; i < numTotalEdges; i++) {
-        const Dijkstra::EdgeInfo& ei = router.getEdgeInfo(i);
-        if (!ei.edge->isInternal()) {
-            router.compute(ei.edge, 0, 0, 0, into);
-            double fromEffort = router.getEffort(ei.edge, 0, 0);
+        const ROEdge* const edge = edges[i];
+        if (!edge->isInternal()) {
+            router.compute(edge, 0, 0, 0, into);
+            double fromEffort = router.getEffort(edge, 0, 0);
             for (int j = numInternalEdges; j < numTotalEdges; j++) {
-                double heuTT = router.getEdgeInfo(j).effort - fromEffort;
+                double heuTT = router.getEffortFromStart(j) - fromEffort;
                 FileHelpers::writeFloat(outFile, heuTT);
                 /*
                 if (heuTT >
-                        ei.edge->getDistanceTo(router.getEdgeInfo(j).edge)
-                        && router.getEdgeInfo(j).traveltime != std::numeric_limits<double>::max()
+                        edge->getDistanceTo(edges[j])
+                        && router.getEffortFromStart(j) != std::numeric_limits<double>::max()
                         ) {
-                    std::cout << " heuristic failure: from=" << ei.edge->getID() << " to=" << router.getEdgeInfo(j).edge->getID()
-                    << " fromEffort=" << fromEffort << " heuTT=" << heuTT << " airDist=" << ei.edge->getDistanceTo(router.getEdgeInfo(j).edge) << "\n";
+                    std::cout << " heuristic failure: from=" << edge->getID() << " to=" << edges[j]->getID()
+                    << " fromEffort=" << fromEffort << " heuTT=" << heuTT << " airDist=" << edge->getDistanceTo(edges[j]) << "\n";
                 }
                 */
             }
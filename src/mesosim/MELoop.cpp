@@ -46,10 +46,19 @@
 #include "MEVehicle.h"
 
 
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const SUMOTime MELoop::CALENDAR_SIZE = 1 << 16;
+
+
 // ===========================================================================
 // method definitions
 // ===========================================================================
-MELoop::MELoop(const SUMOTime recheckInterval) : myFullRecheckInterval(recheckInterval), myLinkRecheckInterval(TIME2STEPS(1)) {
+MELoop::MELoop(const SUMOTime recheckInterval) :
+    myCalendar((int)CALENDAR_SIZE), myOccupiedSlots((int)CALENDAR_SIZE / 64, 0),
+    myCalendarStart(0), myNumCalendarEvents(0),
+    myFullRecheckInterval(recheckInterval), myLinkRecheckInterval(TIME2STEPS(1)) {
 }
 
 MELoop::~MELoop() {
@@ -65,18 +74,9 @@ MELoop::~MELoop() {
 
 void
 MELoop::simulate(SUMOTime tMax) {
-    while (!myLeaderCars.empty()) {
-        const SUMOTime time = myLeaderCars.begin()->first;
-        assert(time > tMax - DELTA_T);
-        if (time > tMax) {
-            return;
-        }
-        std::vector<MEVehicle*> vehs = myLeaderCars[time];
-        myLeaderCars.erase(time);
-        for (std::vector<MEVehicle*>::const_iterator i = vehs.begin(); i != vehs.end(); ++i) {
-            checkCar(*i);
-            assert(myLeaderCars.empty() || myLeaderCars.begin()->first >= time);
-        }
+    for (MEVehicle* veh = popEvent(tMax); veh != 0; veh = popEvent(tMax)) {
+        assert(veh->getEventTime() > tMax - DELTA_T);
+        checkCar(veh);
     }
 }
 
@@ -200,7 +200,7 @@ MELoop::teleportVehicle(MEVehicle* veh, MESegment* const toSegment) {
 
 void
 MELoop::addLeaderCar(MEVehicle* veh, MSLink* link) {
-    myLeaderCars[veh->getEventTime()].push_back(veh);
+    insertEvent(veh);
     setApproaching(veh, link);
 }
 
@@ -220,8 +220,156 @@ MELoop::setApproaching(MEVehicle* veh, MSLink* link) {
 
 void
 MELoop::removeLeaderCar(MEVehicle* v) {
-    std::vector<MEVehicle*>& cands = myLeaderCars[v->getEventTime()];
-    cands.erase(find(cands.begin(), cands.end(), v));
+    removeEvent(v);
+}
+
+
+MELoop::EventSlot&
+MELoop::getEventSlot(const SUMOTime t) {
+    assert(t >= myCalendarStart);
+    if (t - myCalendarStart < CALENDAR_SIZE) {
+        return myCalendar[(int)(t & (CALENDAR_SIZE - 1))];
+    }
+    return myFarEvents[t];
+}
+
+
+void
+MELoop::markSlot(const SUMOTime t, const bool occupied) {
+    const int index = (int)(t & (CALENDAR_SIZE - 1));
+    if (occupied) {
+        myOccupiedSlots[index >> 6] |= 1ULL << (index & 63);
+    } else {
+        myOccupiedSlots[index >> 6] &= ~(1ULL << (index & 63));
+    }
+}
+
+
+void
+MELoop::insertEvent(MEVehicle* veh) {
+    const SUMOTime t = veh->getEventTime();
+    if (myNumCalendarEvents == 0 && myFarEvents.empty()) {
+        myCalendarStart = t;
+    } else if (t < myCalendarStart) {
+        rewindCalendar(t);
+    }
+    EventSlot& slot = getEventSlot(t);
+    veh->myPrevEvent = slot.last;
+    veh->myNextEvent = 0;
+    if (slot.last == 0) {
+        slot.first = veh;
+    } else {
+        slot.last->myNextEvent = veh;
+    }
+    slot.last = veh;
+    if (t - myCalendarStart < CALENDAR_SIZE) {
+        markSlot(t, true);
+        myNumCalendarEvents++;
+    }
+}
+
+
+void
+MELoop::removeEvent(MEVehicle* veh) {
+    const SUMOTime t = veh->getEventTime();
+    EventSlot& slot = getEventSlot(t);
+    if (veh->myPrevEvent == 0) {
+        assert(slot.first == veh);
+        slot.first = veh->myNextEvent;
+    } else {
+        veh->myPrevEvent->myNextEvent = veh->myNextEvent;
+    }
+    if (veh->myNextEvent == 0) {
+        assert(slot.last == veh);
+        slot.last = veh->myPrevEvent;
+    } else {
+        veh->myNextEvent->myPrevEvent = veh->myPrevEvent;
+    }
+    veh->myPrevEvent = 0;
+    veh->myNextEvent = 0;
+    if (t - myCalendarStart < CALENDAR_SIZE) {
+        myNumCalendarEvents--;
+        if (slot.first == 0) {
+            markSlot(t, false);
+        }
+    } else if (slot.first == 0) {
+        myFarEvents.erase(t);
+    }
+}
+
+
+MEVehicle*
+MELoop::popEvent(const SUMOTime tMax) {
+    if (myNumCalendarEvents == 0) {
+        if (myFarEvents.empty() || myFarEvents.begin()->first > tMax) {
+            return 0;
+        }
+        advanceCalendar(myFarEvents.begin()->first);
+    }
+    // all calendar events are within the calendar, so the search ends at its last slot
+    const SUMOTime end = MIN2(tMax, myCalendarStart + CALENDAR_SIZE - 1);
+    SUMOTime t = myCalendarStart;
+    while (t <= end) {
+        const int index = (int)(t & (CALENDAR_SIZE - 1));
+        const unsigned long long int bits = myOccupiedSlots[index >> 6] >> (index & 63);
+        if (bits == 0) {
+            t += 64 - (index & 63);
+            continue;
+        }
+        int offset = 0;
+        while (((bits >> offset) & 1) == 0) {
+            offset++;
+        }
+        t += offset;
+        if (t > end) {
+            break;
+        }
+        advanceCalendar(t);
+        MEVehicle* const veh = myCalendar[index + offset].first;
+        removeEvent(veh);
+        return veh;
+    }
+    if (tMax > myCalendarStart) {
+        // keep the calendar close to the simulation time
+        advanceCalendar(tMax);
+    }
+    return 0;
+}
+
+
+void
+MELoop::advanceCalendar(const SUMOTime newStart) {
+    myCalendarStart = newStart;
+    // the slots of the newly covered times are empty since there are no events before the new start
+    while (!myFarEvents.empty() && myFarEvents.begin()->first - newStart < CALENDAR_SIZE) {
+        const SUMOTime t = myFarEvents.begin()->first;
+        EventSlot& slot = myCalendar[(int)(t & (CALENDAR_SIZE - 1))];
+        assert(slot.first == 0);
+        slot = myFarEvents.begin()->second;
+        for (MEVehicle* veh = slot.first; veh != 0; veh = veh->myNextEvent) {
+            myNumCalendarEvents++;
+        }
+        markSlot(t, true);
+        myFarEvents.erase(myFarEvents.begin());
+    }
+}
+
+
+void
+MELoop::rewindCalendar(const SUMOTime newStart) {
+    // the events at or after newStart + CALENDAR_SIZE leave the calendar
+    for (SUMOTime t = MAX2(myCalendarStart, newStart + CALENDAR_SIZE); t < myCalendarStart + CALENDAR_SIZE; t++) {
+        EventSlot& slot = myCalendar[(int)(t & (CALENDAR_SIZE - 1))];
+        if (slot.first != 0) {
+            for (MEVehicle* veh = slot.first; veh != 0; veh = veh->myNextEvent) {
+                myNumCalendarEvents--;
+            }
+            myFarEvents[t] = slot;
+            slot = EventSlot();
+            markSlot(t, false);
+        }
+    }
+    myCalendarStart = newStart;
 }
 
 
@@ -49,6 +49,13 @@ class OptionsCont;
 /**
  * @class MELoop
  * @brief The main mesocopic simulation loop
+ *
+ * The leading vehicles of the segments are kept in an event calendar with one
+ *  slot per millisecond for the near future (a ring which moves with the
+ *  simulation time) and a map for the events beyond. The vehicles of a slot
+ *  form a doubly linked list (using members of MEVehicle), so adding and
+ *  removing a vehicle takes constant time without any allocation and the
+ *  vehicles with the same event time are processed in the order of their addition.
  */
 class MELoop {
 public:
@@ -139,9 +146,56 @@ private:
      */
     void teleportVehicle(MEVehicle* veh, MESegment* const toSegment);
 
+    /// @name event calendar methods
+    /// @{
+
+    /// @brief the first and the last vehicle of the list of vehicles with the same event time
+    struct EventSlot {
+        EventSlot() : first(0), last(0) {}
+        MEVehicle* first;
+        MEVehicle* last;
+    };
+
+    /// @brief returns the slot for the given time (which needs to be at or after the calendar start)
+    EventSlot& getEventSlot(const SUMOTime t);
+
+    /// @brief appends the vehicle to the slot of its event time
+    void insertEvent(MEVehicle* veh);
+
+    /// @brief removes the vehicle from the slot of its event time
+    void removeEvent(MEVehicle* veh);
+
+    /// @brief removes and returns the first vehicle with the earliest event time if it is not after tMax (0 otherwise)
+    MEVehicle* popEvent(const SUMOTime tMax);
+
+    /// @brief moves the calendar start forward (there must be no events before the new start)
+    void advanceCalendar(const SUMOTime newStart);
+
+    /// @brief moves the calendar start backward, moving the events beyond the calendar to the far events
+    void rewindCalendar(const SUMOTime newStart);
+
+    /// @brief sets or clears the flag for the slot of the given time
+    void markSlot(const SUMOTime t, const bool occupied);
+    /// @}
+
 private:
-    /// @brief leader cars in the segments sorted by exit time
-    std::map<SUMOTime, std::vector<MEVehicle*> > myLeaderCars;
+    /// @brief the calendar of leader cars in the segments by exit time (indexed by time modulo the calendar size)
+    std::vector<EventSlot> myCalendar;
+
+    /// @brief a bit per calendar slot telling whether the slot is occupied
+    std::vector<unsigned long long int> myOccupiedSlots;
+
+    /// @brief the time of the first slot of the calendar
+    SUMOTime myCalendarStart;
+
+    /// @brief the number of vehicles in the calendar
+    int myNumCalendarEvents;
+
+    /// @brief leader cars with an exit time beyond the calendar
+    std::map<SUMOTime, EventSlot> myFarEvents;
+
+    /// @brief the number of slots of the calendar (a power of two)
+    static const SUMOTime CALENDAR_SIZE;
 
     /// @brief mapping from internal edge ids to their initial segments
     std::vector<MESegment*> myEdges2FirstSegments;
@@ -47,6 +47,9 @@ class MSLink;
  * @brief A vehicle from the mesoscopic point of view
  */
 class MEVehicle : public MSBaseVehicle {
+    /// @brief the event calendar of MELoop links the vehicles directly
+    friend class MELoop;
+
 public:
     /** @brief Constructor
      * @param[in] pars The vehicle description
@@ -363,6 +366,10 @@ protected:
     /// @brief The time at which the vehicle was blocked on its current segment
     SUMOTime myBlockTime;
 
+    /// @brief The neighbours with the same event time in MELoop's event calendar
+    MEVehicle* myPrevEvent;
+    MEVehicle* myNextEvent;
+
     /// @brief where to stop
     std::map<const MESegment* const, std::vector<SUMOVehicleParameter::Stop> > myStops;
 
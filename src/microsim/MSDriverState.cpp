@@ -98,11 +98,11 @@ OUProcess::~OUProcess() {}
 
 
 void
-OUProcess::step(double dt) {
+OUProcess::step(double dt, std::mt19937* rng) {
 #ifdef DEBUG_OUPROCESS
     const double oldstate = myState;
 #endif
-    myState = exp(-dt/myTimeScale)*myState + myNoiseIntensity*sqrt(2*dt/myTimeScale)*RandHelper::randNorm(0, 1);
+    myState = exp(-dt/myTimeScale)*myState + myNoiseIntensity*sqrt(2*dt/myTimeScale)*RandHelper::randNorm(0, 1, rng);
 #ifdef DEBUG_OUPROCESS
     std::cout << "  OU-step (" << dt << " s.): " << oldstate << "->" << myState << std::endl;
 #endif
@@ -162,7 +162,8 @@ MSSimpleDriverState::updateError() {
     } else {
         myError.setTimeScale(myErrorTimeScaleCoefficient*myAwareness);
         myError.setNoiseIntensity(myErrorNoiseIntensityCoefficient*(1.-myAwareness));
-        myError.step(myStepDuration);
+        // the update is part of planMove which may run in parallel, so use the generator of the lane
+        myError.step(myStepDuration, myVehicle->getRNG());
     }
 }
 
@@ -27,6 +27,7 @@
 #endif
 
 #include <memory>
+#include <random>
 #include <utils/common/SUMOTime.h>
 #include <utils/xml/SUMOXMLDefinitions.h>
 
@@ -54,8 +55,8 @@ public:
     /// @brief destructor
     ~OUProcess();
 
-    /// @brief evolve for a time step of length dt.
-    void step(double dt);
+    /// @brief evolve for a time step of length dt (drawing from the given random number generator).
+    void step(double dt, std::mt19937* rng = 0);
 
     /// @brief set the process' timescale to a new value
     void setTimeScale(double timeScale) {
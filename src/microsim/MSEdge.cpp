@@ -317,20 +317,28 @@ MSEdge::allowedLanes(const MSEdge* destination, SUMOVehicleClass vclass) const {
         // all lanes allow vclass
         return getAllowedLanesWithDefault(myAllowed, destination);
     }
+#ifdef HAVE_FOX
+    // the cache may be filled concurrently by parallel routing or parallel planMovements
+    const bool haveLock = MSDevice_Routing::isParallel() || MSGlobals::gNumSimThreads > 1;
+    if (haveLock) {
+        MSDevice_Routing::lock();
+    }
+#endif
     // look up cached result in myClassedAllowed
     ClassedAllowedLanesCont::const_iterator i = myClassedAllowed.find(vclass);
     if (i != myClassedAllowed.end()) {
         // can use cached value
         const AllowedLanesCont& c = (*i).second;
-        return getAllowedLanesWithDefault(c, destination);
-    } else {
-        // this vclass is requested for the first time. rebuild all destinations
-        // go through connected edges
+        const std::vector<MSLane*>* const result = getAllowedLanesWithDefault(c, destination);
 #ifdef HAVE_FOX
-        if (MSDevice_Routing::isParallel()) {
-            MSDevice_Routing::lock();
+        if (haveLock) {
+            MSDevice_Routing::unlock();
         }
 #endif
+        return result;
+    } else {
+        // this vclass is requested for the first time. rebuild all destinations
+        // go through connected edges
         for (AllowedLanesCont::const_iterator i1 = myAllowed.begin(); i1 != myAllowed.end(); ++i1) {
             const MSEdge* edge = i1->first;
             const std::vector<MSLane*>* lanes = i1->second;
@@ -361,12 +369,13 @@ MSEdge::allowedLanes(const MSEdge* destination, SUMOVehicleClass vclass) const {
                 myClassedAllowed[vclass][edge] = 0;
             }
         }
+        const std::vector<MSLane*>* const result = myClassedAllowed[vclass][destination];
 #ifdef HAVE_FOX
-        if (MSDevice_Routing::isParallel()) {
+        if (haveLock) {
             MSDevice_Routing::unlock();
         }
 #endif
-        return myClassedAllowed[vclass][destination];
+        return result;
     }
 }
 
@@ -927,7 +936,9 @@ MSEdge::getSuccessors(SUMOVehicleClass vClass) const {
         return mySuccessors;
     }
 #ifdef HAVE_FOX
-    if (MSDevice_Routing::isParallel()) {
+    // the cache may be filled concurrently by parallel routing or parallel planMovements
+    const bool haveLock = MSDevice_Routing::isParallel() || MSGlobals::gNumSimThreads > 1;
+    if (haveLock) {
         MSDevice_Routing::lock();
     }
 #endif
@@ -950,7 +961,7 @@ MSEdge::getSuccessors(SUMOVehicleClass vClass) const {
     }
     // can use cached value
 #ifdef HAVE_FOX
-    if (MSDevice_Routing::isParallel()) {
+    if (haveLock) {
         MSDevice_Routing::unlock();
     }
 #endif
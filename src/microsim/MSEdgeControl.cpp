@@ -32,7 +32,9 @@
 #include "MSGlobals.h"
 #include "MSEdge.h"
 #include "MSLane.h"
+#include "MSLink.h"
 #include "MSVehicle.h"
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
@@ -44,6 +46,15 @@ MSEdgeControl::MSEdgeControl(const std::vector< MSEdge* >& edges)
     : myEdges(edges),
       myLanes(MSLane::dictSize()),
       myLastLaneChange(MSEdge::dictSize()) {
+    myActiveLanes.reserve(myLanes.size());
+    myActiveLanesBuffer.reserve(myLanes.size());
+#ifdef HAVE_FOX
+    if (MSGlobals::gNumSimThreads > 1) {
+        while (myThreadPool.size() < MSGlobals::gNumSimThreads) {
+            new FXWorkerThread(myThreadPool);
+        }
+    }
+#endif
     // build the usage definitions for lanes
     for (std::vector< MSEdge* >::const_iterator i = myEdges.begin(); i != myEdges.end(); ++i) {
         const std::vector<MSLane*>& lanes = (*i)->getLanes();
@@ -75,60 +86,109 @@ MSEdgeControl::~MSEdgeControl() {
 
 void
 MSEdgeControl::patchActiveLanes() {
-    for (std::set<MSLane*, ComparatorIdLess>::iterator i = myChangedStateLanes.begin(); i != myChangedStateLanes.end(); ++i) {
+    if (myChangedStateLanes.empty()) {
+        return;
+    }
+    // activate in the order of ids regardless of the order of insertion
+    std::sort(myChangedStateLanes.begin(), myChangedStateLanes.end(), ComparatorIdLess());
+    myChangedStateLanes.erase(std::unique(myChangedStateLanes.begin(), myChangedStateLanes.end()), myChangedStateLanes.end());
+    for (std::vector<MSLane*>::iterator i = myChangedStateLanes.begin(); i != myChangedStateLanes.end(); ++i) {
         LaneUsage& lu = myLanes[(*i)->getNumericalID()];
         // if the lane was inactive but is now...
         if (!lu.amActive && (*i)->getVehicleNumber() > 0) {
             // ... add to active lanes and mark as such
-            if (lu.haveNeighbors) {
-                myActiveLanes.push_front(*i);
-            } else {
-                myActiveLanes.push_back(*i);
-            }
+            myLanesToActivate.push_back(*i);
             lu.amActive = true;
         }
     }
     myChangedStateLanes.clear();
+    addActiveLanes();
 }
 
+
+void
+MSEdgeControl::addActiveLanes() {
+    if (myLanesToActivate.empty()) {
+        return;
+    }
+    // lanes of multi-lane edges go to the front (the last activated first), others to the back
+    myActiveLanesBuffer.clear();
+    for (std::vector<MSLane*>::reverse_iterator i = myLanesToActivate.rbegin(); i != myLanesToActivate.rend(); ++i) {
+        if (myLanes[(*i)->getNumericalID()].haveNeighbors) {
+            myActiveLanesBuffer.push_back(*i);
+        }
+    }
+    myActiveLanesBuffer.insert(myActiveLanesBuffer.end(), myActiveLanes.begin(), myActiveLanes.end());
+    for (std::vector<MSLane*>::iterator i = myLanesToActivate.begin(); i != myLanesToActivate.end(); ++i) {
+        if (!myLanes[(*i)->getNumericalID()].haveNeighbors) {
+            myActiveLanesBuffer.push_back(*i);
+        }
+    }
+    myActiveLanes.swap(myActiveLanesBuffer);
+    myLanesToActivate.clear();
+}
+
+
 void
 MSEdgeControl::planMovements(SUMOTime t) {
-    for (std::list<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end();) {
+    std::vector<MSLane*>::iterator write = myActiveLanes.begin();
+    for (std::vector<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
         if ((*i)->getVehicleNumber() == 0) {
             myLanes[(*i)->getNumericalID()].amActive = false;
-            i = myActiveLanes.erase(i);
         } else {
+            if (MSGlobals::gNumSimThreads == 0) {
+                (*i)->planMovements(t);
+            }
+            *write++ = *i;
+        }
+    }
+    myActiveLanes.erase(write, myActiveLanes.end());
+    if (MSGlobals::gNumSimThreads == 0) {
+        return;
+    }
+    MSLink::setDeferApproaching(true);
+#ifdef HAVE_FOX
+    if (myThreadPool.size() > 0) {
+        // lanes sharing a random number generator go to the same thread (in list order)
+        for (std::vector<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
+            myThreadPool.add((*i)->getPlanMoveTask(t), (*i)->getRNGIndex() % myThreadPool.size());
+        }
+        myThreadPool.waitAll(false);
+    } else {
+#endif
+        for (std::vector<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
             (*i)->planMovements(t);
-            ++i;
         }
+#ifdef HAVE_FOX
     }
+#endif
+    MSLink::setDeferApproaching(false);
+    MSLink::applyDeferredApproaching();
 }
 
 
 void
 MSEdgeControl::executeMovements(SUMOTime t) {
     myWithVehicles2Integrate.clear();
-    for (std::list<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end();) {
+    std::vector<MSLane*>::iterator write = myActiveLanes.begin();
+    for (std::vector<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
         if ((*i)->getVehicleNumber() == 0 || (*i)->executeMovements(t, myWithVehicles2Integrate)) {
             myLanes[(*i)->getNumericalID()].amActive = false;
-            i = myActiveLanes.erase(i);
         } else {
-            ++i;
+            *write++ = *i;
         }
     }
+    myActiveLanes.erase(write, myActiveLanes.end());
     for (std::vector<MSLane*>::iterator i = myWithVehicles2Integrate.begin(); i != myWithVehicles2Integrate.end(); ++i) {
         if ((*i)->integrateNewVehicle(t)) {
             LaneUsage& lu = myLanes[(*i)->getNumericalID()];
             if (!lu.amActive) {
-                if (lu.haveNeighbors) {
-                    myActiveLanes.push_front(*i);
-                } else {
-                    myActiveLanes.push_back(*i);
-                }
+                myLanesToActivate.push_back(*i);
                 lu.amActive = true;
             }
         }
     }
+    addActiveLanes();
     if (MSGlobals::gLateralResolution > 0) {
         // multiple vehicle shadows may have entered an inactive lane and would
         // not be sorted otherwise
@@ -141,35 +201,23 @@ MSEdgeControl::executeMovements(SUMOTime t) {
 
 void
 MSEdgeControl::changeLanes(SUMOTime t) {
-    std::vector<MSLane*> toAdd;
-    for (std::list<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end();) {
-        LaneUsage& lu = myLanes[(*i)->getNumericalID()];
-        if (lu.haveNeighbors) {
-            MSEdge& edge = (*i)->getEdge();
-            if (myLastLaneChange[edge.getNumericalID()] != t) {
-                myLastLaneChange[edge.getNumericalID()] = t;
-                edge.changeLanes(t);
-                const std::vector<MSLane*>& lanes = edge.getLanes();
-                for (std::vector<MSLane*>::const_iterator i = lanes.begin(); i != lanes.end(); ++i) {
-                    LaneUsage& lu = myLanes[(*i)->getNumericalID()];
-                    //if ((*i)->getID() == "disabled") {
-                    //    std::cout << SIMTIME << " vehicles=" << toString((*i)->getVehiclesSecure()) << "\n";
-                    //    (*i)->releaseVehicles();
-                    //}
-                    if ((*i)->getVehicleNumber() > 0 && !lu.amActive) {
-                        toAdd.push_back(*i);
-                        lu.amActive = true;
-                    }
+    // lanes of multi-lane edges are at the front of the active lanes
+    for (std::vector<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end() && myLanes[(*i)->getNumericalID()].haveNeighbors; ++i) {
+        MSEdge& edge = (*i)->getEdge();
+        if (myLastLaneChange[edge.getNumericalID()] != t) {
+            myLastLaneChange[edge.getNumericalID()] = t;
+            edge.changeLanes(t);
+            const std::vector<MSLane*>& lanes = edge.getLanes();
+            for (std::vector<MSLane*>::const_iterator j = lanes.begin(); j != lanes.end(); ++j) {
+                LaneUsage& lu = myLanes[(*j)->getNumericalID()];
+                if ((*j)->getVehicleNumber() > 0 && !lu.amActive) {
+                    myLanesToActivate.push_back(*j);
+                    lu.amActive = true;
                 }
             }
-            ++i;
-        } else {
-            i = myActiveLanes.end();
         }
     }
-    for (std::vector<MSLane*>::iterator i = toAdd.begin(); i != toAdd.end(); ++i) {
-        myActiveLanes.push_front(*i);
-    }
+    addActiveLanes();
     if (MSGlobals::gLateralResolution > 0) {
         // sort maneuver reservations
         for (LaneUsageVector::iterator it = myLanes.begin(); it != myLanes.end(); ++it) {
@@ -182,7 +230,7 @@ MSEdgeControl::changeLanes(SUMOTime t) {
 void
 MSEdgeControl::detectCollisions(SUMOTime timestep, const std::string& stage) {
     // Detections is made by the edge's lanes, therefore hand over.
-    for (std::list<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
+    for (std::vector<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
         (*i)->detectCollisions(timestep, stage);
     }
 }
@@ -200,7 +248,7 @@ MSEdgeControl::getEdgeNames() const {
 
 void
 MSEdgeControl::gotActive(MSLane* l) {
-    myChangedStateLanes.insert(l);
+    myChangedStateLanes.push_back(l);
 }
 
 void
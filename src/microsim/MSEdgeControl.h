@@ -40,6 +40,9 @@
 #include <set>
 #include <utils/common/SUMOTime.h>
 #include <utils/common/Named.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXWorkerThread.h>
+#endif
 
 
 // ===========================================================================
@@ -102,6 +105,10 @@ public:
      * ApproachingVehicleInformation for all links
      *
      * This method goes through all active lanes calling their "planMovements" method.
+     * If a positive number of simulation threads is given, the registration of
+     *  approaching vehicles at the links is deferred until all lanes have planned
+     *  (in parallel if compiled with FOX) so the result does not depend on the
+     *  order of lanes or the number of threads.
      * @see MSLane::planMovements
      */
     void planMovements(SUMOTime t);
@@ -175,6 +182,14 @@ public:
     /// @brief apply additional restrictions
     void setAdditionalRestrictions();
 
+private:
+    /** @brief Adds the lanes collected in myLanesToActivate to the active lanes
+     *
+     * Lanes of multi-lane edges are put in front of the active lanes with the
+     *  last activated one first, the other lanes are appended in order of activation.
+     */
+    void addActiveLanes();
+
 
 public:
     /**
@@ -211,18 +226,35 @@ private:
     /// @brief Information about lanes' number of vehicles and neighbors
     LaneUsageVector myLanes;
 
-    /// @brief The list of active (not empty) lanes
-    std::list<MSLane*> myActiveLanes;
+    /** @brief The list of active (not empty) lanes
+     *
+     * Lanes of multi-lane edges come first, so lane changing only needs to
+     *  look at the front. Lanes are removed by compacting the vector while it
+     *  is traversed and added in bulk by addActiveLanes, both keeping the
+     *  relative order of the remaining lanes.
+     */
+    std::vector<MSLane*> myActiveLanes;
+
+    /// @brief Lanes which got active and still need to be added to myActiveLanes (in order of activation)
+    std::vector<MSLane*> myLanesToActivate;
+
+    /// @brief Buffer for rebuilding myActiveLanes, kept to avoid reallocations
+    std::vector<MSLane*> myActiveLanesBuffer;
 
     /// @brief A storage for lanes which shall be integrated because vehicles have moved onto them
     std::vector<MSLane*> myWithVehicles2Integrate;
 
-    /// @brief Lanes which changed the state without informing the control
-    std::set<MSLane*, ComparatorIdLess> myChangedStateLanes;
+    /// @brief Lanes which changed the state without informing the control (may contain duplicates until patchActiveLanes)
+    std::vector<MSLane*> myChangedStateLanes;
 
     /// @brief The list of active (not empty) lanes
     std::vector<SUMOTime> myLastLaneChange;
 
+#ifdef HAVE_FOX
+    /// @brief the thread pool for the parallel computation of planMovements
+    FXWorkerThread::Pool myThreadPool;
+#endif
+
 private:
     /// @brief Copy constructor.
     MSEdgeControl(const MSEdgeControl&);
@@ -52,6 +52,7 @@
 #include <microsim/devices/MSDevice.h>
 #include <microsim/devices/MSDevice_Vehroutes.h>
 #include <microsim/output/MSStopOut.h>
+#include <microsim/output/MSFCDColumnarExport.h>
 #include <utils/common/RandHelper.h>
 #include "MSFrame.h"
 #include <utils/common/SystemFrame.h>
@@ -143,6 +144,8 @@ MSFrame::fillOptions() {
     oc.addDescription("fcd-output.geo", "Output", "Save the Floating Car Data using geo-coordinates (lon/lat)");
     oc.doRegister("fcd-output.signals", new Option_Bool(false));
     oc.addDescription("fcd-output.signals", "Output", "Add the vehicle signal state to the FCD output (brake lights etc.)");
+    oc.doRegister("fcd-output.columnar", new Option_FileName());
+    oc.addDescription("fcd-output.columnar", "Output", "Save the Floating Car Data in a compact columnar binary format");
     oc.doRegister("full-output", new Option_FileName());
     oc.addDescription("full-output", "Output", "Save a lot of information for each timestep (very redundant)");
     oc.doRegister("queue-output", new Option_FileName());
@@ -254,6 +257,12 @@ MSFrame::fillOptions() {
     oc.addDescription("carfollow.model", "Processing", "Select default car following model (Krauss, IDM, ...)");
     oc.addSynonyme("carfollow.model", "carfollowing.model", false);
 
+    oc.doRegister("threads", new Option_Integer(0));
+    oc.addDescription("threads", "Processing", "Defines the number of threads for parallel simulation, any positive value gives results independent of the number of threads (0 runs the classic sequential step)");
+
+    oc.doRegister("thread-rngs", new Option_Integer(64));
+    oc.addDescription("thread-rngs", "Processing", "Number of pseudo random number generators used for parallel simulation");
+
     // register the processing options
     oc.doRegister("route-steps", 's', new Option_String("200", "TIME"));
     oc.addDescription("route-steps", "Processing", "Load routes for the next number of seconds ahead");
@@ -503,6 +512,7 @@ MSFrame::buildStreams() {
 
     MSDevice_Vehroutes::init();
     MSStopOut::init();
+    MSFCDColumnarExport::init();
 }
 
 
@@ -596,6 +606,19 @@ MSFrame::checkOptions() {
             oc.set("battery-output.precision", toString(oc.getInt("precision")));
         }
     }
+    if (oc.getInt("threads") < 0) {
+        WRITE_ERROR("The number of threads must not be negative.");
+        ok = false;
+    }
+    if (oc.getInt("thread-rngs") < 1) {
+        WRITE_ERROR("At least one random number generator is needed for option 'thread-rngs'.");
+        ok = false;
+    }
+#ifndef HAVE_FOX
+    if (oc.getInt("threads") > 1) {
+        WRITE_WARNING("Parallel simulation is only possible when compiled with Fox, running sequentially.");
+    }
+#endif
     if (!SUMOXMLDefinitions::CarFollowModels.hasString(oc.getString("carfollow.model"))) {
         WRITE_ERROR("Unknown model '" + oc.getString("carfollow.model")  + "' for option 'carfollow.model'.");
         ok = false;
@@ -634,8 +657,10 @@ MSFrame::setMSGlobals(OptionsCont& oc) {
         MSGlobals::gUsingInternalLanes = false;
     }
     MSGlobals::gWaitingTimeMemory = string2time(oc.getString("waiting-time-memory"));
+    MSGlobals::gNumSimThreads = oc.getInt("threads");
     MSAbstractLaneChangeModel::initGlobalOptions(oc);
     MSLane::initCollisionOptions(oc);
+    MSLane::initRNGs(oc);
 
     DELTA_T = string2time(oc.getString("step-length"));
 
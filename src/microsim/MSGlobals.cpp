@@ -63,5 +63,7 @@ bool MSGlobals::gSemiImplicitEulerUpdate;
 SUMOTime MSGlobals::gWaitingTimeMemory;
 
 SUMOTime MSGlobals::gActionStepLength;
+
+int MSGlobals::gNumSimThreads;
 /****************************************************************************/
 
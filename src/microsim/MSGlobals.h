@@ -115,6 +115,12 @@ public:
     /// default value for the interval between two action points for MSVehicle (defaults to DELTA_T)
     static SUMOTime gActionStepLength;
 
+    /** @brief how many threads to use for simulation
+     *
+     * 0 means the classic sequential step, any positive value enables the
+     *  thread count independent (but still deterministic) parallel step */
+    static int gNumSimThreads;
+
 };
 
 
@@ -42,12 +42,17 @@
 #include <iterator>
 #include <exception>
 #include <climits>
+#include <ctime>
 #include <set>
 #include <utils/common/UtilExceptions.h>
 #include <utils/common/StdDefs.h>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/ToString.h>
+#include <utils/common/RandHelper.h>
 #include <utils/options/OptionsCont.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXConditionalLock.h>
+#endif
 #include <utils/emissions/HelpersHarmonoise.h>
 #include <utils/geom/GeomHelper.h>
 #include <microsim/pedestrians/MSPModel.h>
@@ -92,6 +97,7 @@ MSLane::CollisionAction MSLane::myCollisionAction(MSLane::COLLISION_ACTION_TELEP
 bool MSLane::myCheckJunctionCollisions(false);
 SUMOTime MSLane::myCollisionStopTime(0);
 double  MSLane::myCollisionMinGapFactor(1.0);
+std::vector<std::mt19937> MSLane::myRNGs;
 
 // ===========================================================================
 // internal class method definitions
@@ -180,6 +186,9 @@ MSLane::MSLane(const std::string& id, double maxSpeed, double length, MSEdge* co
     myLeaderInfoTmp(this, 0, 0),
     myLeaderInfoTime(SUMOTime_MIN),
     myFollowerInfoTime(SUMOTime_MIN),
+#ifdef HAVE_FOX
+    myPlanMoveTask(*this),
+#endif
     myLengthGeometryFactor(MAX2(POSITION_EPS, myShape.length()) / myLength), // factor should not be 0
     myIsRampAccel(isRampAccel),
     myRightSideOnEdge(0), // initialized in MSEdge::initialize
@@ -964,8 +973,11 @@ MSLane::safeInsertionSpeed(const MSVehicle* veh, double seen, const MSLeaderInfo
 
 
 // ------ Handling vehicles lapping into lanes ------
-const MSLeaderInfo&
+const MSLeaderInfo
 MSLane::getLastVehicleInformation(const MSVehicle* ego, double latOffset, double minPos, bool allowCached) const {
+#ifdef HAVE_FOX
+    FXConditionalLock lock(myLeaderInfoMutex, MSGlobals::gNumSimThreads > 1);
+#endif
     if (myLeaderInfoTime < MSNet::getInstance()->getCurrentTimeStep() || ego != 0 || minPos > 0 || !allowCached) {
         myLeaderInfoTmp = MSLeaderInfo(this, ego, latOffset);
         AnyVehicleIterator last = anyVehiclesBegin();
@@ -1017,8 +1029,11 @@ MSLane::getLastVehicleInformation(const MSVehicle* ego, double latOffset, double
 }
 
 
-const MSLeaderInfo&
+const MSLeaderInfo
 MSLane::getFirstVehicleInformation(const MSVehicle* ego, double latOffset, bool onlyFrontOnLane, double maxPos, bool allowCached) const {
+#ifdef HAVE_FOX
+    FXConditionalLock lock(myLeaderInfoMutex, MSGlobals::gNumSimThreads > 1);
+#endif
     if (myFollowerInfoTime < MSNet::getInstance()->getCurrentTimeStep() || ego != 0 || maxPos < myLength || !allowCached || onlyFrontOnLane) {
         // XXX separate cache for onlyFrontOnLane = true
         myLeaderInfoTmp = MSLeaderInfo(this, ego, latOffset);
@@ -3171,6 +3186,21 @@ MSLane::initCollisionOptions(const OptionsCont& oc) {
 }
 
 
+void
+MSLane::initRNGs(const OptionsCont& oc) {
+    myRNGs.clear();
+    if (oc.getInt("threads") > 0) {
+        // the number of generators is independent of the number of threads to keep results reproducible
+        const int numRNGs = oc.getInt("thread-rngs");
+        const int seed = oc.getBool("random") ? (int)time(0) : oc.getInt("seed");
+        myRNGs.resize(numRNGs);
+        for (int i = 0; i < numRNGs; i++) {
+            RandHelper::initRand(&myRNGs[i], false, seed + i);
+        }
+    }
+}
+
+
 void
 MSLane::setPermissions(SVCPermissions permissions, long transientID) {
     if (transientID == CHANGE_PERMISSIONS_PERMANENT) {
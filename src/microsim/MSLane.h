@@ -37,6 +37,7 @@
 #include <vector>
 #include <deque>
 #include <cassert>
+#include <random>
 #include <utils/common/Named.h>
 #include <utils/common/Parameterised.h>
 #include <utils/common/SUMOVehicleClass.h>
@@ -47,6 +48,9 @@
 #include "MSLeaderInfo.h"
 #include "MSMoveReminder.h"
 #include <libsumo/Helper.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXWorkerThread.h>
+#endif
 
 
 // ===========================================================================
@@ -346,10 +350,10 @@ public:
      * @param[in] allowCached Whether the cached value may be used
      * @return Information about the last vehicles
      */
-    const MSLeaderInfo& getLastVehicleInformation(const MSVehicle* ego, double latOffset, double minPos = 0, bool allowCached = true) const;
+    const MSLeaderInfo getLastVehicleInformation(const MSVehicle* ego, double latOffset, double minPos = 0, bool allowCached = true) const;
 
     /// @brief analogue to getLastVehicleInformation but in the upstream direction
-    const MSLeaderInfo& getFirstVehicleInformation(const MSVehicle* ego, double latOffset, bool onlyFrontOnLane, double maxPos = std::numeric_limits<double>::max(), bool allowCached = true) const;
+    const MSLeaderInfo getFirstVehicleInformation(const MSVehicle* ego, double latOffset, bool onlyFrontOnLane, double maxPos = std::numeric_limits<double>::max(), bool allowCached = true) const;
 
     /// @}
 
@@ -1071,6 +1075,50 @@ public:
 
     static void initCollisionOptions(const OptionsCont& oc);
 
+    /// @brief initializes the random number generators used by the parallel simulation step
+    static void initRNGs(const OptionsCont& oc);
+
+    /** @brief return the random number generator to use for vehicles on this lane
+     * @return the lane specific generator or 0 (meaning the global one) in the classic sequential step
+     */
+    std::mt19937* getRNG() const {
+        return myRNGs.empty() ? 0 : &myRNGs[getRNGIndex()];
+    }
+
+    /// @brief returns the index of the random number generator used by this lane
+    int getRNGIndex() const {
+        return myRNGs.empty() ? 0 : myNumericalID % (int)myRNGs.size();
+    }
+
+#ifdef HAVE_FOX
+    /**
+     * @class PlanMoveTask
+     * @brief The task for computing planMovements of a single lane in a worker thread
+     */
+    class PlanMoveTask : public FXWorkerThread::Task {
+    public:
+        PlanMoveTask(MSLane& lane) : myLane(lane), myTime(0) {}
+        void init(const SUMOTime time) {
+            myTime = time;
+        }
+        void run(FXWorkerThread* /*context*/) {
+            myLane.planMovements(myTime);
+        }
+    private:
+        MSLane& myLane;
+        SUMOTime myTime;
+    private:
+        /// @brief Invalidated assignment operator.
+        PlanMoveTask& operator=(const PlanMoveTask&) = delete;
+    };
+
+    /// @brief returns the (reused) task for computing planMovements of this lane at the given time
+    PlanMoveTask* getPlanMoveTask(const SUMOTime time) {
+        myPlanMoveTask.init(time);
+        return &myPlanMoveTask;
+    }
+#endif
+
     static bool teleportOnCollision() {
         return myCollisionAction == COLLISION_ACTION_TELEPORT;
     }
@@ -1260,6 +1308,14 @@ protected:
     /// @brief time step for which myFollowerInfo was last updated
     mutable SUMOTime myFollowerInfoTime;
 
+#ifdef HAVE_FOX
+    /// @brief guards the leader / follower caches when planning movements in parallel
+    mutable FXMutex myLeaderInfoMutex;
+
+    /// @brief the task for the parallel computation of planMovements
+    PlanMoveTask myPlanMoveTask;
+#endif
+
     /// @brief precomputed myShape.length / myLength
     const double myLengthGeometryFactor;
 
@@ -1293,6 +1349,9 @@ private:
     static SUMOTime myCollisionStopTime;
     static double myCollisionMinGapFactor;
 
+    /// @brief the random number generators used by the parallel simulation step (empty in the sequential step)
+    static std::vector<std::mt19937> myRNGs;
+
     /**
      * @class vehicle_position_sorter
      * @brief Sorts vehicles by their position (descending)
@@ -58,6 +58,12 @@ const SUMOTime MSLink::myLookaheadTimeZipper = TIME2STEPS(4);
 
 const double MSLink::ZIPPER_ADAPT_DIST(100);
 
+bool MSLink::myDeferApproaching(false);
+std::vector<MSLink*> MSLink::myLinksWithDeferred;
+#ifdef HAVE_FOX
+FXMutex MSLink::myLinksWithDeferredMutex;
+#endif
+
 // time to link in seconds below which adaptation should take place
 #define ZIPPER_ADAPT_TIME 10
 // the default safety gap when passing before oncoming pedestrians
@@ -316,9 +322,13 @@ MSLink::setApproaching(const SUMOVehicle* approaching, const SUMOTime arrivalTim
         }
     }
 #endif
-    myApproachingVehicles.insert(std::make_pair(approaching,
-                                 ApproachingVehicleInformation(arrivalTime, leaveTime, arrivalSpeed, leaveSpeed, setRequest,
-                                         arrivalTimeBraking, arrivalSpeedBraking, waitingTime, dist)));
+    const ApproachingVehicleInformation ai(arrivalTime, leaveTime, arrivalSpeed, leaveSpeed, setRequest,
+                                           arrivalTimeBraking, arrivalSpeedBraking, waitingTime, dist);
+    if (myDeferApproaching) {
+        deferApproaching(approaching, false, ai);
+        return;
+    }
+    insertApproaching(approaching, ai);
 }
 
 
@@ -333,7 +343,11 @@ MSLink::setApproaching(const SUMOVehicle* approaching, ApproachingVehicleInforma
         }
     }
 #endif
-    myApproachingVehicles.insert(std::make_pair(approaching, ai));
+    if (myDeferApproaching) {
+        deferApproaching(approaching, false, ai);
+        return;
+    }
+    insertApproaching(approaching, ai);
 }
 
 
@@ -367,13 +381,81 @@ MSLink::removeApproaching(const SUMOVehicle* veh) {
         }
     }
 #endif
-    myApproachingVehicles.erase(veh);
+    if (myDeferApproaching) {
+        deferApproaching(veh, true, ApproachingVehicleInformation(-1000, -1000, 0, 0, false, -1000, 0, 0, 0));
+        return;
+    }
+    eraseApproaching(veh);
+}
+
+
+void
+MSLink::insertApproaching(const SUMOVehicle* veh, const ApproachingVehicleInformation& ai) {
+    if (findApproaching(veh) != myApproachingVehicles.end()) {
+        // keep the first registration
+        return;
+    }
+    ApproachInfos::iterator i = myApproachingVehicles.begin();
+    while (i != myApproachingVehicles.end() && i->first->getID() < veh->getID()) {
+        ++i;
+    }
+    myApproachingVehicles.insert(i, std::make_pair(veh, ai));
+}
+
+
+void
+MSLink::eraseApproaching(const SUMOVehicle* veh) {
+    for (ApproachInfos::iterator i = myApproachingVehicles.begin(); i != myApproachingVehicles.end(); ++i) {
+        if (i->first == veh) {
+            myApproachingVehicles.erase(i);
+            return;
+        }
+    }
+}
+
+
+void
+MSLink::deferApproaching(const SUMOVehicle* veh, const bool remove, const ApproachingVehicleInformation& ai) {
+#ifdef HAVE_FOX
+    myDeferredMutex.lock();
+#endif
+    if (myDeferredApproaching.empty()) {
+#ifdef HAVE_FOX
+        myLinksWithDeferredMutex.lock();
+#endif
+        myLinksWithDeferred.push_back(this);
+#ifdef HAVE_FOX
+        myLinksWithDeferredMutex.unlock();
+#endif
+    }
+    myDeferredApproaching.push_back(DeferredApproach(veh, remove, ai));
+#ifdef HAVE_FOX
+    myDeferredMutex.unlock();
+#endif
+}
+
+
+void
+MSLink::applyDeferredApproaching() {
+    // each vehicle is planned by a single thread so its changes are recorded in order,
+    // the result does not depend on the order of links or vehicles since the container is sorted by id
+    for (MSLink* const link : myLinksWithDeferred) {
+        for (const DeferredApproach& da : link->myDeferredApproaching) {
+            if (da.remove) {
+                link->eraseApproaching(da.veh);
+            } else {
+                link->insertApproaching(da.veh, da.ai);
+            }
+        }
+        link->myDeferredApproaching.clear();
+    }
+    myLinksWithDeferred.clear();
 }
 
 
 MSLink::ApproachingVehicleInformation
 MSLink::getApproaching(const SUMOVehicle* veh) const {
-    std::map<const SUMOVehicle*, ApproachingVehicleInformation>::const_iterator i = myApproachingVehicles.find(veh);
+    ApproachInfos::const_iterator i = findApproaching(veh);
     if (i != myApproachingVehicles.end()) {
         return i->second;
     } else {
@@ -405,7 +487,7 @@ MSLink::opened(SUMOTime arrivalTime, double arrivalSpeed, double leaveSpeed, dou
         for (std::vector<MSLink*>::const_iterator it = mySublaneFoeLinks.begin(); it != mySublaneFoeLinks.end(); ++it) {
             const MSLink* foeLink = *it;
             assert(myLane != foeLink->getLane());
-            for (std::map<const SUMOVehicle*, ApproachingVehicleInformation>::const_iterator i = foeLink->myApproachingVehicles.begin(); i != foeLink->myApproachingVehicles.end(); ++i) {
+            for (ApproachInfos::const_iterator i = foeLink->myApproachingVehicles.begin(); i != foeLink->myApproachingVehicles.end(); ++i) {
                 const SUMOVehicle* foe = i->first;
                 if (
                     // there only is a conflict if the paths cross
@@ -476,7 +558,7 @@ bool
 MSLink::blockedAtTime(SUMOTime arrivalTime, SUMOTime leaveTime, double arrivalSpeed, double leaveSpeed,
                       bool sameTargetLane, double impatience, double decel, SUMOTime waitingTime,
                       std::vector<const SUMOVehicle*>* collectFoes, const SUMOVehicle* ego) const {
-    for (std::map<const SUMOVehicle*, ApproachingVehicleInformation>::const_iterator i = myApproachingVehicles.begin(); i != myApproachingVehicles.end(); ++i) {
+    for (ApproachInfos::const_iterator i = myApproachingVehicles.begin(); i != myApproachingVehicles.end(); ++i) {
 #ifdef MSLink_DEBUG_OPENED
         if (gDebugFlag1) {
             if (ego != 0
@@ -493,7 +575,7 @@ MSLink::blockedAtTime(SUMOTime arrivalTime, SUMOTime leaveTime, double arrivalSp
                 && (ego == 0
                     || ego->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_IGNORE_FOE_PROB, 0) == 0
                     || ego->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_IGNORE_FOE_SPEED, 0) < i->first->getSpeed()
-                    || ego->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_IGNORE_FOE_PROB, 0) < RandHelper::rand())
+                    || ego->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_IGNORE_FOE_PROB, 0) < RandHelper::rand(getRNG(ego)))
                 && blockedByFoe(i->first, i->second, arrivalTime, leaveTime, arrivalSpeed, leaveSpeed, sameTargetLane,
                                 impatience, decel, waitingTime, ego)) {
             if (collectFoes == 0) {
@@ -582,6 +664,13 @@ MSLink::blockedByFoe(const SUMOVehicle* veh, const ApproachingVehicleInformation
 }
 
 
+std::mt19937*
+MSLink::getRNG(const SUMOVehicle* ego) {
+    // micro vehicles may ask during a parallel planMove and must use the generator of their lane
+    return MSGlobals::gUseMesoSim ? 0 : static_cast<const MSVehicle*>(ego)->getRNG();
+}
+
+
 bool
 MSLink::maybeOccupied(MSLane* lane) {
     MSVehicle* veh = lane->getLastAnyVehicle();
@@ -670,13 +759,13 @@ MSLink::writeApproaching(OutputDevice& od, const std::string fromLaneID) const {
         od.writeAttr(SUMO_ATTR_VIA, via);
         od.writeAttr(SUMO_ATTR_TO, getLane() == 0 ? "" : getLane()->getID());
         std::vector<std::pair<SUMOTime, const SUMOVehicle*> > toSort; // stabilize output
-        for (std::map<const SUMOVehicle*, ApproachingVehicleInformation>::const_iterator it = myApproachingVehicles.begin(); it != myApproachingVehicles.end(); ++it) {
+        for (ApproachInfos::const_iterator it = myApproachingVehicles.begin(); it != myApproachingVehicles.end(); ++it) {
             toSort.push_back(std::make_pair(it->second.arrivalTime, it->first));
         }
         std::sort(toSort.begin(), toSort.end());
         for (std::vector<std::pair<SUMOTime, const SUMOVehicle*> >::const_iterator it = toSort.begin(); it != toSort.end(); ++it) {
             od.openTag("approaching");
-            const ApproachingVehicleInformation& avi = myApproachingVehicles.find(it->second)->second;
+            const ApproachingVehicleInformation& avi = findApproaching(it->second)->second;
             od.writeAttr(SUMO_ATTR_ID, it->second->getID());
             od.writeAttr(SUMO_ATTR_IMPATIENCE, it->second->getImpatience());
             od.writeAttr("arrivalTime", time2string(avi.arrivalTime));
@@ -31,10 +31,14 @@
 
 #include <vector>
 #include <set>
+#include <random>
 #include <utils/common/SUMOTime.h>
 #include <utils/common/SUMOVehicleClass.h>
 #include <utils/vehicle/SUMOVehicle.h>
 #include <utils/xml/SUMOXMLDefinitions.h>
+#ifdef HAVE_FOX
+#include <fx.h>
+#endif
 
 
 // ===========================================================================
@@ -118,30 +122,29 @@ public:
         }
 
         /// @brief The time the vehicle's front arrives at the link
-        const SUMOTime arrivalTime;
+        SUMOTime arrivalTime;
         /// @brief The estimated time at which the vehicle leaves the link
-        const SUMOTime leavingTime;
+        SUMOTime leavingTime;
         /// @brief The estimated speed with which the vehicle arrives at the link (for headway computation)
-        const double arrivalSpeed;
+        double arrivalSpeed;
         /// @brief The estimated speed with which the vehicle leaves the link (for headway computation)
-        const double leaveSpeed;
+        double leaveSpeed;
         /// @brief Whether the vehicle wants to pass the link (@todo: check semantics)
-        const bool willPass;
+        bool willPass;
         /// @brief The time the vehicle's front arrives at the link if it starts braking
-        const SUMOTime arrivalTimeBraking;
+        SUMOTime arrivalTimeBraking;
         /// @brief The estimated speed with which the vehicle arrives at the link if it starts braking(for headway computation)
-        const double arrivalSpeedBraking;
+        double arrivalSpeedBraking;
         /// @brief The waiting duration at the current link
-        const SUMOTime waitingTime;
+        SUMOTime waitingTime;
         /// @brief The distance up to the current link
-        const double dist;
-
-    private:
-        /// invalidated assignment operator
-        ApproachingVehicleInformation& operator=(const ApproachingVehicleInformation& s);
+        double dist;
 
     };
 
+    /// @brief The approaching vehicles of a link with their information (sorted by vehicle id)
+    typedef std::vector<std::pair<const SUMOVehicle*, ApproachingVehicleInformation> > ApproachInfos;
+
 
     /** @brief Constructor for simulation which uses internal lanes
      *
@@ -194,6 +197,19 @@ public:
     /// @brief removes the vehicle from myApproachingVehicles
     void removeApproaching(const SUMOVehicle* veh);
 
+    /** @brief switches between immediate and deferred registration of approaching vehicles
+     *
+     * While deferring, setApproaching and removeApproaching only record the change
+     *  and applyDeferredApproaching needs to be called afterwards. This keeps the
+     *  information read by opened() stable while lanes plan their movements in parallel.
+     */
+    static void setDeferApproaching(const bool defer) {
+        myDeferApproaching = defer;
+    }
+
+    /// @brief applies all changes recorded while deferring and clears them
+    static void applyDeferredApproaching();
+
     void addBlockedLink(MSLink* link);
 
     /* @brief return information about this vehicle if it is registered as
@@ -201,8 +217,8 @@ public:
      * @note used for visualisation of link items */
     ApproachingVehicleInformation getApproaching(const SUMOVehicle* veh) const;
 
-    /// @brief return all approaching vehicles
-    const std::map<const SUMOVehicle*, ApproachingVehicleInformation, ComparatorIdLess>& getApproaching() const {
+    /// @brief return all approaching vehicles (sorted by id)
+    const ApproachInfos& getApproaching() const {
         return myApproachingVehicles;
     }
 
@@ -522,6 +538,9 @@ private:
     /// @brief returns whether the given lane may still be occupied by a vehicle currently on it
     static bool maybeOccupied(MSLane* lane);
 
+    /// @brief returns the random number generator for decisions of the given vehicle (0 for the global one)
+    static std::mt19937* getRNG(const SUMOVehicle* ego);
+
     /// @brief whether fllower could stay behind leader (possibly by braking)
     static bool couldBrakeForLeader(double followDist, double leaderDist, const MSVehicle* follow, const MSVehicle* leader);
 
@@ -535,6 +554,34 @@ private:
     /// @brief figure out whether the cont status remains in effect when switching off the tls
     bool checkContOff() const;
 
+    /// @brief returns the entry of the given vehicle in myApproachingVehicles (or its end)
+    ApproachInfos::const_iterator findApproaching(const SUMOVehicle* veh) const {
+        for (ApproachInfos::const_iterator i = myApproachingVehicles.begin(); i != myApproachingVehicles.end(); ++i) {
+            if (i->first == veh) {
+                return i;
+            }
+        }
+        return myApproachingVehicles.end();
+    }
+
+    /// @brief adds the vehicle to myApproachingVehicles at the position given by its id unless it is already registered
+    void insertApproaching(const SUMOVehicle* veh, const ApproachingVehicleInformation& ai);
+
+    /// @brief removes the vehicle from myApproachingVehicles (if registered)
+    void eraseApproaching(const SUMOVehicle* veh);
+
+    /// @brief records a change of myApproachingVehicles to be applied by applyDeferredApproaching
+    void deferApproaching(const SUMOVehicle* veh, const bool remove, const ApproachingVehicleInformation& ai);
+
+    /// @brief a change of myApproachingVehicles recorded while deferring
+    struct DeferredApproach {
+        DeferredApproach(const SUMOVehicle* _veh, const bool _remove, const ApproachingVehicleInformation& _ai) :
+            veh(_veh), remove(_remove), ai(_ai) {}
+        const SUMOVehicle* veh;
+        bool remove;
+        ApproachingVehicleInformation ai;
+    };
+
 private:
     /// @brief The lane behind the junction approached by this link
     MSLane* myLane;
@@ -542,9 +589,17 @@ private:
     /// @brief The lane approaching this link
     MSLane* myLaneBefore;
 
-    std::map<const SUMOVehicle*, ApproachingVehicleInformation, ComparatorIdLess> myApproachingVehicles;
+    /// @brief the approaching vehicles, a vector since there are only few per link (keeps its capacity over the steps)
+    ApproachInfos myApproachingVehicles;
     std::set<MSLink*> myBlockedFoeLinks;
 
+    /// @brief the changes of myApproachingVehicles recorded while deferring (in the order of recording per vehicle)
+    std::vector<DeferredApproach> myDeferredApproaching;
+#ifdef HAVE_FOX
+    /// @brief guards myDeferredApproaching
+    FXMutex myDeferredMutex;
+#endif
+
     /// @brief The position within this respond
     int myIndex;
 
@@ -625,6 +680,16 @@ private:
     static const SUMOTime myLookaheadTime;
     static const SUMOTime myLookaheadTimeZipper;
 
+    /// @brief whether approach registrations are currently deferred
+    static bool myDeferApproaching;
+
+    /// @brief the links which recorded changes while deferring
+    static std::vector<MSLink*> myLinksWithDeferred;
+#ifdef HAVE_FOX
+    /// @brief guards myLinksWithDeferred
+    static FXMutex myLinksWithDeferredMutex;
+#endif
+
     MSLink* myParallelRight;
     MSLink* myParallelLeft;
 
@@ -77,6 +77,7 @@
 #include <microsim/devices/MSDevice_SSM.h>
 #include <microsim/output/MSBatteryExport.h>
 #include <microsim/output/MSEmissionExport.h>
+#include <microsim/output/MSFCDColumnarExport.h>
 #include <microsim/output/MSFCDExport.h>
 #include <microsim/output/MSFullExport.h>
 #include <microsim/output/MSQueueExport.h>
@@ -617,6 +618,7 @@ MSNet::clearAll() {
     MSDevice_BTsender::cleanup();
     MSDevice_SSM::cleanup();
     MSStopOut::cleanup();
+    MSFCDColumnarExport::cleanup();
     TraCIServer* t = TraCIServer::getInstance();
     if (t != 0) {
         t->cleanup();
@@ -641,6 +643,9 @@ MSNet::writeOutput() {
     if (OptionsCont::getOptions().isSet("fcd-output")) {
         MSFCDExport::write(OutputDevice::getDeviceByOption("fcd-output"), myStep, myHasElevation);
     }
+    if (MSFCDColumnarExport::getInstance() != 0) {
+        MSFCDColumnarExport::getInstance()->write(myStep, myHasElevation);
+    }
 
     // check emission dumps
     if (OptionsCont::getOptions().isSet("emission-output")) {
@@ -735,10 +740,7 @@ MSNet::writeOutput() {
     }
 
     // write SSM output
-    for (std::set<MSDevice*>::iterator di = MSDevice_SSM::getInstances().begin(); di != MSDevice_SSM::getInstances().end(); ++di) {
-        MSDevice_SSM* dev = static_cast<MSDevice_SSM*>(*di);
-        dev->updateAndWriteOutput();
-    }
+    MSDevice_SSM::updateAll();
 }
 
 
@@ -714,6 +714,7 @@ MSVehicle::~MSVehicle() {
     // still needed when calling resetPartialOccupation (getShadowLane) and when removing
     // approach information from parallel links
     delete myLaneChangeModel;
+    delete myCFVariables;
     myFurtherLanes.clear();
     myFurtherLanesPosLat.clear();
     //
@@ -3530,7 +3531,7 @@ MSVehicle::checkRewindLinkLanes(const double lengthsInFront, DriveItemVector& lf
     for (DriveItemVector::iterator i = lfLinks.begin(); i != lfLinks.end(); ++i) {
         if ((*i).myLink != 0) {
             if ((*i).myLink->getState() == LINKSTATE_ALLWAY_STOP) {
-                (*i).myArrivalTime += (SUMOTime)RandHelper::rand((int)2); // tie braker
+                (*i).myArrivalTime += (SUMOTime)RandHelper::rand((int)2, getRNG()); // tie braker
             }
             (*i).myLink->setApproaching(this, (*i).myArrivalTime, (*i).myArrivalSpeed, (*i).getLeaveSpeed(),
                                         (*i).mySetRequest, (*i).myArrivalTimeBraking, (*i).myArrivalSpeedBraking, getWaitingTime(), (*i).myDistance);
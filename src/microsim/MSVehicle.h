@@ -565,6 +565,13 @@ public:
         return myLane;
     }
 
+    /** @brief Returns the random number generator to use for decisions during planMove
+     * @return The generator of the current lane or 0 (the global one) in the classic sequential step
+     */
+    std::mt19937* getRNG() const {
+        return myLane == 0 ? 0 : myLane->getRNG();
+    }
+
 
     /** @brief Returns the maximal speed for the vehicle on its current lane (including speed factor and deviation,
      *         i.e., not necessarily the allowed speed limit)
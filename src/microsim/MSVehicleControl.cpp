@@ -85,6 +85,10 @@ MSVehicleControl::~MSVehicleControl() {
         delete(*i).second;
     }
     myVehicleDict.clear();
+    myHandles.clear();
+    myVehicleSlots.clear();
+    mySlotGenerations.clear();
+    myFreeHandles.clear();
     // delete vehicle type distributions
     for (VTypeDistDictType::iterator i = myVTypeDistDict.begin(); i != myVTypeDistDict.end(); ++i) {
         delete(*i).second;
@@ -175,10 +179,22 @@ MSVehicleControl::saveState(OutputDevice& out) {
 
 bool
 MSVehicleControl::addVehicle(const std::string& id, SUMOVehicle* v) {
-    VehicleDictType::iterator it = myVehicleDict.find(id);
-    if (it == myVehicleDict.end()) {
+    if (myHandles.find(id) == myHandles.end()) {
         // id not in myVehicleDict.
         myVehicleDict[id] = v;
+        int slot = (int)myVehicleSlots.size();
+        if (myFreeHandles.empty()) {
+            if (slot > HANDLE_SLOT_MASK) {
+                throw ProcessError("Too many vehicles (" + toString(slot) + ") exist at the same time.");
+            }
+            myVehicleSlots.push_back(v);
+            mySlotGenerations.push_back(0);
+        } else {
+            slot = myFreeHandles.back();
+            myFreeHandles.pop_back();
+            myVehicleSlots[slot] = v;
+        }
+        myHandles[id] = slot | (mySlotGenerations[slot] << HANDLE_GENERATION_SHIFT);
         const SUMOVehicleParameter& pars = v->getParameter();
         if (pars.departProcedure == DEPART_TRIGGERED || pars.departProcedure == DEPART_CONTAINER_TRIGGERED) {
             const MSEdge* const firstEdge = v->getRoute().getEdges()[0];
@@ -200,10 +216,34 @@ MSVehicleControl::addVehicle(const std::string& id, SUMOVehicle* v) {
 
 SUMOVehicle*
 MSVehicleControl::getVehicle(const std::string& id) const {
-    VehicleDictType::const_iterator it = myVehicleDict.find(id);
-    if (it == myVehicleDict.end()) {
+    std::unordered_map<std::string, int>::const_iterator it = myHandles.find(id);
+    if (it == myHandles.end()) {
+        return 0;
+    }
+    return myVehicleSlots[it->second & HANDLE_SLOT_MASK];
+}
+
+
+SUMOVehicle*
+MSVehicleControl::getVehicleByHandle(const int handle) const {
+    if (handle < 0) {
         return 0;
     }
+    const int slot = handle & HANDLE_SLOT_MASK;
+    if (slot >= (int)myVehicleSlots.size() || mySlotGenerations[slot] != (handle >> HANDLE_GENERATION_SHIFT)) {
+        // unknown or stale handle (the slot was reused by a later vehicle)
+        return 0;
+    }
+    return myVehicleSlots[slot];
+}
+
+
+int
+MSVehicleControl::getHandle(const std::string& id) const {
+    std::unordered_map<std::string, int>::const_iterator it = myHandles.find(id);
+    if (it == myHandles.end()) {
+        return -1;
+    }
     return it->second;
 }
 
@@ -216,6 +256,15 @@ MSVehicleControl::deleteVehicle(SUMOVehicle* veh, bool discard) {
     }
     if (veh != 0) {
         myVehicleDict.erase(veh->getID());
+        std::unordered_map<std::string, int>::iterator it = myHandles.find(veh->getID());
+        if (it != myHandles.end()) {
+            const int slot = it->second & HANDLE_SLOT_MASK;
+            myVehicleSlots[slot] = 0;
+            // invalidate the handles given out for this slot (wrapping around in the available bits)
+            mySlotGenerations[slot] = (mySlotGenerations[slot] + 1) & HANDLE_GENERATION_MASK;
+            myFreeHandles.push_back(slot);
+            myHandles.erase(it);
+        }
     }
     delete veh;
 }
@@ -33,6 +33,8 @@
 #include <string>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <vector>
 #include <utils/distribution/RandomDistributor.h>
 #include <utils/common/SUMOTime.h>
 #include <utils/common/SUMOVehicleClass.h>
@@ -135,6 +137,27 @@ public:
     SUMOVehicle* getVehicle(const std::string& id) const;
 
 
+    /** @brief Returns the numerical handle of the vehicle with the given id
+     *
+     * Handles are non-negative numbers which are assigned when the
+     *  vehicle is added. The lower bits hold the slot of the vehicle, which is
+     *  reused after the vehicle was deleted, the upper bits hold the generation
+     *  of the slot, so the handle of a deleted vehicle does not resolve to a later one.
+     *
+     * @param[in] id The id of the vehicle
+     * @return The handle of the vehicle, -1 if no such vehicle exists
+     */
+    int getHandle(const std::string& id) const;
+
+
+    /** @brief Returns the vehicle with the given numerical handle
+     *
+     * @param[in] handle The handle of the vehicle to retrieve
+     * @return The vehicle with the given handle, 0 if the handle is not in use or stale
+     */
+    SUMOVehicle* getVehicleByHandle(const int handle) const;
+
+
     /** @brief Deletes the vehicle
      *
      * @param[in] v The vehicle to delete
@@ -556,8 +579,21 @@ protected:
 
     /// @brief Vehicle dictionary type
     typedef std::map< std::string, SUMOVehicle* > VehicleDictType;
-    /// @brief Dictionary of vehicles
+    /// @brief Dictionary of vehicles (sorted by id for a deterministic iteration order)
     VehicleDictType myVehicleDict;
+    /// @brief The handles of the vehicles by id (for the lookup)
+    std::unordered_map<std::string, int> myHandles;
+    /// @brief The vehicles by handle slot (0 for an unused slot)
+    std::vector<SUMOVehicle*> myVehicleSlots;
+    /// @brief The current generation of each handle slot (increased when the vehicle is deleted)
+    std::vector<int> mySlotGenerations;
+    /// @brief The unused handle slots which will be assigned next
+    std::vector<int> myFreeHandles;
+
+    /// @brief The layout of a handle: slot | (generation << HANDLE_GENERATION_SHIFT)
+    static const int HANDLE_GENERATION_SHIFT = 24;
+    static const int HANDLE_SLOT_MASK = (1 << HANDLE_GENERATION_SHIFT) - 1;
+    static const int HANDLE_GENERATION_MASK = 0x7f;
     /// @}
 
 
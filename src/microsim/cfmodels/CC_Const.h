@@ -71,6 +71,22 @@ struct VEHICLE_DATA {
     double angle;        //vehicle angle in radians
 };
 
+/**
+ * Struct defining speed and acceleration data exchanged between platoon
+ * members (leader and preceding vehicle) and returned for the ego vehicle
+ */
+struct SPEED_AND_ACCELERATION {
+    double speed;                  //vehicle speed
+    double acceleration;           //vehicle acceleration
+    double controllerAcceleration; //acceleration computed by the controller
+    double positionX;              //position of the vehicle in the simulation
+    double positionY;              //position of the vehicle in the simulation
+    double time;                   //time at which such information was read from vehicle's sensors
+    double speedX;                 //vehicle speed on the X axis
+    double speedY;                 //vehicle speed on the Y axis
+    double angle;                  //vehicle angle in radians
+};
+
 /**
  * @enum VEHICLE_SENSORS
  * @brief An enumeration representing the different sensors associated to a vehicle
@@ -86,6 +102,7 @@ enum VEHICLE_SENSORS {
     EGO_ANGLE = 7,
     RADAR_DISTANCE = 8,
     RADAR_SPEED = 9,
+    N_VEHICLE_SENSORS = 10  //number of sensors, not a sensor itself
 };
 
 #define MAX_N_CARS 8
@@ -100,6 +117,7 @@ enum VEHICLE_SENSORS {
 #define ENGINE_PAR_VEHICLE               "vehicle"
 #define ENGINE_PAR_XMLFILE               "xmlFile"
 #define ENGINE_PAR_DT                    "dt_s"
+#define ENGINE_PAR_TABLE_TOLERANCE       "tableTolerance_mps2"
 
 #define CC_PAR_VEHICLE_DATA              "ccvd"   //data about a vehicle, like position, speed, acceleration, etc
 #define CC_PAR_VEHICLE_DATA_REALISTIC    "ccvdr"  //data about a vehicle, characterized by uncertainties according to the sensors parameters
@@ -133,6 +151,7 @@ enum VEHICLE_SENSORS {
 
 #define CC_PAR_VEHICLE_MODEL             "ccvm"    //set the vehicle model, i.e., engine characteristics
 #define CC_PAR_VEHICLES_FILE             "ccvf"    //set the location of the vehicle parameters file
+#define CC_PAR_ENGINE_TABLE_TOLERANCE    "ccett"   //use tabulated engine forces with the given accuracy (m/s^2, 0 disables)
 
 // set CACC constant spacing
 #define PAR_CACC_SPACING                 "ccsp"
@@ -216,6 +235,17 @@ enum VEHICLE_SENSORS {
 // let the leader automatically change lane for the whole platoon if there is a speed advantage
 #define PAR_ENABLE_AUTO_LANE_CHANGE      "ccalc"
 
+// sub types of the binary TraCI variable VAR_PLEXE_DATA. each of them mirrors
+// the string parameter given in the comment but transfers typed values
+#define PLEXE_DATA_LEADER_SPEED_AND_ACCELERATION    0x00 //PAR_LEADER_SPEED_AND_ACCELERATION (set)
+#define PLEXE_DATA_PRECEDING_SPEED_AND_ACCELERATION 0x01 //PAR_PRECEDING_SPEED_AND_ACCELERATION (set)
+#define PLEXE_DATA_VEHICLE_DATA                     0x02 //CC_PAR_VEHICLE_DATA (get/set)
+#define PLEXE_DATA_VEHICLE_DATA_REALISTIC           0x03 //CC_PAR_VEHICLE_DATA_REALISTIC (get)
+#define PLEXE_DATA_LEADER_FAKE_DATA                 0x04 //PAR_LEADER_FAKE_DATA (set)
+#define PLEXE_DATA_FRONT_FAKE_DATA                  0x05 //PAR_FRONT_FAKE_DATA (set)
+#define PLEXE_DATA_SPEED_AND_ACCELERATION           0x06 //PAR_SPEED_AND_ACCELERATION (get)
+#define PLEXE_DATA_SPEED_AND_ACCELERATION_REALISTIC 0x07 //PAR_SPEED_AND_ACCELERATION_REALISTIC (get)
+
 }
 
 #endif /* CC_CONST_H */
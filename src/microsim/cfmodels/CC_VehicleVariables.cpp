@@ -14,35 +14,40 @@
 ///
 /****************************************************************************/
 #include "CC_VehicleVariables.h"
+#include "MSCFModel_CC.h"
+
+#include <limits>
 
 #define DEFAULT_RADAR_MAX_DISTANCE 250 /* m */
 
-//initialize default L and K matrices
-const int CC_VehicleVariables::defaultL[][MAX_N_CARS] =
-    {
-    {0, 0, 0, 0, 0, 0, 0, 0},
-    {1, 0, 0, 0, 0, 0, 0, 0},
-    {1, 1, 0, 0, 0, 0, 0, 0},
-    {1, 0, 1, 0, 0, 0, 0, 0},
-    {1, 0, 0, 1, 0, 0, 0, 0},
-    {1, 0, 0, 0, 1, 0, 0, 0},
-    {1, 0, 0, 0, 0, 1, 0, 0},
-    {1, 0, 0, 0, 0, 0, 1, 0}
-    };
-const double CC_VehicleVariables::defaultK[][MAX_N_CARS] =
-    {
-    {0  , 0  , 0  , 0  , 0  , 0  , 0  , 0},
-    {460, 0  , 0  , 0  , 0  , 0  , 0  , 0},
-    {80 , 860, 0  , 0  , 0  , 0  , 0  , 0},
-    {80 , 0  , 860, 0  , 0  , 0  , 0  , 0},
-    {80 , 0  , 0  , 860, 0  , 0  , 0  , 0},
-    {80 , 0  , 0  , 0  , 860, 0  , 0  , 0},
-    {80 , 0  , 0  , 0  , 0  , 860, 0  , 0},
-    {80 , 0  , 0  , 0  , 0  , 0  , 860, 0}
-    };
-const double CC_VehicleVariables::defaultB[MAX_N_CARS] = {1800, 1800, 1800, 1800, 1800, 1800, 1800, 1800};
-const double CC_VehicleVariables::defaultH[MAX_N_CARS] = {0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8};
-const double CC_VehicleVariables::defaultS[MAX_N_CARS] = {15, 15, 15, 15, 15, 15, 15, 15};
+//gains of the default topology: the second car only listens to the
+//leader, while the others listen to both the leader and their predecessor
+#define DEFAULT_K_FIRST_FOLLOWER 460
+#define DEFAULT_K_LEADER         80
+#define DEFAULT_K_PREDECESSOR    860
+
+const double CC_VehicleVariables::defaultB = 1800;
+const double CC_VehicleVariables::defaultH = 0.8;
+const double CC_VehicleVariables::defaultS = 15;
+
+std::shared_ptr<const CC_VehicleVariables::ConsensusTopology> CC_VehicleVariables::getDefaultTopology(int nCars) {
+    static std::map<int, std::shared_ptr<const ConsensusTopology> > topologies;
+    std::shared_ptr<const ConsensusTopology>& topology = topologies[nCars];
+    if (!topology) {
+        ConsensusTopology* t = new ConsensusTopology();
+        t->rows.resize(nCars);
+        for (int i = 1; i < nCars; i++) {
+            if (i == 1) {
+                t->rows[i].push_back({0, 1, DEFAULT_K_FIRST_FOLLOWER});
+            } else {
+                t->rows[i].push_back({0, 1, DEFAULT_K_LEADER});
+                t->rows[i].push_back({i - 1, 1, DEFAULT_K_PREDECESSOR});
+            }
+        }
+        topology.reset(t);
+    }
+    return topology;
+}
 
 CC_VehicleVariables::CC_VehicleVariables() :
     controllerAcceleration(0), frontSpeed(0), frontAcceleration(0),
@@ -65,7 +70,7 @@ CC_VehicleVariables::CC_VehicleVariables() :
     engine(0), engineModel(CC_ENGINE_MODEL_FOLM),
     usePrediction(false),
     useRadarPredSpeed(false),
-    autoLaneChange(false) {
+    autoLaneChange(false), egoReadingsTime(std::numeric_limits<double>::lowest()) {
     fakeData.frontAcceleration = 0;
     fakeData.frontControllerAcceleration = 0;
     fakeData.frontDistance = 0;
@@ -75,32 +80,32 @@ CC_VehicleVariables::CC_VehicleVariables() :
     fakeData.leaderSpeed = 0;
     leaderPosition.set(0, 0);
     frontPosition.set(0, 0);
-    //init L, K, b, and h with default values
-    memcpy(L, defaultL, sizeof(int)*MAX_N_CARS*MAX_N_CARS);
-    memcpy(K, defaultK, sizeof(double)*MAX_N_CARS*MAX_N_CARS);
-    memcpy(b, defaultB, sizeof(double)*MAX_N_CARS);
-    memcpy(h, defaultH, sizeof(double)*MAX_N_CARS);
-    memcpy(s, defaultS, sizeof(double)*MAX_N_CARS);
-    //no data about any vehicle has been set
-    for (int i = 0; i < MAX_N_CARS; i++)
-        initialized[i] = false;
-
-    // Construct the default values for the different sensor parameters
-    sensors.emplace(Plexe::VEHICLE_SENSORS::EGO_TIME, RealisticSensor());
-    sensors.emplace(Plexe::VEHICLE_SENSORS::EGO_GPS_X, RealisticSensor());
-    sensors.emplace(Plexe::VEHICLE_SENSORS::EGO_GPS_Y, RealisticSensor());
-    sensors.emplace(Plexe::VEHICLE_SENSORS::EGO_SPEED, RealisticSensor());
-    sensors.emplace(Plexe::VEHICLE_SENSORS::EGO_SPEED_X, RealisticSensor());
-    sensors.emplace(Plexe::VEHICLE_SENSORS::EGO_SPEED_Y, RealisticSensor());
-    sensors.emplace(Plexe::VEHICLE_SENSORS::EGO_ACCELERATION, RealisticSensor());
-    sensors.emplace(Plexe::VEHICLE_SENSORS::EGO_ANGLE, RealisticSensor());
-    sensors.emplace(Plexe::VEHICLE_SENSORS::RADAR_DISTANCE, RealisticSensor());
-    sensors.emplace(Plexe::VEHICLE_SENSORS::RADAR_SPEED, RealisticSensor());
+    //init topology, b, h, s, and the data about the other vehicles
+    setPlatoonSize(nCars);
 
+    // the sensors are default constructed, i.e., ideal
     sensors[Plexe::VEHICLE_SENSORS::RADAR_DISTANCE].maxValue = DEFAULT_RADAR_MAX_DISTANCE;
 }
 
 CC_VehicleVariables::~CC_VehicleVariables() {
+    MSCFModel_CC::unregisterAutoFeeding(this);
     if (engine)
         delete engine;
 }
+
+void CC_VehicleVariables::setPlatoonSize(int n) {
+    nCars = n;
+    topology = getDefaultTopology(n);
+    //keep values which have been set for the whole platoon
+    b.resize(n, b.empty() ? defaultB : b.front());
+    h.resize(n, h.empty() ? defaultH : h.front());
+    s.resize(n, s.empty() ? defaultS : s.front());
+    vehicles.resize(n, Plexe::VEHICLE_DATA());
+    initialized.resize(n, false);
+    nInitialized = 0;
+    for (int i = 0; i < n; i++) {
+        if (initialized[i] && i != position) {
+            nInitialized++;
+        }
+    }
+}
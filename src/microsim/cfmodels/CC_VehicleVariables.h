@@ -31,6 +31,9 @@
 #include <string.h>
 #include <string>
 #include <map>
+#include <array>
+#include <memory>
+#include <vector>
 
 #include "GenericEngineModel.h"
 #include "FirstOrderLagModel.h"
@@ -67,29 +70,47 @@ public:
     };
 
     /**
-     * Topology matrix L for the consensus controller
+     * @struct ConsensusTopology
+     * @brief sparse representation of the topology matrix L and of the gains
+     * matrix K of the consensus controller. For each member of the platoon it
+     * lists the members it takes into account, i.e., the non zero entries of
+     * its row of L. A topology is immutable and shared among all the vehicles
+     * in platoons of the same size
      */
-    const static int defaultL[MAX_N_CARS][MAX_N_CARS];
+    struct ConsensusTopology {
+        /// @brief a non zero entry of the topology
+        struct Link {
+            /// @brief index of the other member (column of L and K)
+            int j;
+            /// @brief entry of L
+            int l;
+            /// @brief entry of K
+            double k;
+        };
+        /// @brief non zero entries per platoon member (row of L and K)
+        std::vector<std::vector<Link> > rows;
+    };
 
     /**
-     * Gains matrix K for the consensus controller
+     * @brief returns the default (leader and predecessor) topology for a
+     * platoon of the given size, creating it on first use
      */
-    const static double defaultK[MAX_N_CARS][MAX_N_CARS];
+    static std::shared_ptr<const ConsensusTopology> getDefaultTopology(int nCars);
 
     /**
-     * Default damping ratios vector b for the consensus controller
+     * Default damping ratio b for the consensus controller
      */
-    const static double defaultB[];
+    const static double defaultB;
 
     /**
-     * Default time headways vector h for the consensus controller
+     * Default time headway h for the consensus controller
      */
-    const static double defaultH[];
+    const static double defaultH;
 
     /**
-     * Default spacing vector s for the consensus controller
+     * Default spacing s for the consensus controller
      */
-    const static double defaultS[];
+    const static double defaultS;
 
     CC_VehicleVariables();
     ~CC_VehicleVariables();
@@ -165,21 +186,19 @@ public:
     /// @brief fake controller data. @see FAKE_CONTROLLER_DATA
     struct FAKE_CONTROLLER_DATA fakeData;
 
-    /// @brief L matrix
-    int L[MAX_N_CARS][MAX_N_CARS];
-    /// @brief K matrix
-    double K[MAX_N_CARS][MAX_N_CARS];
+    /// @brief L and K matrices, shared among platoons of the same size
+    std::shared_ptr<const ConsensusTopology> topology;
     /// @brief vector of damping ratios b
-    double b[MAX_N_CARS];
+    std::vector<double> b;
     /// @brief vector of time headways h
-    double h[MAX_N_CARS];
+    std::vector<double> h;
     /// @brief vector of spacing s (consensus controller)
-    double s[MAX_N_CARS];
+    std::vector<double> s;
 
     /// @brief data about vehicles in the platoon
-    struct Plexe::VEHICLE_DATA vehicles[MAX_N_CARS];
+    std::vector<struct Plexe::VEHICLE_DATA> vehicles;
     /// @brief tells whether data about a certain vehicle has been initialized
-    bool initialized[MAX_N_CARS];
+    std::vector<bool> initialized;
     /// @brief count of initialized vehicles
     int nInitialized;
     /// @brief my position within the platoon (0 = first car)
@@ -187,6 +206,15 @@ public:
     /// @brief number of cars in the platoon
     int nCars;
 
+    /**
+     * @brief sets the number of cars in the platoon, resizing the per member
+     * data and selecting the shared topology for the new size. Data about
+     * members which are still part of the platoon is kept
+     *
+     * @param[in] n the number of cars in the platoon
+     */
+    void setPlatoonSize(int n);
+
     /// @brief controller related parameters
     double caccXi;
     double caccOmegaN;
@@ -224,8 +252,13 @@ public:
     /// @brief automatic whole platoon lane change
     bool autoLaneChange;
 
-    // @brief The objects used to represent the characteristic of different sensors
-    std::map<enum Plexe::VEHICLE_SENSORS, RealisticSensor> sensors;
+    // @brief The objects used to represent the characteristic of different sensors, indexed by Plexe::VEHICLE_SENSORS
+    std::array<RealisticSensor, Plexe::N_VEHICLE_SENSORS> sensors;
+
+    /// @brief ego sensor readings of the current time step, shared by the controller and the getters
+    struct Plexe::SPEED_AND_ACCELERATION egoReadings;
+    /// @brief simulation time at which egoReadings have been taken
+    double egoReadingsTime;
 };
 
 #endif
@@ -30,17 +30,33 @@
 #include <microsim/MSVehicleControl.h>
 #include <microsim/MSNet.h>
 #include <microsim/MSEdge.h>
+#include <microsim/MSGlobals.h>
+#include <set>
 #include <utils/common/RandHelper.h>
 #include <utils/common/SUMOTime.h>
 #include <utils/common/TplConvert.h>
 #include <microsim/cfmodels/ParBuffer.h>
 #include <libsumo/Vehicle.h>
 #include <libsumo/TraCIDefs.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXConditionalLock.h>
+#endif
 
 #ifndef sgn
 #define sgn(x) ((x > 0) - (x < 0))
 #endif
 
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+std::map<const CC_VehicleVariables*, const MSVehicle*> MSCFModel_CC::myAutoFeedRegistry;
+std::vector<MSCFModel_CC::AutoFeedMember> MSCFModel_CC::myAutoFeedMembers;
+bool MSCFModel_CC::myAutoFeedMembersDirty(false);
+std::atomic<SUMOTime> MSCFModel_CC::myLastAutoFeedUpdate(-1);
+#ifdef HAVE_FOX
+FXMutex MSCFModel_CC::myAutoFeedMutex;
+#endif
+
 // ===========================================================================
 // method definitions
 // ===========================================================================
@@ -253,7 +269,7 @@ MSCFModel_CC::interactionGap(const MSVehicle* const veh, double vL) const {
     if (vars->activeController != Plexe::DRIVER)
     {
         //maximum radar range is CC is enabled
-        return vars->sensors.at(Plexe::VEHICLE_SENSORS::RADAR_DISTANCE).maxValue;
+        return vars->sensors[Plexe::VEHICLE_SENSORS::RADAR_DISTANCE].maxValue;
     }
     else {
         return myHumanDriver->interactionGap(veh, vL);
@@ -292,19 +308,18 @@ MSCFModel_CC::_v(const MSVehicle* const veh, double gap2pred, double egoSpeed, d
     double caccAcceleration;
     //variables needed by CACC
     double predAcceleration, leaderAcceleration;
-    //dummy variables used for auto feeding
-    Position pos;
-    double time;
 
     auto* vars = (CC_VehicleVariables*) veh->getCarFollowVariables();
 
     // Overwrite the parameters with the values obtained through realistic sensors
     double exactEgoSpeed = egoSpeed;
-    egoSpeed = vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_SPEED).getReading(egoSpeed, SIMTIME);
+    const struct Plexe::SPEED_AND_ACCELERATION& egoReadings = readEgoSensors(veh);
+    // the speed passed in may be a hypothetical one, so it gets the sensor error of the step snapshot
+    egoSpeed += egoReadings.speed - veh->getSpeed();
 
     double distance, relSpeed, radarSamplingTime;
     getRadarMeasurements(veh, distance, relSpeed, radarSamplingTime);
-    gap2pred = distance > 0 ? distance : vars->sensors.at(Plexe::VEHICLE_SENSORS::RADAR_DISTANCE).maxValue;
+    gap2pred = distance > 0 ? distance : vars->sensors[Plexe::VEHICLE_SENSORS::RADAR_DISTANCE].maxValue;
     predSpeed = egoSpeed + relSpeed;
 
     if (vars->crashed || vars->crashedVictim)
@@ -326,7 +341,7 @@ MSCFModel_CC::_v(const MSVehicle* const veh, double gap2pred, double egoSpeed, d
             }
         }
 
-        if (gap2pred > vars->sensors.at(Plexe::VEHICLE_SENSORS::RADAR_DISTANCE).maxValue || ccAcceleration < accAcceleration) {
+        if (gap2pred > vars->sensors[Plexe::VEHICLE_SENSORS::RADAR_DISTANCE].maxValue || ccAcceleration < accAcceleration) {
             controllerAcceleration = ccAcceleration;
         }
         else {
@@ -337,8 +352,7 @@ MSCFModel_CC::_v(const MSVehicle* const veh, double gap2pred, double egoSpeed, d
 
         // Use the real values obtained from SUMO, instead of the ones received through communication
         if (vars->autoFeed) {
-            getVehicleInformation(vars->leaderVehicle, vars->leaderSpeed, vars->leaderAcceleration, vars->leaderControllerAcceleration, pos, time);
-            getVehicleInformation(vars->frontVehicle, vars->frontSpeed, vars->frontAcceleration, vars->frontControllerAcceleration, pos, time);
+            updateAutoFeeding();
         }
 
         // Use either the acceleration requested by the controller or the measured one
@@ -365,8 +379,7 @@ MSCFModel_CC::_v(const MSVehicle* const veh, double gap2pred, double egoSpeed, d
         }
 
         // Use prediction to estimate the speed values depending on the elapsed time and the advertised acceleration
-        double currentTime = vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_TIME).getReading(
-                STEPS2TIME(MSNet::getInstance()->getCurrentTimeStep() + DELTA_T), SIMTIME);
+        double currentTime = egoReadings.time + TS;
         if (vars->usePrediction) {
             double measurementTimeLeader = vars->useRadarPredSpeed && vars->position == 1 ? radarSamplingTime : vars->frontDataReadTime;
             leaderSpeed += (currentTime - measurementTimeLeader) * vars->leaderAcceleration;
@@ -376,10 +389,7 @@ MSCFModel_CC::_v(const MSVehicle* const veh, double gap2pred, double egoSpeed, d
         }
 
         // Needed by the consensus controller
-        Position position = veh->getPosition();
-        position.set(
-                vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_GPS_X).getReading(position.x(), SIMTIME),
-                vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_GPS_Y).getReading(position.y(), SIMTIME));
+        Position position(egoReadings.positionX, egoReadings.positionY);
 
 
         switch (vars->activeController) {
@@ -396,12 +406,6 @@ MSCFModel_CC::_v(const MSVehicle* const veh, double gap2pred, double egoSpeed, d
 
             case Plexe::FAKED_CACC:
 
-                if (vars->autoFeed) {
-                    getVehicleInformation(vars->leaderVehicle, vars->fakeData.leaderSpeed, vars->fakeData.leaderAcceleration, vars->fakeData.leaderControllerAcceleration, pos, time);
-                    getVehicleInformation(vars->frontVehicle, vars->fakeData.frontSpeed, vars->fakeData.frontAcceleration, vars->fakeData.frontControllerAcceleration, pos, time);
-                    vars->fakeData.frontDistance = pos.distanceTo2D(veh->getPosition());
-                }
-
                 if (vars->useControllerAcceleration) {
                     predAcceleration = vars->fakeData.frontControllerAcceleration;
                     leaderAcceleration = vars->fakeData.leaderControllerAcceleration;
@@ -437,9 +441,7 @@ MSCFModel_CC::_v(const MSVehicle* const veh, double gap2pred, double egoSpeed, d
             case Plexe::FLATBED:
 
                 if (vars->caccInitialized) {
-                    double acceleration = vars->sensors.at(
-                            Plexe::VEHICLE_SENSORS::EGO_ACCELERATION).getReading(veh->getAcceleration(), SIMTIME);
-                    controllerAcceleration = _flatbed(veh, acceleration, egoSpeed, predSpeed, gap2pred, leaderSpeed);
+                    controllerAcceleration = _flatbed(veh, egoReadings.acceleration, egoSpeed, predSpeed, gap2pred, leaderSpeed);
                 }
                 else {
                     //do not let CACC take decisions until at least one packet has been received
@@ -513,7 +515,7 @@ MSCFModel_CC::_ploeg(const MSVehicle *veh, double egoSpeed, double predSpeed, do
 }
 
 double
-MSCFModel_CC::d_i_j(const struct Plexe::VEHICLE_DATA *vehicles, const double s[MAX_N_CARS], const double h[MAX_N_CARS], int i, int j) const {
+MSCFModel_CC::d_i_j(const std::vector<struct Plexe::VEHICLE_DATA>& vehicles, const std::vector<double>& s, const std::vector<double>& h, int i, int j) const {
 
     int k, min_i, max_i;
     double d = 0;
@@ -544,11 +546,12 @@ MSCFModel_CC::_consensus(const MSVehicle* veh, double egoSpeed, double leaderSpe
     //on the X axis. This needs to be fixed to consider direction as well
     CC_VehicleVariables* vars = (CC_VehicleVariables*)veh->getCarFollowVariables();
     int index = vars->position;
-    int nCars = vars->nCars;
-    struct Plexe::VEHICLE_DATA *vehicles = vars->vehicles;
+    //the position within the platoon has not been set (properly)
+    if (index < 0 || index >= vars->nCars)
+        return 0;
+    std::vector<struct Plexe::VEHICLE_DATA>& vehicles = vars->vehicles;
+    const std::vector<CC_VehicleVariables::ConsensusTopology::Link>& links = vars->topology->rows[index];
 
-    //loop variable
-    int j;
     //control input
     double u_i = 0;
     //actual distance term
@@ -561,10 +564,8 @@ MSCFModel_CC::_consensus(const MSVehicle* veh, double egoSpeed, double leaderSpe
     double d_i = 0;
 
     //compensate my position: compute prediction of what will be my position at time of actuation
-    Position egoVelocity = veh->getVelocityVector();
-    egoVelocity.set(
-            vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_SPEED_X).getReading(egoVelocity.x(), SIMTIME),
-            vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_SPEED_Y).getReading(egoVelocity.y(), SIMTIME));
+    const struct Plexe::SPEED_AND_ACCELERATION& egoReadings = readEgoSensors(veh);
+    Position egoVelocity(egoReadings.speedX, egoReadings.speedY);
 
     egoPosition.set(egoPosition.x() + egoVelocity.x() * STEPS2TIME(DELTA_T),
                     egoPosition.y() + egoVelocity.y() * STEPS2TIME(DELTA_T));
@@ -581,19 +582,16 @@ MSCFModel_CC::_consensus(const MSVehicle* veh, double egoSpeed, double leaderSpe
     //compute speed error.
     speedError = -vars->b[index] * (egoSpeed - leaderSpeed);
 
-    //compute desired distance term
-    for (j = 0; j < nCars; j++) {
-        if (j == index)
-            continue;
-        d_i += vars->L[index][j];
-        desiredDistance -= vars->K[index][j] * vars->L[index][j] * d_i_j(vehicles, vars->s, vars->h, index, j);
+    //compute desired distance term. only the non zero entries of L contribute
+    for (const CC_VehicleVariables::ConsensusTopology::Link& link : links) {
+        d_i += link.l;
+        desiredDistance -= link.k * link.l * d_i_j(vehicles, vars->s, vars->h, index, link.j);
     }
     desiredDistance = desiredDistance / d_i;
 
     //compute actual distance term
-    for (j = 0; j < nCars; j++) {
-        if (j == index)
-            continue;
+    for (const CC_VehicleVariables::ConsensusTopology::Link& link : links) {
+        const int j = link.j;
         //distance error for consensus with GPS equipped
         Position otherPosition;
         double dt = time - vehicles[j].time;
@@ -613,7 +611,7 @@ MSCFModel_CC::_consensus(const MSVehicle* veh, double egoSpeed, double leaderSpe
             distance = (gap2pred + vars->vehicles[j].length) * sgn(j - index);
         }
 
-        actualDistance -= vars->K[index][j] * vars->L[index][j] * distance;
+        actualDistance -= link.k * link.l * distance;
     }
 
     actualDistance = actualDistance / (d_i);
@@ -651,6 +649,84 @@ MSCFModel_CC::getVehicleInformation(const MSVehicle* veh, double& speed, double&
     time = SIMTIME;
 }
 
+void
+MSCFModel_CC::unregisterAutoFeeding(const CC_VehicleVariables* vars) {
+    if (myAutoFeedRegistry.erase(vars) > 0) {
+        myAutoFeedMembersDirty = true;
+    }
+}
+
+void
+MSCFModel_CC::sortAutoFeedMembers() {
+    // group the members by platoon leader
+    std::map<const MSVehicle*, std::vector<AutoFeedMember> > platoons;
+    for (auto& entry : myAutoFeedRegistry) {
+        CC_VehicleVariables* vars = const_cast<CC_VehicleVariables*>(entry.first);
+        platoons[vars->leaderVehicle].push_back({entry.second, vars});
+    }
+    myAutoFeedMembers.clear();
+    for (auto& platoon : platoons) {
+        // starting from the leader, append the members whose front vehicle has already been placed
+        std::vector<AutoFeedMember>& members = platoon.second;
+        std::set<const MSVehicle*> placed;
+        placed.insert(platoon.first);
+        while (!members.empty()) {
+            const int before = (int)members.size();
+            for (auto m = members.begin(); m != members.end();) {
+                if (placed.count(m->vars->frontVehicle) > 0) {
+                    placed.insert(m->veh);
+                    myAutoFeedMembers.push_back(*m);
+                    m = members.erase(m);
+                } else {
+                    m++;
+                }
+            }
+            if ((int)members.size() == before) {
+                // the remaining members follow vehicles outside of the platoon
+                myAutoFeedMembers.insert(myAutoFeedMembers.end(), members.begin(), members.end());
+                members.clear();
+            }
+        }
+    }
+    myAutoFeedMembersDirty = false;
+}
+
+void
+MSCFModel_CC::updateAutoFeeding() const {
+    const SUMOTime now = MSNet::getInstance()->getCurrentTimeStep();
+    if (myLastAutoFeedUpdate == now) {
+        return;
+    }
+#ifdef HAVE_FOX
+    FXConditionalLock lock(myAutoFeedMutex, MSGlobals::gNumSimThreads > 1);
+#endif
+    if (myLastAutoFeedUpdate == now) {
+        return;
+    }
+    if (myAutoFeedMembersDirty) {
+        sortAutoFeedMembers();
+    }
+    Position leaderPosition, frontPosition;
+    double time;
+    for (const AutoFeedMember& m : myAutoFeedMembers) {
+        CC_VehicleVariables* vars = m.vars;
+        if (vars->leaderVehicle == 0 || vars->frontVehicle == 0) {
+            continue;
+        }
+        getVehicleInformation(vars->leaderVehicle, vars->leaderSpeed, vars->leaderAcceleration, vars->leaderControllerAcceleration, leaderPosition, time);
+        getVehicleInformation(vars->frontVehicle, vars->frontSpeed, vars->frontAcceleration, vars->frontControllerAcceleration, frontPosition, time);
+        CC_VehicleVariables::FAKE_CONTROLLER_DATA& fake = vars->fakeData;
+        fake.leaderSpeed = vars->leaderSpeed;
+        fake.leaderAcceleration = vars->leaderAcceleration;
+        fake.leaderControllerAcceleration = vars->leaderControllerAcceleration;
+        fake.frontSpeed = vars->frontSpeed;
+        fake.frontAcceleration = vars->frontAcceleration;
+        fake.frontControllerAcceleration = vars->frontControllerAcceleration;
+        fake.frontDistance = frontPosition.distanceTo2D(m.veh->getPosition());
+    }
+    myLastAutoFeedUpdate = now;
+}
+
 void MSCFModel_CC::setParameter(MSVehicle *veh, const std::string& key, const std::string& value) const {
     // vehicle variables used to set the parameter
     CC_VehicleVariables *vars;
@@ -659,26 +735,15 @@ void MSCFModel_CC::setParameter(MSVehicle *veh, const std::string& key, const st
 
     vars = (CC_VehicleVariables*) veh->getCarFollowVariables();
     try {
-        if (key.compare(PAR_LEADER_SPEED_AND_ACCELERATION) == 0) {
-            double x, y, vx, vy;
-            buf >> vars->leaderSpeed >> vars->leaderAcceleration >> x >> y >> vars->leaderDataReadTime
-                >> vars->leaderControllerAcceleration >> vx >> vy >> vars->leaderAngle;
-            vars->leaderPosition = Position(x, y);
-            vars->leaderVelocity = Position(vx, vy);
-            vars->leaderInitialized = true;
-            if (vars->frontInitialized)
-                vars->caccInitialized = true;
-            return;
-        }
-        if (key.compare(PAR_PRECEDING_SPEED_AND_ACCELERATION) == 0) {
-            double x, y, vx, vy;
-            buf >> vars->frontSpeed >> vars->frontAcceleration >> x >> y >> vars->frontDataReadTime
-                >> vars->frontControllerAcceleration >> vx >> vy >> vars->frontAngle;
-            vars->frontPosition = Position(x, y);
-            vars->frontVelocity = Position(vx, vy);
-            vars->frontInitialized = true;
-            if (vars->leaderInitialized)
-                vars->caccInitialized = true;
+        if (key.compare(PAR_LEADER_SPEED_AND_ACCELERATION) == 0 || key.compare(PAR_PRECEDING_SPEED_AND_ACCELERATION) == 0) {
+            struct Plexe::SPEED_AND_ACCELERATION data;
+            buf >> data.speed >> data.acceleration >> data.positionX >> data.positionY >> data.time
+                >> data.controllerAcceleration >> data.speedX >> data.speedY >> data.angle;
+            if (key == PAR_LEADER_SPEED_AND_ACCELERATION) {
+                setLeaderInformation(veh, data);
+            } else {
+                setFrontInformation(veh, data);
+            }
             return;
         }
         if (key.compare(CC_PAR_VEHICLE_DATA) == 0) {
@@ -687,26 +752,21 @@ void MSCFModel_CC::setParameter(MSVehicle *veh, const std::string& key, const st
                    vehicle.positionX >> vehicle.positionY >> vehicle.time >>
                    vehicle.length >> vehicle.u >> vehicle.speedX >>
                    vehicle.speedY >> vehicle.angle;
-            //if the index is larger than the number of cars, simply ignore the data
-            if (vehicle.index >= vars->nCars || vehicle.index == -1)
-                return;
-            vars->vehicles[vehicle.index] = vehicle;
-            if (!vars->initialized[vehicle.index] && vehicle.index != vars->position) {
-                vars->nInitialized++;
-            }
-            vars->initialized[vehicle.index] = true;
+            setVehicleData(veh, vehicle);
             return;
         }
         if (key.compare(PAR_LEADER_FAKE_DATA) == 0) {
-            buf >> vars->fakeData.leaderSpeed >> vars->fakeData.leaderAcceleration
-                >> vars->fakeData.leaderControllerAcceleration;
+            double speed, acceleration, controllerAcceleration;
+            buf >> speed >> acceleration >> controllerAcceleration;
+            setLeaderFakeData(veh, speed, acceleration, controllerAcceleration);
             if (buf.last_empty())
                 vars->useControllerAcceleration = false;
             return;
         }
         if (key.compare(PAR_FRONT_FAKE_DATA) == 0) {
-            buf >> vars->fakeData.frontSpeed >> vars->fakeData.frontAcceleration >> vars->fakeData.frontDistance
-                >> vars->fakeData.frontControllerAcceleration;
+            double speed, acceleration, distance, controllerAcceleration;
+            buf >> speed >> acceleration >> distance >> controllerAcceleration;
+            setFrontFakeData(veh, speed, acceleration, distance, controllerAcceleration);
             if (buf.last_empty())
                 vars->useControllerAcceleration = false;
             return;
@@ -716,17 +776,11 @@ void MSCFModel_CC::setParameter(MSVehicle *veh, const std::string& key, const st
             return;
         }
         if (key.compare(CC_PAR_PLATOON_SIZE) == 0) {
-            vars->nCars = TplConvert::_2int(value.c_str());
-            // given that we have a static matrix, check that we're not
-            // setting a number of cars larger than the size of that matrix
-            if (vars->nCars > MAX_N_CARS) {
-                vars->nCars = MAX_N_CARS;
-                std::stringstream warn;
-                warn << "MSCFModel_CC: setting a number of cars of " << vars->nCars << " out of a maximum of " << MAX_N_CARS <<
-                        ". The CONSENSUS controller will not work properly if chosen. If you are using a different controller " <<
-                        "you can ignore this warning";
-                WRITE_WARNING(warn.str());
+            const int nCars = TplConvert::_2int(value.c_str());
+            if (nCars < 1) {
+                throw InvalidArgument("Invalid platoon size '" + value + "' for vehicle '" + veh->getID() + "'");
             }
+            vars->setPlatoonSize(nCars);
             return;
         }
         if (key.compare(PAR_ADD_MEMBER) == 0) {
@@ -810,11 +864,11 @@ void MSCFModel_CC::setParameter(MSVehicle *veh, const std::string& key, const st
             return;
         }
         if (key.compare(CC_PAR_CONSENSUS_H) == 0) {
-            std::fill(vars->h, vars->h + MAX_N_CARS, TplConvert::_2double(value.c_str()));
+            std::fill(vars->h.begin(), vars->h.end(), TplConvert::_2double(value.c_str()));
             return;
         }
         if (key.compare(CC_PAR_CONSENSUS_S) == 0) {
-            std::fill(vars->s, vars->s + MAX_N_CARS, TplConvert::_2double(value.c_str()));
+            std::fill(vars->s.begin(), vars->s.end(), TplConvert::_2double(value.c_str()));
             return;
         }
         if (key.compare(CC_PAR_VEHICLE_ENGINE_MODEL) == 0) {
@@ -851,6 +905,10 @@ void MSCFModel_CC::setParameter(MSVehicle *veh, const std::string& key, const st
             vars->engine->setParameter(ENGINE_PAR_XMLFILE, value);
             return;
         }
+        if (key.compare(CC_PAR_ENGINE_TABLE_TOLERANCE) == 0) {
+            vars->engine->setParameter(ENGINE_PAR_TABLE_TOLERANCE, TplConvert::_2double(value.c_str()));
+            return;
+        }
         if (key.compare(PAR_CACC_SPACING) == 0) {
             vars->caccSpacing = TplConvert::_2double(value.c_str());
             return;
@@ -901,6 +959,12 @@ void MSCFModel_CC::setParameter(MSVehicle *veh, const std::string& key, const st
                 vars->leaderInitialized = true;
                 vars->frontInitialized = true;
                 vars->caccInitialized = true;
+                myAutoFeedRegistry[vars] = veh;
+                myAutoFeedMembersDirty = true;
+                // fill the data of the new member in the current step as well
+                myLastAutoFeedUpdate = -1;
+            } else {
+                unregisterAutoFeeding(vars);
             }
             return;
         }
@@ -951,27 +1015,12 @@ std::string MSCFModel_CC::getParameter(const MSVehicle *veh, const std::string&
     ParBuffer buf;
 
     vars = (CC_VehicleVariables*) veh->getCarFollowVariables();
-    if (key.compare(PAR_SPEED_AND_ACCELERATION) == 0) {
-        Position velocity = veh->getVelocityVector();
-        buf << veh->getSpeed() << veh->getAcceleration() <<
-               vars->controllerAcceleration << veh->getPosition().x() <<
-               veh->getPosition().y() <<
-               SIMTIME <<
-               velocity.x() << velocity.y() << veh->getAngle();
-        return buf.str();
-    }
-    if (key.compare(PAR_SPEED_AND_ACCELERATION_REALISTIC) == 0) {
-        Position velocity = veh->getVelocityVector();
-
-        buf << vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_SPEED).getReading(veh->getSpeed(), SIMTIME)
-            << vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_ACCELERATION).getReading(veh->getAcceleration(), SIMTIME)
-            << vars->controllerAcceleration
-            << vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_GPS_X).getReading(veh->getPosition().x(), SIMTIME)
-            << vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_GPS_Y).getReading(veh->getPosition().y(), SIMTIME)
-            << vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_TIME).getReading(SIMTIME, SIMTIME)
-            << vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_SPEED_X).getReading(velocity.x(), SIMTIME)
-            << vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_SPEED_Y).getReading(velocity.y(), SIMTIME)
-            << vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_ANGLE).getReading(veh->getAngle(), SIMTIME);
+    if (key.compare(PAR_SPEED_AND_ACCELERATION) == 0 || key.compare(PAR_SPEED_AND_ACCELERATION_REALISTIC) == 0) {
+        struct Plexe::SPEED_AND_ACCELERATION data;
+        getSpeedAndAcceleration(veh, data, key == PAR_SPEED_AND_ACCELERATION_REALISTIC);
+        buf << data.speed << data.acceleration << data.controllerAcceleration <<
+               data.positionX << data.positionY << data.time <<
+               data.speedX << data.speedY << data.angle;
         return buf.str();
     }
     if (key.compare(PAR_CRASHED) == 0) {
@@ -1054,22 +1103,7 @@ std::string MSCFModel_CC::getParameter(const MSVehicle *veh, const std::string&
         int index;
         inBuf >> index;
         struct Plexe::VEHICLE_DATA vehicle;
-        if (index >= vars->nCars || index < 0)
-            vehicle.index = -1;
-        else
-            vehicle = vars->vehicles[index];
-
-        if (key == CC_PAR_VEHICLE_DATA_REALISTIC) {
-            vehicle.time = vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_TIME).getReading(vehicle.time, SIMTIME);
-            vehicle.positionX = vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_GPS_X).getReading(vehicle.positionX, SIMTIME);
-            vehicle.positionY = vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_GPS_Y).getReading(vehicle.positionY, SIMTIME);
-            vehicle.speed = vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_SPEED).getReading(vehicle.speed, SIMTIME);
-            vehicle.speedX = vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_SPEED_X).getReading(vehicle.speedX, SIMTIME);
-            vehicle.speedY = vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_SPEED_Y).getReading(vehicle.speedY, SIMTIME);
-            vehicle.acceleration = vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_ACCELERATION).getReading(vehicle.acceleration, SIMTIME);
-            vehicle.angle = vars->sensors.at(Plexe::VEHICLE_SENSORS::EGO_ANGLE).getReading(vehicle.angle, SIMTIME);
-        }
-
+        getVehicleData(veh, index, vehicle, key == CC_PAR_VEHICLE_DATA_REALISTIC);
         buf << vehicle.index << vehicle.speed << vehicle.acceleration <<
                vehicle.positionX << vehicle.positionY << vehicle.time <<
                vehicle.length << vehicle.u << vehicle.speedX <<
@@ -1093,6 +1127,121 @@ std::string MSCFModel_CC::getParameter(const MSVehicle *veh, const std::string&
     return "";
 }
 
+void MSCFModel_CC::setLeaderInformation(const MSVehicle *veh, const struct Plexe::SPEED_AND_ACCELERATION& data) const {
+    CC_VehicleVariables* vars = (CC_VehicleVariables*) veh->getCarFollowVariables();
+    vars->leaderSpeed = data.speed;
+    vars->leaderAcceleration = data.acceleration;
+    vars->leaderPosition = Position(data.positionX, data.positionY);
+    vars->leaderDataReadTime = data.time;
+    vars->leaderControllerAcceleration = data.controllerAcceleration;
+    vars->leaderVelocity = Position(data.speedX, data.speedY);
+    vars->leaderAngle = data.angle;
+    vars->leaderInitialized = true;
+    if (vars->frontInitialized)
+        vars->caccInitialized = true;
+}
+
+void MSCFModel_CC::setFrontInformation(const MSVehicle *veh, const struct Plexe::SPEED_AND_ACCELERATION& data) const {
+    CC_VehicleVariables* vars = (CC_VehicleVariables*) veh->getCarFollowVariables();
+    vars->frontSpeed = data.speed;
+    vars->frontAcceleration = data.acceleration;
+    vars->frontPosition = Position(data.positionX, data.positionY);
+    vars->frontDataReadTime = data.time;
+    vars->frontControllerAcceleration = data.controllerAcceleration;
+    vars->frontVelocity = Position(data.speedX, data.speedY);
+    vars->frontAngle = data.angle;
+    vars->frontInitialized = true;
+    if (vars->leaderInitialized)
+        vars->caccInitialized = true;
+}
+
+void MSCFModel_CC::setVehicleData(const MSVehicle *veh, const struct Plexe::VEHICLE_DATA& data) const {
+    CC_VehicleVariables* vars = (CC_VehicleVariables*) veh->getCarFollowVariables();
+    //if the index is larger than the number of cars, simply ignore the data
+    if (data.index >= vars->nCars || data.index < 0)
+        return;
+    vars->vehicles[data.index] = data;
+    if (!vars->initialized[data.index] && data.index != vars->position) {
+        vars->nInitialized++;
+    }
+    vars->initialized[data.index] = true;
+}
+
+void MSCFModel_CC::setLeaderFakeData(const MSVehicle *veh, double speed, double acceleration, double controllerAcceleration) const {
+    CC_VehicleVariables* vars = (CC_VehicleVariables*) veh->getCarFollowVariables();
+    vars->fakeData.leaderSpeed = speed;
+    vars->fakeData.leaderAcceleration = acceleration;
+    vars->fakeData.leaderControllerAcceleration = controllerAcceleration;
+}
+
+void MSCFModel_CC::setFrontFakeData(const MSVehicle *veh, double speed, double acceleration, double distance, double controllerAcceleration) const {
+    CC_VehicleVariables* vars = (CC_VehicleVariables*) veh->getCarFollowVariables();
+    vars->fakeData.frontSpeed = speed;
+    vars->fakeData.frontAcceleration = acceleration;
+    vars->fakeData.frontDistance = distance;
+    vars->fakeData.frontControllerAcceleration = controllerAcceleration;
+}
+
+void MSCFModel_CC::getSpeedAndAcceleration(const MSVehicle *veh, struct Plexe::SPEED_AND_ACCELERATION& data, bool realisticSensor) const {
+    CC_VehicleVariables* vars = (CC_VehicleVariables*) veh->getCarFollowVariables();
+    if (realisticSensor) {
+        data = readEgoSensors(veh);
+    } else {
+        const Position velocity = veh->getVelocityVector();
+        const Position& position = veh->getPosition();
+        data.speed = veh->getSpeed();
+        data.acceleration = veh->getAcceleration();
+        data.positionX = position.x();
+        data.positionY = position.y();
+        data.time = SIMTIME;
+        data.speedX = velocity.x();
+        data.speedY = velocity.y();
+        data.angle = veh->getAngle();
+    }
+    data.controllerAcceleration = vars->controllerAcceleration;
+}
+
+const struct Plexe::SPEED_AND_ACCELERATION& MSCFModel_CC::readEgoSensors(const MSVehicle *veh) const {
+    CC_VehicleVariables* vars = (CC_VehicleVariables*) veh->getCarFollowVariables();
+    const double now = SIMTIME;
+    if (vars->egoReadingsTime != now) {
+        struct Plexe::SPEED_AND_ACCELERATION& readings = vars->egoReadings;
+        const Position velocity = veh->getVelocityVector();
+        const Position& position = veh->getPosition();
+        readings.speed = vars->sensors[Plexe::VEHICLE_SENSORS::EGO_SPEED].getReading(veh->getSpeed(), now);
+        readings.acceleration = vars->sensors[Plexe::VEHICLE_SENSORS::EGO_ACCELERATION].getReading(veh->getAcceleration(), now);
+        readings.positionX = vars->sensors[Plexe::VEHICLE_SENSORS::EGO_GPS_X].getReading(position.x(), now);
+        readings.positionY = vars->sensors[Plexe::VEHICLE_SENSORS::EGO_GPS_Y].getReading(position.y(), now);
+        readings.time = vars->sensors[Plexe::VEHICLE_SENSORS::EGO_TIME].getReading(now, now);
+        readings.speedX = vars->sensors[Plexe::VEHICLE_SENSORS::EGO_SPEED_X].getReading(velocity.x(), now);
+        readings.speedY = vars->sensors[Plexe::VEHICLE_SENSORS::EGO_SPEED_Y].getReading(velocity.y(), now);
+        readings.angle = vars->sensors[Plexe::VEHICLE_SENSORS::EGO_ANGLE].getReading(veh->getAngle(), now);
+        readings.controllerAcceleration = 0;
+        vars->egoReadingsTime = now;
+    }
+    return vars->egoReadings;
+}
+
+void MSCFModel_CC::getVehicleData(const MSVehicle *veh, int index, struct Plexe::VEHICLE_DATA& data, bool realisticSensor) const {
+    CC_VehicleVariables* vars = (CC_VehicleVariables*) veh->getCarFollowVariables();
+    if (index >= vars->nCars || index < 0) {
+        data.index = -1;
+    } else {
+        data = vars->vehicles[index];
+    }
+    if (realisticSensor) {
+        // the cached measurements of the sensors belong to the ego readings
+        data.time = vars->sensors[Plexe::VEHICLE_SENSORS::EGO_TIME].getInstantReading(data.time);
+        data.positionX = vars->sensors[Plexe::VEHICLE_SENSORS::EGO_GPS_X].getInstantReading(data.positionX);
+        data.positionY = vars->sensors[Plexe::VEHICLE_SENSORS::EGO_GPS_Y].getInstantReading(data.positionY);
+        data.speed = vars->sensors[Plexe::VEHICLE_SENSORS::EGO_SPEED].getInstantReading(data.speed);
+        data.speedX = vars->sensors[Plexe::VEHICLE_SENSORS::EGO_SPEED_X].getInstantReading(data.speedX);
+        data.speedY = vars->sensors[Plexe::VEHICLE_SENSORS::EGO_SPEED_Y].getInstantReading(data.speedY);
+        data.acceleration = vars->sensors[Plexe::VEHICLE_SENSORS::EGO_ACCELERATION].getInstantReading(data.acceleration);
+        data.angle = vars->sensors[Plexe::VEHICLE_SENSORS::EGO_ANGLE].getInstantReading(data.angle);
+    }
+}
+
 void MSCFModel_CC::recomputeParameters(const MSVehicle *veh) const {
     CC_VehicleVariables* vars = (CC_VehicleVariables*) veh->getCarFollowVariables();
     vars->caccAlpha1 = 1 - vars->caccC1;
@@ -1104,7 +1253,7 @@ void MSCFModel_CC::recomputeParameters(const MSVehicle *veh) const {
 
 void MSCFModel_CC::resetConsensus(const MSVehicle *veh) const {
     CC_VehicleVariables* vars = (CC_VehicleVariables*) veh->getCarFollowVariables();
-    for (int i = 0; i < MAX_N_CARS; i++) {
+    for (int i = 0; i < (int)vars->initialized.size(); i++) {
         vars->initialized[i] = false;
         vars->nInitialized = 0;
     }
@@ -1123,7 +1272,7 @@ enum Plexe::ACTIVE_CONTROLLER MSCFModel_CC::getActiveController(const MSVehicle
 
 void MSCFModel_CC::getRadarMeasurements(const MSVehicle * veh, double &distance, double &relativeSpeed, double &samplingTime, bool realisticSensors) const {
     auto *vars = (CC_VehicleVariables *) veh->getCarFollowVariables();
-    double maxRadarDistance = vars->sensors.at(Plexe::VEHICLE_SENSORS::RADAR_DISTANCE).maxValue;
+    double maxRadarDistance = vars->sensors[Plexe::VEHICLE_SENSORS::RADAR_DISTANCE].maxValue;
     std::pair<std::string, double> predecessor = libsumo::Vehicle::getLeader(veh->getID(), maxRadarDistance);
 
     samplingTime = SIMTIME;
@@ -1139,8 +1288,8 @@ void MSCFModel_CC::getRadarMeasurements(const MSVehicle * veh, double &distance,
 
     if (realisticSensors) {
         double distanceSampling, speedSampling;
-        distance = vars->sensors.at(Plexe::VEHICLE_SENSORS::RADAR_DISTANCE).getReading(distance, SIMTIME, distanceSampling);
-        relativeSpeed = vars->sensors.at(Plexe::VEHICLE_SENSORS::RADAR_SPEED).getReading(relativeSpeed, SIMTIME, speedSampling);
+        distance = vars->sensors[Plexe::VEHICLE_SENSORS::RADAR_DISTANCE].getReading(distance, SIMTIME, distanceSampling);
+        relativeSpeed = vars->sensors[Plexe::VEHICLE_SENSORS::RADAR_SPEED].getReading(relativeSpeed, SIMTIME, speedSampling);
         samplingTime = std::min(distanceSampling, speedSampling);
     }
 }
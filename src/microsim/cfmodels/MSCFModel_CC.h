@@ -34,6 +34,12 @@
 #include <utils/xml/SUMOXMLDefinitions.h>
 #include <microsim/cfmodels/MSCFModel_Krauss.h>
 #include <string.h>
+#include <atomic>
+#include <map>
+#include <vector>
+#ifdef HAVE_FOX
+#include <fx.h>
+#endif
 
 #include "GenericEngineModel.h"
 #include "FirstOrderLagModel.h"
@@ -216,6 +222,89 @@ public:
      */
     virtual void setParameter(MSVehicle *veh, const std::string& key, const std::string& value) const;
 
+    /// @name typed access to the data exchanged between platoon members
+    /// these are the counterparts of the corresponding string parameters
+    /// which avoid formatting and parsing the values at each time step
+    /// @{
+
+    /**
+     * @brief sets the data about the platoon leader (see PAR_LEADER_SPEED_AND_ACCELERATION)
+     *
+     * @param[in] veh the vehicle for which the data must be saved
+     * @param[in] data the data received from the leader
+     */
+    void setLeaderInformation(const MSVehicle *veh, const struct Plexe::SPEED_AND_ACCELERATION& data) const;
+
+    /**
+     * @brief sets the data about the preceding vehicle (see PAR_PRECEDING_SPEED_AND_ACCELERATION)
+     *
+     * @param[in] veh the vehicle for which the data must be saved
+     * @param[in] data the data received from the preceding vehicle
+     */
+    void setFrontInformation(const MSVehicle *veh, const struct Plexe::SPEED_AND_ACCELERATION& data) const;
+
+    /**
+     * @brief sets the data about a member of the platoon (see CC_PAR_VEHICLE_DATA).
+     * Data with an index outside the platoon is ignored
+     *
+     * @param[in] veh the vehicle for which the data must be saved
+     * @param[in] data the data of the platoon member
+     */
+    void setVehicleData(const MSVehicle *veh, const struct Plexe::VEHICLE_DATA& data) const;
+
+    /**
+     * @brief sets the fake data about the leader (see PAR_LEADER_FAKE_DATA)
+     *
+     * @param[in] veh the vehicle for which the data must be saved
+     * @param[in] speed the fake leader speed
+     * @param[in] acceleration the fake leader acceleration
+     * @param[in] controllerAcceleration the fake leader controller acceleration
+     */
+    void setLeaderFakeData(const MSVehicle *veh, double speed, double acceleration, double controllerAcceleration) const;
+
+    /**
+     * @brief sets the fake data about the preceding vehicle (see PAR_FRONT_FAKE_DATA)
+     *
+     * @param[in] veh the vehicle for which the data must be saved
+     * @param[in] speed the fake front vehicle speed
+     * @param[in] acceleration the fake front vehicle acceleration
+     * @param[in] distance the fake distance to the front vehicle
+     * @param[in] controllerAcceleration the fake front vehicle controller acceleration
+     */
+    void setFrontFakeData(const MSVehicle *veh, double speed, double acceleration, double distance, double controllerAcceleration) const;
+
+    /**
+     * @brief gets speed and acceleration of the vehicle (see PAR_SPEED_AND_ACCELERATION)
+     *
+     * @param[in] veh the vehicle for which the data is requested
+     * @param[out] data where the data is written
+     * @param[in] realisticSensor whether to apply the sensor uncertainties
+     */
+    void getSpeedAndAcceleration(const MSVehicle *veh, struct Plexe::SPEED_AND_ACCELERATION& data, bool realisticSensor = false) const;
+
+    /**
+     * @brief gets the stored data about a member of the platoon (see CC_PAR_VEHICLE_DATA)
+     *
+     * @param[in] veh the vehicle for which the data is requested
+     * @param[in] index the index of the platoon member
+     * @param[out] data where the data is written. index is set to -1 if
+     * the requested index is outside the platoon
+     * @param[in] realisticSensor whether to apply the sensor uncertainties
+     */
+    void getVehicleData(const MSVehicle *veh, int index, struct Plexe::VEHICLE_DATA& data, bool realisticSensor = false) const;
+    /// @}
+
+    /**
+     * @brief reads all the ego sensors (speed, acceleration, position, time,
+     * velocity, and angle) once per time step. The controller and the getters
+     * share the same readings so that they are consistent within a time step.
+     * The controllerAcceleration field is not a sensor reading and left unset
+     *
+     * @param[in] veh the vehicle to read the sensors of
+     * @return the readings of the current time step
+     */
+    const struct Plexe::SPEED_AND_ACCELERATION& readEgoSensors(const MSVehicle *veh) const;
+
     /**
      * @brief get the information about a vehicle. This can be used by TraCI in order to
      * get speed and acceleration of the platoon leader before sending them to other
@@ -230,6 +319,15 @@ public:
      */
     void getVehicleInformation(const MSVehicle* veh, double& speed, double& acceleration, double& controllerAcceleration, Position &position, double &time) const;
 
+    /**
+     * @brief removes a vehicle from the set of auto fed platoon members.
+     * Called when auto feeding is switched off and when the variables of
+     * the vehicle are destroyed
+     *
+     * @param[in] vars the variables of the vehicle to be removed
+     */
+    static void unregisterAutoFeeding(const CC_VehicleVariables* vars);
+
     /**
      * @brief switch on the ACC, so disabling the human driver car control
      *
@@ -286,6 +384,18 @@ private:
      */
     void resetConsensus(const MSVehicle *veh) const;
 
+    /**
+     * @brief fills the leader and front data of all auto fed vehicles. This is
+     * done once per time step, platoon by platoon, before the first controller
+     * needs it, so that every member sees the state of its leader and
+     * predecessor at the beginning of the step independently of the order in
+     * which the vehicles are processed
+     */
+    void updateAutoFeeding() const;
+
+    /// @brief sorts the auto fed vehicles by platoon (leader) and within the platoon by the chain of front vehicles
+    static void sortAutoFeedMembers();
+
 private:
     void performAutoLaneChange(MSVehicle *const veh) const;
 
@@ -348,14 +458,14 @@ private:
     /** @brief computes the desired distance between vehicle i and vehicle j
      *
      * @param[in] vehicles data about all vehicles
-     * @param[in] d vector of spacings
+     * @param[in] s vector of spacings
      * @param[in] h vector of times headway
      * @param[in] i index of own vehicle
      * @param[in] j index of vehicle to compute distance from
      * @return the desired distance between vehicle i and j
      *
      */
-    double d_i_j(const struct Plexe::VEHICLE_DATA *vehicles, const double d[MAX_N_CARS], const double h[MAX_N_CARS], int i, int j) const;
+    double d_i_j(const std::vector<struct Plexe::VEHICLE_DATA>& vehicles, const std::vector<double>& s, const std::vector<double>& h, int i, int j) const;
 
     /** @brief flatbed platoon towing model
      *
@@ -416,6 +526,29 @@ private:
     const double myFlatbedKp;
     const double myFlatbedH;
     const double myFlatbedD;
+
+    /// @brief a vehicle which is automatically fed with the data of its leader and predecessor
+    struct AutoFeedMember {
+        const MSVehicle* veh;
+        CC_VehicleVariables* vars;
+    };
+
+    /// @brief the auto fed vehicles indexed by their variables
+    static std::map<const CC_VehicleVariables*, const MSVehicle*> myAutoFeedRegistry;
+
+    /// @brief the auto fed vehicles sorted by platoon and position, rebuilt whenever the registry changes
+    static std::vector<AutoFeedMember> myAutoFeedMembers;
+
+    /// @brief whether myAutoFeedMembers needs to be rebuilt
+    static bool myAutoFeedMembersDirty;
+
+    /// @brief the time step in which the auto fed data has been updated last
+    static std::atomic<SUMOTime> myLastAutoFeedUpdate;
+
+#ifdef HAVE_FOX
+    /// @brief guards the update of the auto fed data when planning movements in parallel
+    static FXMutex myAutoFeedMutex;
+#endif
 };
 
 #endif /* MSCFMODEL_CC_H */
@@ -74,11 +74,11 @@ MSCFModel_PWag2009::followSpeed(const MSVehicle* const veh, double speed, double
     const double asafe = SPEED2ACCEL(vsafe - speed);
     VehicleVariables* vars = (VehicleVariables*)veh->getCarFollowVariables();
     double apref = vars->aOld;
-    if (apref <= asafe && RandHelper::rand() <= myActionPointProbability * TS) {
+    if (apref <= asafe && RandHelper::rand(veh->getRNG()) <= myActionPointProbability * TS) {
         apref = myDecelDivTau * (gap + (predSpeed - speed) * myHeadwayTime - speed * myHeadwayTime) / (speed + myTauDecel);
         apref = MIN2(apref, myAccel);
         apref = MAX2(apref, -myDecel);
-        apref += myDawdle * RandHelper::rand((double) - 1., (double)1.);
+        apref += myDawdle * RandHelper::rand(-1., 1., veh->getRNG());
     }
     if (apref > asafe) {
         apref = asafe;
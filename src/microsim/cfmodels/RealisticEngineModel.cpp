@@ -32,11 +32,19 @@
 #include "CC_Const.h"
 #include "utils/common/StdDefs.h"
 
-RealisticEngineModel::RealisticEngineModel() {
+//initial distance between samples of the engine tables
+#define TABLE_INITIAL_STEP_MPS 1.0
+//minimum distance between samples of the engine tables
+#define TABLE_MIN_STEP_MPS     0.001
+
+RealisticEngineModel::EngineParametersCache RealisticEngineModel::myEngineParametersCache;
+RealisticEngineModel::EngineTablesCache RealisticEngineModel::myEngineTablesCache;
+
+RealisticEngineModel::RealisticEngineModel() : ep(&getDefaultParameters()), tables(0), tableTolerance_mps2(0) {
     className = "RealisticEngineModel";
     dt_s = 0.01;
     xmlFile = "vehicles.xml";
-    minSpeed_mps = rpmToSpeed_mps(ep.minRpm, ep.wheelDiameter_m, ep.differentialRatio, ep.gearRatios[0]);
+    minSpeed_mps = rpmToSpeed_mps(ep->minRpm, ep->wheelDiameter_m, ep->differentialRatio, ep->gearRatios[0]);
 #ifdef EE
     initee = false;
     lastTimeStep = -1;
@@ -51,7 +59,7 @@ double RealisticEngineModel::rpmToSpeed_mps(double rpm, double wheelDiameter_m =
 }
 
 double RealisticEngineModel::rpmToSpeed_mps(double rpm) {
-    return ep.__rpmToSpeedCoefficient * rpm / ep.gearRatios[currentGear];
+    return ep->__rpmToSpeedCoefficient * rpm / ep->gearRatios[currentGear];
 }
 
 double RealisticEngineModel::speed_mpsToRpm(double speed_mps, double wheelDiameter_m,
@@ -60,11 +68,11 @@ double RealisticEngineModel::speed_mpsToRpm(double speed_mps, double wheelDiamet
 }
 
 double RealisticEngineModel::speed_mpsToRpm(double speed_mps) {
-    return ep.__speedToRpmCoefficient * speed_mps * ep.gearRatios[currentGear];
+    return ep->__speedToRpmCoefficient * speed_mps * ep->gearRatios[currentGear];
 }
 
 double RealisticEngineModel::speed_mpsToRpm(double speed_mps, double gearRatio) {
-    return ep.__speedToRpmCoefficient * speed_mps * gearRatio;
+    return ep->__speedToRpmCoefficient * speed_mps * gearRatio;
 }
 
 double RealisticEngineModel::rpmToPower_hp(double rpm, const struct EngineParameters::PolynomialEngineModelRpmToHp *engineMapping) {
@@ -76,12 +84,12 @@ double RealisticEngineModel::rpmToPower_hp(double rpm, const struct EngineParame
 }
 
 double RealisticEngineModel::rpmToPower_hp(double rpm) {
-    if (rpm >= ep.maxRpm)
-        rpm = ep.maxRpm;
-    double sum = ep.engineMapping.x[0];
+    if (rpm >= ep->maxRpm)
+        rpm = ep->maxRpm;
+    double sum = ep->engineMapping.x[0];
     uint8_t i;
-    for (i = 1; i < ep.engineMapping.degree; i++)
-        sum += ep.engineMapping.x[i] * pow(rpm, i);
+    for (i = 1; i < ep->engineMapping.degree; i++)
+        sum += ep->engineMapping.x[i] * pow(rpm, i);
     return sum;
 }
 
@@ -107,21 +115,21 @@ double RealisticEngineModel::speed_mpsToThrust_N(double speed_mps,
 
 double RealisticEngineModel::speed_mpsToThrust_N(double speed_mps) {
     double power_hp = speed_mpsToPower_hp(speed_mps);
-    return ep.__speedToThrustCoefficient * power_hp / speed_mps;
+    return ep->__speedToThrustCoefficient * power_hp / speed_mps;
 }
 
 double RealisticEngineModel::airDrag_N(double speed_mps, double cAir, double a_m2, double rho_kgpm3) {
     return 0.5 * cAir * a_m2 * rho_kgpm3 * speed_mps * speed_mps;
 }
 double RealisticEngineModel::airDrag_N(double speed_mps) {
-    return ep.__airFrictionCoefficient * speed_mps * speed_mps;
+    return ep->__airFrictionCoefficient * speed_mps * speed_mps;
 }
 
 double RealisticEngineModel::rollingResistance_N(double speed_mps, double mass_kg, double cr1, double cr2) {
     return mass_kg * GRAVITY_MPS2 * (cr1 + cr2 * speed_mps * speed_mps);
 }
 double RealisticEngineModel::rollingResistance_N(double speed_mps) {
-    return ep.__cr1 + ep.__cr2 * speed_mps * speed_mps;
+    return ep->__cr1 + ep->__cr2 * speed_mps * speed_mps;
 }
 
 double RealisticEngineModel::gravityForce_N(double mass_kg, double slope = 0) {
@@ -129,7 +137,7 @@ double RealisticEngineModel::gravityForce_N(double mass_kg, double slope = 0) {
 }
 
 double RealisticEngineModel::gravityForce_N() {
-    return ep.__gravity;
+    return ep->__gravity;
 }
 
 double RealisticEngineModel::opposingForce_N(double speed_mps, double mass_kg, double slope,
@@ -148,19 +156,34 @@ double RealisticEngineModel::maxNoSlipAcceleration_mps2(double slope, double fri
 }
 
 double RealisticEngineModel::maxNoSlipAcceleration_mps2() {
-    return ep.__maxNoSlipAcceleration;
+    return ep->__maxNoSlipAcceleration;
 }
 
 double RealisticEngineModel::thrust_NToAcceleration_mps2(double thrust_N) {
-    return thrust_N / ep.__maxAccelerationCoefficient;
+    return thrust_N / ep->__maxAccelerationCoefficient;
+}
+
+double RealisticEngineModel::opposingAcceleration_mps2(double speed_mps) {
+    double accel_mps2;
+    if (tables != 0 && tables->opposingAcceleration_mps2.evaluate(speed_mps, accel_mps2))
+        return accel_mps2;
+    return thrust_NToAcceleration_mps2(opposingForce_N(speed_mps));
 }
 
 uint8_t RealisticEngineModel::performGearShifting(double speed_mps, double acceleration_mps2) {
     uint8_t newGear = 0;
-    double delta = acceleration_mps2 >= 0 ? ep.shiftingRule.deltaRpm : -ep.shiftingRule.deltaRpm;
-    for (newGear = 0; newGear < ep.nGears - 1; newGear++) {
-        double rpm = speed_mpsToRpm(speed_mps, ep.gearRatios[newGear]);
-        if (rpm >= ep.shiftingRule.rpm + delta)
+    if (tables != 0) {
+        //comparing speeds against the precomputed shifting speeds is equivalent to the loop below
+        const std::vector<double> &shiftSpeed_mps = acceleration_mps2 >= 0 ? tables->shiftSpeedAccelerating_mps : tables->shiftSpeedDecelerating_mps;
+        while (newGear < ep->nGears - 1 && speed_mps >= shiftSpeed_mps[newGear])
+            newGear++;
+        currentGear = newGear;
+        return currentGear;
+    }
+    double delta = acceleration_mps2 >= 0 ? ep->shiftingRule.deltaRpm : -ep->shiftingRule.deltaRpm;
+    for (newGear = 0; newGear < ep->nGears - 1; newGear++) {
+        double rpm = speed_mpsToRpm(speed_mps, ep->gearRatios[newGear]);
+        if (rpm >= ep->shiftingRule.rpm + delta)
             continue;
         else
             break;
@@ -170,21 +193,105 @@ uint8_t RealisticEngineModel::performGearShifting(double speed_mps, double accel
 }
 
 double RealisticEngineModel::maxEngineAcceleration_mps2(double speed_mps) {
-    double maxEngineAcceleration = speed_mpsToThrust_N(speed_mps) / ep.__maxAccelerationCoefficient;
+    double maxEngineAcceleration;
+    if (tables != 0 && tables->maxEngineAcceleration_mps2[currentGear].evaluate(speed_mps, maxEngineAcceleration))
+        return maxEngineAcceleration;
+    maxEngineAcceleration = speed_mpsToThrust_N(speed_mps) / ep->__maxAccelerationCoefficient;
     return std::min(maxEngineAcceleration, maxNoSlipAcceleration_mps2());
 }
 
+double RealisticEngineModel::maxEngineAcceleration_mps2(double speed_mps, uint8_t gear) {
+    double power_hp = rpmToPower_hp(speed_mpsToRpm(speed_mps, ep->gearRatios[gear]));
+    double maxEngineAcceleration = ep->__speedToThrustCoefficient * power_hp / speed_mps / ep->__maxAccelerationCoefficient;
+    return std::min(maxEngineAcceleration, maxNoSlipAcceleration_mps2());
+}
+
+void RealisticEngineModel::buildEngineTables(EngineTables &engineTables, double tolerance_mps2) {
+    //sample up to a bit more than the speed reached at maximum rpm with the highest gear
+    const double maxSpeed_mps = 1.1 * ep->__rpmToSpeedCoefficient * ep->maxRpm / ep->gearRatios[ep->nGears - 1];
+    double step_mps = TABLE_INITIAL_STEP_MPS;
+    while (true) {
+        double maxError = 0;
+        //the opposing force is needed from standstill
+        SampledFunction &opposing = engineTables.opposingAcceleration_mps2;
+        opposing.from_mps = 0;
+        opposing.step_mps = step_mps;
+        opposing.invStep = 1 / step_mps;
+        opposing.values.clear();
+        const int nOpposing = (int)ceil(maxSpeed_mps / step_mps) + 2;
+        for (int i = 0; i < nOpposing; i++) {
+            const double v = i * step_mps;
+            opposing.values.push_back(thrust_NToAcceleration_mps2(opposingForce_N(v)));
+            if (i > 0) {
+                const double mid = v - step_mps / 2;
+                const double interpolated = (opposing.values[opposing.values.size() - 2] + opposing.values.back()) / 2;
+                maxError = std::max(maxError, fabs(interpolated - thrust_NToAcceleration_mps2(opposingForce_N(mid))));
+            }
+        }
+        //engine acceleration is only evaluated above the minimum speed
+        engineTables.maxEngineAcceleration_mps2.resize(ep->nGears);
+        const int nEngine = (int)ceil(std::max(0., maxSpeed_mps - minSpeed_mps) / step_mps) + 2;
+        for (uint8_t gear = 0; gear < ep->nGears; gear++) {
+            SampledFunction &maxAccel = engineTables.maxEngineAcceleration_mps2[gear];
+            maxAccel.from_mps = minSpeed_mps;
+            maxAccel.step_mps = step_mps;
+            maxAccel.invStep = 1 / step_mps;
+            maxAccel.values.clear();
+            for (int i = 0; i < nEngine; i++) {
+                const double v = minSpeed_mps + i * step_mps;
+                maxAccel.values.push_back(maxEngineAcceleration_mps2(v, gear));
+                if (i > 0) {
+                    const double mid = v - step_mps / 2;
+                    const double interpolated = (maxAccel.values[maxAccel.values.size() - 2] + maxAccel.values.back()) / 2;
+                    maxError = std::max(maxError, fabs(interpolated - maxEngineAcceleration_mps2(mid, gear)));
+                }
+            }
+        }
+        if (maxError <= tolerance_mps2 || step_mps / 2 < TABLE_MIN_STEP_MPS) {
+            if (maxError > tolerance_mps2)
+                std::cerr << "Engine tables for " << ep->id << " exceed the requested tolerance: "
+                          << maxError << " > " << tolerance_mps2 << std::endl;
+            break;
+        }
+        step_mps /= 2;
+    }
+    //gear shifting rule: leave a gear as soon as its rpm reaches rpm + delta (accelerating) or rpm - delta (decelerating)
+    engineTables.shiftSpeedAccelerating_mps.resize(ep->nGears);
+    engineTables.shiftSpeedDecelerating_mps.resize(ep->nGears);
+    for (uint8_t gear = 0; gear < ep->nGears; gear++) {
+        const double coefficient = ep->__speedToRpmCoefficient * ep->gearRatios[gear];
+        engineTables.shiftSpeedAccelerating_mps[gear] = (ep->shiftingRule.rpm + ep->shiftingRule.deltaRpm) / coefficient;
+        engineTables.shiftSpeedDecelerating_mps[gear] = (ep->shiftingRule.rpm - ep->shiftingRule.deltaRpm) / coefficient;
+    }
+}
+
+void RealisticEngineModel::updateEngineTables() {
+    if (tableTolerance_mps2 <= 0) {
+        tables = 0;
+        return;
+    }
+    const std::pair<const EngineParameters*, double> key(ep, tableTolerance_mps2);
+    EngineTablesCache::const_iterator it = myEngineTablesCache.find(key);
+    if (it == myEngineTablesCache.end()) {
+        //tables are built without using themselves
+        tables = 0;
+        buildEngineTables(myEngineTablesCache[key], tableTolerance_mps2);
+        it = myEngineTablesCache.find(key);
+    }
+    tables = &it->second;
+}
+
 double RealisticEngineModel::getEngineTimeConstant_s(double rpm) {
     if (rpm <= 0) {
         return TAU_MAX;
     }
     else {
-        if (ep.fixedTauBurn)
+        if (ep->fixedTauBurn)
             //in this case, tau_burn is fixed and is within __engineTauDe_s
-            return std::min(TAU_MAX, ep.__engineTau2 / rpm + ep.__engineTauDe_s);
+            return std::min(TAU_MAX, ep->__engineTau2 / rpm + ep->__engineTauDe_s);
         else
             //in this case, tau_burn is dynamic and is within __engineTau1
-            return std::min(TAU_MAX, ep.__engineTau1 / rpm + ep.tauEx_s);
+            return std::min(TAU_MAX, ep->__engineTau1 / rpm + ep->tauEx_s);
     }
 }
 
@@ -204,12 +311,13 @@ double RealisticEngineModel::getRealAcceleration(double speed_mps, double accel_
         double engineAccel = std::min(maxEngineAcceleration_mps2(correctedSpeed), reqAccel_mps2);
         //now we need to computed delayed acceleration due to actuation lag
         double tau = getEngineTimeConstant_s(speed_mpsToRpm(correctedSpeed));
-        double alpha = ep.dt / (tau + ep.dt);
+        double alpha = ep->dt / (tau + ep->dt);
         //compute the acceleration provided by the engine, thus removing friction from current acceleration
-        double currentAccel_mps2 = accel_mps2 + thrust_NToAcceleration_mps2(opposingForce_N(speed_mps));
+        double opposingAccel_mps2 = opposingAcceleration_mps2(speed_mps);
+        double currentAccel_mps2 = accel_mps2 + opposingAccel_mps2;
         //use standard first order lag with time constant depending on engine rpm
         //add back frictions resistance as well
-        realAccel_mps2 = alpha * engineAccel + (1-alpha) * currentAccel_mps2 - thrust_NToAcceleration_mps2(opposingForce_N(speed_mps));
+        realAccel_mps2 = alpha * engineAccel + (1-alpha) * currentAccel_mps2 - opposingAccel_mps2;
     }
     else {
         realAccel_mps2 = getRealBrakingAcceleration(speed_mps, accel_mps2, reqAccel_mps2, timeStep);
@@ -236,8 +344,8 @@ double RealisticEngineModel::getRealAcceleration(double speed_mps, double accel_
         lastTimeStep = timeStep;
         char buf[1024];
         //format the message for the dashboard
-        double speedAfterAccel = std::max(speed_mps + realAccel_mps2 * ep.dt, 0.0);
-        sprintf(buf, "%f %f %d %f\r\n", speed_mpsToRpm(correctedSpeed), speed_mps*3.6, (int)currentGear+1, (speedAfterAccel - speed_mps) / ep.dt);
+        double speedAfterAccel = std::max(speed_mps + realAccel_mps2 * ep->dt, 0.0);
+        sprintf(buf, "%f %f %d %f\r\n", speed_mpsToRpm(correctedSpeed), speed_mps*3.6, (int)currentGear+1, (speedAfterAccel - speed_mps) / ep->dt);
         //send data to the dashboard
         if (write(socketfd, buf, strlen(buf)) != strlen(buf)) {
             close(socketfd);
@@ -258,13 +366,13 @@ double RealisticEngineModel::getRealBrakingAcceleration(double speed_mps, double
 
     UNUSED_PARAMETER(t);
     //compute which part of the deceleration is currently done by frictions
-    double frictionDeceleration = thrust_NToAcceleration_mps2(opposingForce_N(speed_mps));
+    double frictionDeceleration = opposingAcceleration_mps2(speed_mps);
     //remove the part of the deceleration which is due to friction
     double brakesAccel_mps2 = accel_mps2 + frictionDeceleration;
     //compute the new brakes deceleration
-    double newBrakesAccel_mps2 = ep.__brakesAlpha * std::max(-ep.__maxNoSlipAcceleration, reqAccel_mps2) + ep.__brakesOneMinusAlpha * brakesAccel_mps2;
+    double newBrakesAccel_mps2 = ep->__brakesAlpha * std::max(-ep->__maxNoSlipAcceleration, reqAccel_mps2) + ep->__brakesOneMinusAlpha * brakesAccel_mps2;
     //our brakes limit is tires friction
-    newBrakesAccel_mps2 = std::max(-ep.__maxNoSlipAcceleration, newBrakesAccel_mps2);
+    newBrakesAccel_mps2 = std::max(-ep->__maxNoSlipAcceleration, newBrakesAccel_mps2);
     //now we need to add back our friction deceleration
     return newBrakesAccel_mps2 - frictionDeceleration;
 
@@ -282,6 +390,23 @@ void RealisticEngineModel::loadParameters(const ParMap &parameters) {
 }
 
 void RealisticEngineModel::loadParameters() {
+    ep = &getEngineParameters(xmlFile, vehicleType, dt_s);
+    //compute "minimum speed" to be used when computing maximum acceleration at speeds close to 0
+    minSpeed_mps = rpmToSpeed_mps(ep->minRpm, ep->wheelDiameter_m, ep->differentialRatio, ep->gearRatios[0]);
+    updateEngineTables();
+}
+
+const EngineParameters &RealisticEngineModel::getDefaultParameters() {
+    static const EngineParameters defaultParameters;
+    return defaultParameters;
+}
+
+const EngineParameters &RealisticEngineModel::getEngineParameters(const std::string &xmlFile, const std::string &vehicleType, double dt_s) {
+    const EngineParametersKey key(xmlFile, vehicleType, dt_s);
+    EngineParametersCache::const_iterator it = myEngineParametersCache.find(key);
+    if (it != myEngineParametersCache.end()) {
+        return it->second;
+    }
     //initialize xerces library
     XERCES_CPP_NAMESPACE::XMLPlatformUtils::Initialize();
     //create our xml reader
@@ -296,15 +421,15 @@ void RealisticEngineModel::loadParameters() {
     VehicleEngineHandler *engineHandler = new VehicleEngineHandler(vehicleType);
     reader->setContentHandler(engineHandler);
     reader->setErrorHandler(engineHandler);
+    EngineParameters *loaded = 0;
     try {
         //parse the document. if any error is present in the xml file, the simulation will be closed
         reader->parse(xmlFile.c_str());
-        //copy loaded parameters into our engine parameters
-        ep = engineHandler->getEngineParameters();
-        ep.dt = dt_s;
-        ep.computeCoefficients();
-        //compute "minimum speed" to be used when computing maximum acceleration at speeds close to 0
-        minSpeed_mps = rpmToSpeed_mps(ep.minRpm, ep.wheelDiameter_m, ep.differentialRatio, ep.gearRatios[0]);
+        //copy loaded parameters into the cache and precompute the coefficients once
+        loaded = &myEngineParametersCache[key];
+        *loaded = engineHandler->getEngineParameters();
+        loaded->dt = dt_s;
+        loaded->computeCoefficients();
     }
     catch (XERCES_CPP_NAMESPACE::SAXException &e) {
         std::cerr << "Error while parsing " << xmlFile << ": Does the file exist?" << std::endl;
@@ -314,6 +439,7 @@ void RealisticEngineModel::loadParameters() {
     //delete handler and reader
     delete engineHandler;
     delete reader;
+    return *loaded;
 }
 
 void RealisticEngineModel::setParameter(const std::string parameter, const std::string &value) {
@@ -328,6 +454,10 @@ void RealisticEngineModel::setParameter(const std::string parameter, const std::
 void RealisticEngineModel::setParameter(const std::string parameter, double value) {
     if (parameter == ENGINE_PAR_DT)
         dt_s = value;
+    if (parameter == ENGINE_PAR_TABLE_TOLERANCE) {
+        tableTolerance_mps2 = value;
+        updateEngineTables();
+    }
 }
 void RealisticEngineModel::setParameter(const std::string parameter, int value) {
     UNUSED_PARAMETER(parameter);
@@ -21,6 +21,9 @@
 #include "GenericEngineModel.h"
 
 #include <stdint.h>
+#include <map>
+#include <tuple>
+#include <vector>
 
 #include "VehicleEngineHandler.h"
 #include "EngineParameters.h"
@@ -53,7 +56,55 @@ class RealisticEngineModel : public GenericEngineModel {
 
 protected:
 
-    EngineParameters ep;
+    /**
+     * A function of speed sampled at equally spaced points and evaluated by
+     * linear interpolation
+     */
+    struct SampledFunction {
+        //speed of the first sample in meters per second
+        double from_mps;
+        //distance between two samples in meters per second and its inverse
+        double step_mps, invStep;
+        //the samples
+        std::vector<double> values;
+
+        /**
+         * Interpolates the function at the given speed
+         *
+         * @param[in] speed_mps speed in meters per second
+         * @param[out] value the interpolated value
+         * @return false if the speed is outside the sampled range
+         */
+        bool evaluate(double speed_mps, double &value) const {
+            const double x = (speed_mps - from_mps) * invStep;
+            const int i = (int)x;
+            if (x < 0 || i + 1 >= (int)values.size())
+                return false;
+            const double frac = x - i;
+            value = values[i] + frac * (values[i + 1] - values[i]);
+            return true;
+        }
+    };
+
+    /**
+     * Precomputed quantities of an engine, shared by all the vehicles using
+     * the same engine and accuracy
+     */
+    struct EngineTables {
+        //acceleration due to air drag, rolling resistance, and gravity
+        SampledFunction opposingAcceleration_mps2;
+        //maximum engine acceleration, one function per gear
+        std::vector<SampledFunction> maxEngineAcceleration_mps2;
+        //speed at which to leave each gear when accelerating and when decelerating
+        std::vector<double> shiftSpeedAccelerating_mps, shiftSpeedDecelerating_mps;
+    };
+
+    //engine parameters, shared among all vehicles using the same engine
+    const EngineParameters *ep;
+    //tabulated engine quantities, or 0 if the analytical model is used
+    const EngineTables *tables;
+    //maximum interpolation error for tabulated engine quantities (0 disables tables)
+    double tableTolerance_mps2;
     //current gear
     uint8_t currentGear;
     //minimum speed to be considered for horsepower computation
@@ -314,6 +365,38 @@ protected:
      */
     double maxEngineAcceleration_mps2(double speed_mps);
 
+    /**
+     * Computes maximum vehicle acceleration for a given gear analytically
+     *
+     * @param[in] speed_mps current speed in meters per second
+     * @param[in] gear the gear (0 based)
+     * @return the maximum engine acceleration at the wheel
+     */
+    double maxEngineAcceleration_mps2(double speed_mps, uint8_t gear);
+
+    /**
+     * Computes the deceleration due to opposing forces, i.e., air drag,
+     * rolling resistance, and gravity
+     *
+     * @param[in] speed_mps speed in meters per second
+     * @return the opposing force divided by the vehicle mass in meters per squared second
+     */
+    double opposingAcceleration_mps2(double speed_mps);
+
+    /**
+     * Samples the engine quantities with a step small enough to stay within
+     * the given tolerance, as checked at the midpoints between samples
+     *
+     * @param[out] engineTables the tables to fill
+     * @param[in] tolerance_mps2 maximum interpolation error in meters per squared second
+     */
+    void buildEngineTables(EngineTables &engineTables, double tolerance_mps2);
+
+    /**
+     * Fetches the tables for the current engine and tolerance, building them if needed
+     */
+    void updateEngineTables();
+
     /**
      * Computes real vehicle deceleration
      *
@@ -353,7 +436,8 @@ public:
     virtual void loadParameters(const ParMap &parameters);
 
     /**
-     * Load parameters from xml file
+     * Load parameters from xml file. The file is only parsed the first time a
+     * given engine is requested, afterwards the cached parameters are used
      */
     void loadParameters();
 
@@ -376,6 +460,35 @@ public:
      */
     void getEngineData(double speed_mps, uint8_t &gear, double &rpm);
 
+private:
+    //identifies an engine as loaded from file: xml file, vehicle id, and sampling time
+    typedef std::tuple<std::string, std::string, double> EngineParametersKey;
+    typedef std::map<EngineParametersKey, EngineParameters> EngineParametersCache;
+
+    //process-wide cache of the engines loaded so far. entries are never modified after
+    //insertion so vehicles can keep a pointer to them
+    static EngineParametersCache myEngineParametersCache;
+
+    //process-wide cache of the tables built so far, per engine and tolerance
+    typedef std::map<std::pair<const EngineParameters*, double>, EngineTables> EngineTablesCache;
+    static EngineTablesCache myEngineTablesCache;
+
+    /**
+     * Returns the default parameters used before an engine is loaded from file
+     */
+    static const EngineParameters &getDefaultParameters();
+
+    /**
+     * Returns the parameters for the given engine, parsing the xml file on
+     * the first request and taking them from the cache afterwards
+     *
+     * @param[in] xmlFile xml file with engine parameters
+     * @param[in] vehicleType id of the vehicle parameters to load
+     * @param[in] dt_s simulation sampling time
+     * @return the shared engine parameters with precomputed coefficients
+     */
+    static const EngineParameters &getEngineParameters(const std::string &xmlFile, const std::string &vehicleType, double dt_s);
+
 #ifdef EE
 private:
     //some things for the easter egg :)
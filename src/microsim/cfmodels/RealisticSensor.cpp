@@ -39,18 +39,25 @@ bool RealisticSensor::isValueOutOfRange(double value) const {
 
 double RealisticSensor::getReading(double value, double currentTime) {
 
+    // Ideal sensors measure the exact value, no need for random numbers and rounding
+    if (isIdeal()) {
+        if (value < minValue) {
+            return minValue;
+        }
+        if (value > maxValue) {
+            return maxValue;
+        }
+        cachedTime = currentTime;
+        cachedValue = value;
+        return value;
+    }
+
     // Return the cached value if the updateInterval has not yet passed
     if (currentTime < cachedTime + updateInterval) {
         return cachedValue;
     }
 
-    // Compute the error interval associated to the sensor
-    double relativeError = value * (percentageError / 100);
-    double error = sumErrors ? (absoluteError + relativeError) : std::max(absoluteError, relativeError);
-
-    // Draw a random measurement from the computed interval
-    std::uniform_real_distribution<> extractMeasurement(value - error, value + error);
-    double measurement = error > 0 ? extractMeasurement(generator) : value;
+    double measurement = drawMeasurement(value);
 
     if (measurement < minValue) {
         return minValue;
@@ -60,12 +67,36 @@ double RealisticSensor::getReading(double value, double currentTime) {
     }
 
     cachedTime = currentTime;
+    cachedValue = round(measurement);
 
+    return cachedValue;
+}
+
+double RealisticSensor::getInstantReading(double value) {
+    const double measurement = isIdeal() ? value : drawMeasurement(value);
+    if (measurement < minValue) {
+        return minValue;
+    }
+    if (measurement > maxValue) {
+        return maxValue;
+    }
+    return isIdeal() ? measurement : round(measurement);
+}
+
+double RealisticSensor::drawMeasurement(double value) {
+    // Compute the error interval associated to the sensor
+    double relativeError = value * (percentageError / 100);
+    double error = sumErrors ? (absoluteError + relativeError) : std::max(absoluteError, relativeError);
+
+    // Draw a random measurement from the computed interval
+    std::uniform_real_distribution<> extractMeasurement(value - error, value + error);
+    return error > 0 ? extractMeasurement(generator) : value;
+}
+
+double RealisticSensor::round(double measurement) const {
     // Round the measurement depending on the specified precision
     double factor = std::pow(10, decimalDigits);
-    cachedValue = std::round(measurement * factor) / factor;
-
-    return cachedValue;
+    return std::round(measurement * factor) / factor;
 }
 
 double RealisticSensor::getReading(double value, double currentTime, double& samplingTime) {
@@ -17,6 +17,7 @@
 #ifndef REALISTICSENSOR_H_
 #define REALISTICSENSOR_H_
 
+#include <limits>
 #include <random>
 
 /// @brief A class used to represent a realistic sensor
@@ -30,9 +31,19 @@ public:
     ~RealisticSensor() = default;
 
     bool isValueOutOfRange(double value) const;
+
+    /// @brief whether the sensor returns the exact value, i.e., has no errors, no update interval, and full precision
+    bool isIdeal() const {
+        return absoluteError == 0 && percentageError == 0 && updateInterval <= 0 &&
+               decimalDigits >= std::numeric_limits<double>::digits10;
+    }
+
     double getReading(double value, double currentTime);
     double getReading(double value, double currentTime, double& samplingTime);
 
+    /// @brief measures the given value without using or updating the cached measurement (e.g. for values of other vehicles)
+    double getInstantReading(double value);
+
     void setSeed(int seed);
 
 public:
@@ -52,6 +63,13 @@ public:
     /// @brief whether absolute and relative errors are summed or only the highest one is applied
     bool sumErrors;
 
+protected:
+    /// @brief draws a measurement from the error interval around the given value
+    double drawMeasurement(double value);
+
+    /// @brief rounds the measurement depending on the specified precision
+    double round(double measurement) const;
+
 protected:
     std::mt19937 generator;
 
@@ -26,6 +26,7 @@
 #include <config.h>
 #endif
 
+#include <algorithm>
 #include <utils/common/MsgHandler.h>
 #include <utils/options/OptionsCont.h>
 #include <utils/iodevices/OutputDevice.h>
@@ -33,6 +34,7 @@
 #include <utils/geom/Position.h>
 #include <utils/geom/GeomHelper.h>
 #include <microsim/MSNet.h>
+#include <microsim/MSGlobals.h>
 #include <microsim/MSLane.h>
 #include <microsim/MSEdge.h>
 #include <microsim/MSVehicle.h>
@@ -82,10 +84,10 @@ MSDevice_BTreceiver::buildVehicleDevices(SUMOVehicle& v, std::vector<MSDevice*>&
         MSDevice_BTreceiver* device = new MSDevice_BTreceiver(v, "btreceiver_" + v.getID());
         into.push_back(device);
         if (!myWasInitialised) {
-            new BTreceiverUpdate();
             myWasInitialised = true;
             myRange = oc.getFloat("device.btreceiver.range");
             myOffTime = oc.getFloat("device.btreceiver.offtime");
+            new BTreceiverUpdate();
             sRecognitionRNG.seed(oc.getInt("seed"));
         }
     }
@@ -95,8 +97,16 @@ MSDevice_BTreceiver::buildVehicleDevices(SUMOVehicle& v, std::vector<MSDevice*>&
 // ---------------------------------------------------------------------------
 // MSDevice_BTreceiver::BTreceiverUpdate-methods
 // ---------------------------------------------------------------------------
-MSDevice_BTreceiver::BTreceiverUpdate::BTreceiverUpdate() {
+MSDevice_BTreceiver::BTreceiverUpdate::BTreceiverUpdate()
+    : myCellSize(MAX2(myRange, 10.)) {
     MSNet::getInstance()->getEndOfTimestepEvents()->addEvent(this);
+#ifdef HAVE_FOX
+    if (MSGlobals::gNumSimThreads > 1) {
+        while (myThreadPool.size() < MSGlobals::gNumSimThreads) {
+            new FXWorkerThread(myThreadPool);
+        }
+    }
+#endif
 }
 
 
@@ -115,40 +125,41 @@ MSDevice_BTreceiver::BTreceiverUpdate::~BTreceiverUpdate() {
 
 SUMOTime
 MSDevice_BTreceiver::BTreceiverUpdate::execute(SUMOTime /*currentTime*/) {
-    // build rtree with senders
-    NamedRTree rt;
-    for (std::map<std::string, MSDevice_BTsender::VehicleInformation*>::const_iterator i = MSDevice_BTsender::sVehicles.begin(); i != MSDevice_BTsender::sVehicles.end(); ++i) {
-        MSDevice_BTsender::VehicleInformation* vi = (*i).second;
-        Boundary b = vi->getBoxBoundary();
-        b.grow(POSITION_EPS);
-        const float cmin[2] = {(float) b.xmin(), (float) b.ymin()};
-        const float cmax[2] = {(float) b.xmax(), (float) b.ymax()};
-        rt.Insert(cmin, cmax, vi);
+    updateSenderGrid();
+
+    // collect the senders to check for all receivers (in parallel if possible)
+    myReceivers.clear();
+    for (std::map<std::string, MSDevice_BTreceiver::VehicleInformation*>::const_iterator i = MSDevice_BTreceiver::sVehicles.begin(); i != MSDevice_BTreceiver::sVehicles.end(); ++i) {
+        myReceivers.push_back((*i).second);
+    }
+#ifdef HAVE_FOX
+    if (myThreadPool.size() > 0 && myReceivers.size() > 1) {
+        const int chunkSize = MAX2(1, (int)myReceivers.size() / (4 * myThreadPool.size()));
+        for (std::vector<VehicleInformation*>::const_iterator i = myReceivers.begin(); i != myReceivers.end();) {
+            std::vector<VehicleInformation*>::const_iterator end = i + MIN2(chunkSize, (int)(myReceivers.end() - i));
+            myThreadPool.add(new CollectTask(*this, i, end));
+            i = end;
+        }
+        myThreadPool.waitAll();
+    } else {
+#endif
+        for (std::vector<VehicleInformation*>::const_iterator i = myReceivers.begin(); i != myReceivers.end(); ++i) {
+            collectEncounters(**i);
+        }
+#ifdef HAVE_FOX
     }
+#endif
 
-    // check visibility for all receivers
+    // check visibility for all receivers (sequentially to keep the random numbers in order)
     OptionsCont& oc = OptionsCont::getOptions();
     bool allRecognitions = oc.getBool("device.btreceiver.all-recognitions");
     bool haveOutput = oc.isSet("bt-output");
     for (std::map<std::string, MSDevice_BTreceiver::VehicleInformation*>::iterator i = MSDevice_BTreceiver::sVehicles.begin(); i != MSDevice_BTreceiver::sVehicles.end();) {
-        // collect surrounding vehicles
         MSDevice_BTreceiver::VehicleInformation* vi = (*i).second;
-        Boundary b = vi->getBoxBoundary();
-        b.grow(vi->range);
-        const float cmin[2] = {(float) b.xmin(), (float) b.ymin()};
-        const float cmax[2] = {(float) b.xmax(), (float) b.ymax()};
-        std::set<std::string> surroundingVehicles;
-        Named::StoringVisitor sv(surroundingVehicles);
-        rt.Search(cmin, cmax, sv);
-
-        // loop over surrounding vehicles, check visibility status
-        for (std::set<std::string>::const_iterator j = surroundingVehicles.begin(); j != surroundingVehicles.end(); ++j) {
-            if ((*i).first == *j) {
-                // seeing oneself? skip
-                continue;
-            }
-            updateVisibility(*vi, *MSDevice_BTsender::sVehicles.find(*j)->second);
+        for (std::vector<std::pair<MSDevice_BTsender::VehicleInformation*, std::vector<double> > >::const_iterator j = vi->encounters.begin(); j != vi->encounters.end(); ++j) {
+            updateVisibility(*vi, *j->first, j->second);
         }
+        vi->encounters.clear();
 
         if (vi->haveArrived) {
             // vehicle has left the simulation; remove
@@ -168,6 +179,7 @@ MSDevice_BTreceiver::BTreceiverUpdate::execute(SUMOTime /*currentTime*/) {
     for (std::map<std::string, MSDevice_BTsender::VehicleInformation*>::iterator i = MSDevice_BTsender::sVehicles.begin(); i != MSDevice_BTsender::sVehicles.end();) {
         MSDevice_BTsender::VehicleInformation* vi = (*i).second;
         if (vi->haveArrived) {
+            removeFromGrid(vi);
             delete vi;
             MSDevice_BTsender::sVehicles.erase(i++);
         } else {
@@ -179,9 +191,111 @@ MSDevice_BTreceiver::BTreceiverUpdate::execute(SUMOTime /*currentTime*/) {
 }
 
 
+void
+MSDevice_BTreceiver::BTreceiverUpdate::updateSenderGrid() {
+    for (std::map<std::string, MSDevice_BTsender::VehicleInformation*>::const_iterator i = MSDevice_BTsender::sVehicles.begin(); i != MSDevice_BTsender::sVehicles.end(); ++i) {
+        MSDevice_BTsender::VehicleInformation* const vi = (*i).second;
+        vi->gridBoundary = vi->getBoxBoundary();
+        vi->gridBoundary.grow(POSITION_EPS);
+        const int xmin = getCell(vi->gridBoundary.xmin());
+        const int ymin = getCell(vi->gridBoundary.ymin());
+        const int xmax = getCell(vi->gridBoundary.xmax());
+        const int ymax = getCell(vi->gridBoundary.ymax());
+        if (xmin == vi->cellXMin && ymin == vi->cellYMin && xmax == vi->cellXMax && ymax == vi->cellYMax) {
+            continue;
+        }
+        removeFromGrid(vi);
+        for (int x = xmin; x <= xmax; ++x) {
+            for (int y = ymin; y <= ymax; ++y) {
+                mySenderGrid[getCellKey(x, y)].push_back(vi);
+            }
+        }
+        vi->cellXMin = xmin;
+        vi->cellYMin = ymin;
+        vi->cellXMax = xmax;
+        vi->cellYMax = ymax;
+    }
+}
+
+
+void
+MSDevice_BTreceiver::BTreceiverUpdate::removeFromGrid(MSDevice_BTsender::VehicleInformation* sender) {
+    for (int x = sender->cellXMin; x <= sender->cellXMax; ++x) {
+        for (int y = sender->cellYMin; y <= sender->cellYMax; ++y) {
+            std::vector<MSDevice_BTsender::VehicleInformation*>& cell = mySenderGrid[getCellKey(x, y)];
+            std::vector<MSDevice_BTsender::VehicleInformation*>::iterator it = std::find(cell.begin(), cell.end(), sender);
+            if (it != cell.end()) {
+                *it = cell.back();
+                cell.pop_back();
+            }
+        }
+    }
+    sender->cellXMin = 0;
+    sender->cellYMin = 0;
+    sender->cellXMax = -1;
+    sender->cellYMax = -1;
+}
+
+
+void
+MSDevice_BTreceiver::BTreceiverUpdate::collectEncounters(VehicleInformation& receiver) const {
+    std::vector<std::pair<MSDevice_BTsender::VehicleInformation*, std::vector<double> > >& encounters = receiver.encounters;
+    encounters.clear();
+    Boundary b = receiver.getBoxBoundary();
+    b.grow(receiver.range);
+    const int xmax = getCell(b.xmax());
+    const int ymax = getCell(b.ymax());
+    for (int x = getCell(b.xmin()); x <= xmax; ++x) {
+        for (int y = getCell(b.ymin()); y <= ymax; ++y) {
+            std::unordered_map<long long int, std::vector<MSDevice_BTsender::VehicleInformation*> >::const_iterator cell = mySenderGrid.find(getCellKey(x, y));
+            if (cell == mySenderGrid.end()) {
+                continue;
+            }
+            for (std::vector<MSDevice_BTsender::VehicleInformation*>::const_iterator j = cell->second.begin(); j != cell->second.end(); ++j) {
+                const Boundary& sb = (*j)->gridBoundary;
+                if (sb.xmin() <= b.xmax() && sb.xmax() >= b.xmin() && sb.ymin() <= b.ymax() && sb.ymax() >= b.ymin()
+                        && (*j)->getID() != receiver.getID()) {
+                    encounters.push_back(std::make_pair(*j, std::vector<double>()));
+                }
+            }
+        }
+    }
+    // senders spanning several cells are found more than once
+    std::sort(encounters.begin(), encounters.end(), [](const std::pair<MSDevice_BTsender::VehicleInformation*, std::vector<double> >& a,
+    const std::pair<MSDevice_BTsender::VehicleInformation*, std::vector<double> >& b) {
+        return a.first->getID() < b.first->getID();
+    });
+    encounters.erase(std::unique(encounters.begin(), encounters.end(), [](const std::pair<MSDevice_BTsender::VehicleInformation*, std::vector<double> >& a,
+    const std::pair<MSDevice_BTsender::VehicleInformation*, std::vector<double> >& b) {
+        return a.first == b.first;
+    }), encounters.end());
+
+    // compute the range crossings and skip the senders which stay out of range
+    const MSDevice_BTsender::VehicleState& receiverData = receiver.updates.back();
+    const Position& oldReceiverPosition = receiver.updates.front().position;
+    const Position receiverDelta = receiverData.position - oldReceiverPosition;
+    std::vector<std::pair<MSDevice_BTsender::VehicleInformation*, std::vector<double> > >::iterator write = encounters.begin();
+    for (std::vector<std::pair<MSDevice_BTsender::VehicleInformation*, std::vector<double> > >::iterator j = encounters.begin(); j != encounters.end(); ++j) {
+        const MSDevice_BTsender::VehicleInformation& sender = *j->first;
+        const MSDevice_BTsender::VehicleState& senderData = sender.updates.back();
+        GeomHelper::findLineCircleIntersections(oldReceiverPosition, receiver.range, sender.updates.front().position,
+                                                senderData.position - receiverDelta, j->second);
+        if (j->second.empty() && receiver.currentlySeen.find(sender.getID()) == receiver.currentlySeen.end()
+                && !(receiver.amOnNet && sender.amOnNet && receiverData.position.distanceTo(senderData.position) < receiver.range)) {
+            continue;
+        }
+        if (write != j) {
+            *write = std::move(*j);
+        }
+        ++write;
+    }
+    encounters.erase(write, encounters.end());
+}
+
+
 void
 MSDevice_BTreceiver::BTreceiverUpdate::updateVisibility(MSDevice_BTreceiver::VehicleInformation& receiver,
-        MSDevice_BTsender::VehicleInformation& sender) {
+        MSDevice_BTsender::VehicleInformation& sender, const std::vector<double>& intersections) {
     const MSDevice_BTsender::VehicleState& receiverData = receiver.updates.back();
     const MSDevice_BTsender::VehicleState& senderData = sender.updates.back();
     if (!receiver.amOnNet || !sender.amOnNet) {
@@ -193,14 +307,9 @@ MSDevice_BTreceiver::BTreceiverUpdate::updateVisibility(MSDevice_BTreceiver::Veh
 
     const Position& oldReceiverPosition = receiver.updates.front().position;
     const Position& oldSenderPosition = sender.updates.front().position;
-
-    // let the other's current position be the one obtained by applying the relative direction vector to the initial position
     const Position senderDelta = senderData.position - oldSenderPosition;
     const Position receiverDelta = receiverData.position - oldReceiverPosition;
-    const Position translatedSender = senderData.position - receiverDelta;
-    // find crossing points
-    std::vector<double> intersections;
-    GeomHelper::findLineCircleIntersections(oldReceiverPosition, receiver.range, oldSenderPosition, translatedSender, intersections);
+    // the crossing points were computed in collectEncounters
     switch (intersections.size()) {
         case 0:
             // no intersections -> other vehicle either stays within or beyond range
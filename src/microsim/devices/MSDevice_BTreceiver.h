@@ -28,12 +28,17 @@
 #include <config.h>
 #endif
 
+#include <cmath>
 #include <random>
+#include <unordered_map>
 #include "MSDevice.h"
 #include "MSDevice_BTsender.h"
 #include <utils/common/SUMOTime.h>
 #include <utils/common/Command.h>
 #include <utils/common/RandHelper.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXWorkerThread.h>
+#endif
 
 
 // ===========================================================================
@@ -278,6 +283,9 @@ private:
         /// @brief The past episodes of removed vehicle
         std::map<std::string, std::vector<SeenDevice*> > seen;
 
+        /// @brief The senders to check in the current step (sorted by id) with the range crossings
+        std::vector<std::pair<MSDevice_BTsender::VehicleInformation*, std::vector<double> > > encounters;
+
     private:
         /// @brief Invalidated copy constructor.
         VehicleInformation(const VehicleInformation&);
@@ -307,11 +315,24 @@ private:
         SUMOTime execute(SUMOTime currentTime);
 
 
+        /** @brief Collects the senders which may change their visibility state for the given receiver
+         *
+         * Fills the receiver's encounters with the senders from the grid which are near
+         *  (sorted by id) together with the range crossings of their relative movement.
+         *  Senders which neither cross the range nor are or were seen are skipped.
+         *  Only reads the shared state, so it may run for several receivers in parallel.
+         * @param[in] receiver Definition of the receiver vehicle
+         */
+        void collectEncounters(VehicleInformation& receiver) const;
+
+
         /** @brief Rechecks the visibility for a given receiver/sender pair
          * @param[in] receiver Definition of the receiver vehicle
          * @param[in] sender Definition of the sender vehicle
+         * @param[in] intersections The relative offsets in the step where the sender crosses the receiver's range
          */
-        void updateVisibility(VehicleInformation& receiver, MSDevice_BTsender::VehicleInformation& sender);
+        void updateVisibility(VehicleInformation& receiver, MSDevice_BTsender::VehicleInformation& sender,
+                              const std::vector<double>& intersections);
 
 
         /** @brief Informs the receiver about a sender entering it's radius
@@ -359,8 +380,61 @@ private:
         void writeOutput(const std::string& id, const std::map<std::string, std::vector<SeenDevice*> >& seen,
                          bool allRecognitions);
 
+    private:
+        /// @brief Moves the senders to the grid cells of their current positions
+        void updateSenderGrid();
+
+        /// @brief Removes the sender from the grid cells it is stored in
+        void removeFromGrid(MSDevice_BTsender::VehicleInformation* sender);
 
+        /// @brief Returns the grid coordinate for the given position coordinate
+        int getCell(const double coord) const {
+            return (int)floor(coord / myCellSize);
+        }
+
+        /// @brief Returns the key of the grid cell with the given coordinates
+        static long long int getCellKey(const int x, const int y) {
+            return ((long long int)x << 32) ^ (long long int)(unsigned int)y;
+        }
 
+#ifdef HAVE_FOX
+        /**
+         * @class CollectTask
+         * @brief The task for collecting the encounters of a range of receivers in a worker thread
+         */
+        class CollectTask : public FXWorkerThread::Task {
+        public:
+            CollectTask(const BTreceiverUpdate& update, const std::vector<VehicleInformation*>::const_iterator begin,
+                        const std::vector<VehicleInformation*>::const_iterator end)
+                : myUpdate(update), myBegin(begin), myEnd(end) {}
+            void run(FXWorkerThread* /*context*/) {
+                for (std::vector<VehicleInformation*>::const_iterator i = myBegin; i != myEnd; ++i) {
+                    myUpdate.collectEncounters(**i);
+                }
+            }
+        private:
+            const BTreceiverUpdate& myUpdate;
+            const std::vector<VehicleInformation*>::const_iterator myBegin, myEnd;
+        private:
+            /// @brief Invalidated assignment operator.
+            CollectTask& operator=(const CollectTask&) = delete;
+        };
+#endif
+
+    private:
+        /// @brief The edge length of the (quadratic) grid cells
+        const double myCellSize;
+
+        /// @brief The senders stored by the cells their last step's positions touch
+        std::unordered_map<long long int, std::vector<MSDevice_BTsender::VehicleInformation*> > mySenderGrid;
+
+        /// @brief The receivers of the current step (reused)
+        std::vector<VehicleInformation*> myReceivers;
+
+#ifdef HAVE_FOX
+        /// @brief The pool for collecting the encounters in parallel
+        FXWorkerThread::Pool myThreadPool;
+#endif
 
     };
 
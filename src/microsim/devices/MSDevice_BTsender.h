@@ -177,7 +177,8 @@ public:
         /** @brief Constructor
          * @param[in] id The id of the vehicle
          */
-        VehicleInformation(const std::string& id) : Named(id), amOnNet(true), haveArrived(false)  {}
+        VehicleInformation(const std::string& id) : Named(id), amOnNet(true), haveArrived(false),
+            cellXMin(0), cellYMin(0), cellXMax(-1), cellYMax(-1) {}
 
         /// @brief Destructor
         virtual ~VehicleInformation() {}
@@ -205,6 +206,12 @@ public:
         /// @brief List of edges travelled
         ConstMSEdgeVector route;
 
+        /// @brief The boundary of the last step's positions as stored in the receivers' sender grid
+        Boundary gridBoundary;
+
+        /// @brief The range of grid cells the vehicle is stored in (empty if not stored yet)
+        int cellXMin, cellYMin, cellXMax, cellYMax;
+
     };
 
 
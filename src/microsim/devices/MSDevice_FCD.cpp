@@ -44,6 +44,9 @@
 // ---------------------------------------------------------------------------
 // static initialisation methods
 // ---------------------------------------------------------------------------
+std::map<std::string, SUMOVehicle*> MSDevice_FCD::myEquippedVehicles;
+
+
 void
 MSDevice_FCD::insertOptions(OptionsCont& oc) {
     oc.addOptionSubTopic("FCD Device");
@@ -57,7 +60,7 @@ MSDevice_FCD::insertOptions(OptionsCont& oc) {
 void
 MSDevice_FCD::buildVehicleDevices(SUMOVehicle& v, std::vector<MSDevice*>& into) {
     OptionsCont& oc = OptionsCont::getOptions();
-    if (equippedByDefaultAssignmentOptions(oc, "fcd", v, oc.isSet("fcd-output"))) {
+    if (equippedByDefaultAssignmentOptions(oc, "fcd", v, oc.isSet("fcd-output") || oc.isSet("fcd-output.columnar"))) {
         MSDevice_FCD* device = new MSDevice_FCD(v, "fcd_" + v.getID());
         into.push_back(device);
     }
@@ -69,10 +72,12 @@ MSDevice_FCD::buildVehicleDevices(SUMOVehicle& v, std::vector<MSDevice*>& into)
 // ---------------------------------------------------------------------------
 MSDevice_FCD::MSDevice_FCD(SUMOVehicle& holder, const std::string& id) :
     MSDevice(holder, id) {
+    myEquippedVehicles[holder.getID()] = &holder;
 }
 
 
 MSDevice_FCD::~MSDevice_FCD() {
+    myEquippedVehicles.erase(myHolder.getID());
 }
 
 
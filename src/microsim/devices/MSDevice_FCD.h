@@ -69,6 +69,11 @@ public:
      */
     static void buildVehicleDevices(SUMOVehicle& v, std::vector<MSDevice*>& into);
 
+    /// @brief Returns the vehicles holding a fcd device (sorted by id like the vehicle control)
+    static const std::map<std::string, SUMOVehicle*>& getEquippedVehicles() {
+        return myEquippedVehicles;
+    }
+
 public:
     /// @brief Destructor.
     ~MSDevice_FCD();
@@ -97,6 +102,9 @@ private:
 
 
 
+    /// @brief The vehicles holding a fcd device
+    static std::map<std::string, SUMOVehicle*> myEquippedVehicles;
+
 private:
     /// @brief Invalidated copy constructor.
     MSDevice_FCD(const MSDevice_FCD&);
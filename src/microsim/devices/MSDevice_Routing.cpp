@@ -63,7 +63,8 @@ SUMOAbstractRouter<MSEdge, SUMOVehicle>* MSDevice_Routing::myRouter = 0;
 AStarRouter<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> >* MSDevice_Routing::myRouterWithProhibited = 0;
 double MSDevice_Routing::myRandomizeWeightsFactor = 0;
 #ifdef HAVE_FOX
-FXWorkerThread::Pool MSDevice_Routing::myThreadPool;
+// routing tasks differ a lot in their costs, so idle threads help the busy ones
+FXWorkerThread::Pool MSDevice_Routing::myThreadPool(0, true);
 #endif
 
 
@@ -108,6 +109,9 @@ MSDevice_Routing::insertOptions(OptionsCont& oc) {
     oc.doRegister("device.rerouting.threads", new Option_Integer(0));
     oc.addDescription("device.rerouting.threads", "Routing", "The number of parallel execution threads used for rerouting");
 
+    oc.doRegister("device.rerouting.ch-customize", new Option_Bool(false));
+    oc.addDescription("device.rerouting.ch-customize", "Routing", "Keep the contraction order of routing-algorithm CH and only update its weights on adaptation");
+
     oc.doRegister("device.rerouting.output", new Option_FileName());
     oc.addDescription("device.rerouting.output", "Routing", "Save adapting weights to FILE");
 
@@ -365,7 +369,7 @@ MSDevice_Routing::reroute(const SUMOTime currentTime, const bool onInit) {
     }
     myLastRouting = currentTime;
 #ifdef HAVE_FOX
-    const bool needThread = (myRouter == 0 && myThreadPool.isFull());
+    const bool needThread = (myRouter == 0 && myThreadPool.size() == 0);
 #else
     const bool needThread = true;
 #endif
@@ -419,10 +423,10 @@ MSDevice_Routing::reroute(const SUMOTime currentTime, const bool onInit) {
             const SUMOTime weightPeriod = myAdaptationInterval > 0 ? myAdaptationInterval : std::numeric_limits<int>::max();
             if (mayHaveRestrictions) {
                 myRouter = new CHRouter<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> >(
-                    MSEdge::getAllEdges(), true, &MSDevice_Routing::getEffort, myHolder.getVClass(), weightPeriod, true);
+                    MSEdge::getAllEdges(), true, &MSDevice_Routing::getEffort, myHolder.getVClass(), weightPeriod, true, oc.getBool("device.rerouting.ch-customize"));
             } else {
                 myRouter = new CHRouter<MSEdge, SUMOVehicle, noProhibitions<MSEdge, SUMOVehicle> >(
-                    MSEdge::getAllEdges(), true, &MSDevice_Routing::getEffort, myHolder.getVClass(), weightPeriod, false);
+                    MSEdge::getAllEdges(), true, &MSDevice_Routing::getEffort, myHolder.getVClass(), weightPeriod, false, oc.getBool("device.rerouting.ch-customize"));
             }
         } else if (routingAlgorithm == "CHWrapper") {
             const SUMOTime weightPeriod = myAdaptationInterval > 0 ? myAdaptationInterval : std::numeric_limits<int>::max();
@@ -436,10 +440,13 @@ MSDevice_Routing::reroute(const SUMOTime currentTime, const bool onInit) {
 #ifdef HAVE_FOX
     if (needThread) {
         const int numThreads = OptionsCont::getOptions().getInt("device.rerouting.threads");
-        if (myThreadPool.size() < numThreads) {
+        if (numThreads > 0) {
+            // all workers are created before the first task is added since
+            // the pool must not grow while idle workers are stealing tasks
+            for (int i = 1; i < numThreads; i++) {
+                new WorkerThread(myThreadPool, myRouter->clone());
+            }
             new WorkerThread(myThreadPool, myRouter);
-        }
-        if (myThreadPool.size() < numThreads) {
             myRouter = 0;
         }
     }
@@ -38,6 +38,7 @@
 #include <utils/iodevices/OutputDevice.h>
 #include <utils/vehicle/SUMOVehicle.h>
 #include <microsim/MSNet.h>
+#include <microsim/MSGlobals.h>
 #include <microsim/MSJunction.h>
 #include <microsim/MSLane.h>
 #include <microsim/MSEdge.h>
@@ -169,6 +170,16 @@ std::set<MSDevice*>* MSDevice_SSM::instances = new std::set<MSDevice*>();
 
 std::set<std::string> MSDevice_SSM::createdOutputFiles;
 
+std::vector<std::vector<MSDevice_SSM::LaneOccupant> > MSDevice_SSM::myLaneOccupancy;
+
+std::vector<const MSLane*> MSDevice_SSM::myScannedLanes;
+
+std::vector<bool> MSDevice_SSM::myLaneScanned;
+
+#ifdef HAVE_FOX
+FXWorkerThread::Pool MSDevice_SSM::myThreadPool(0, true);
+#endif
+
 const std::set<MSDevice*>&
 MSDevice_SSM::getInstances() {
     return *instances;
@@ -185,6 +196,12 @@ MSDevice_SSM::cleanup() {
         }
         instances->clear();
     }
+    myLaneOccupancy.clear();
+    myScannedLanes.clear();
+    myLaneScanned.clear();
+#ifdef HAVE_FOX
+    myThreadPool.clear();
+#endif
     for (auto& fn : createdOutputFiles) {
         OutputDevice* file = &OutputDevice::getDevice(fn);
         file->closeTag();
@@ -373,18 +390,224 @@ MSDevice_SSM::EncounterApproachInfo::EncounterApproachInfo(Encounter* e) :
 
 
 void
-MSDevice_SSM::updateAndWriteOutput() {
-    if (myHolder.isOnRoad()) {
-        update();
-        // Write out past conflicts
-        flushConflicts();
+MSDevice_SSM::updateAll() {
+    if (instances->empty()) {
+        return;
+    }
+    updateLaneOccupancy();
+    std::vector<MSDevice_SSM*> onRoad;
+    for (std::set<MSDevice*>::const_iterator di = instances->begin(); di != instances->end(); ++di) {
+        MSDevice_SSM* dev = static_cast<MSDevice_SSM*>(*di);
+        if (dev->myHolder.isOnRoad()) {
+            onRoad.push_back(dev);
+        }
+    }
+    // the encounters of different devices are independent of each other, only the output needs to be sequential
+#ifdef HAVE_FOX
+    if (MSGlobals::gNumSimThreads > 1 && onRoad.size() > 1) {
+        while (myThreadPool.size() < MSGlobals::gNumSimThreads) {
+            new FXWorkerThread(myThreadPool);
+        }
+        const int chunkSize = MAX2(1, (int)onRoad.size() / (4 * myThreadPool.size()));
+        for (std::vector<MSDevice_SSM*>::const_iterator i = onRoad.begin(); i != onRoad.end();) {
+            std::vector<MSDevice_SSM*>::const_iterator end = i + MIN2(chunkSize, (int)(onRoad.end() - i));
+            myThreadPool.add(new UpdateTask(i, end));
+            i = end;
+        }
+        myThreadPool.waitAll();
+    } else {
+#endif
+        for (std::vector<MSDevice_SSM*>::const_iterator i = onRoad.begin(); i != onRoad.end(); ++i) {
+            (*i)->update();
+        }
+#ifdef HAVE_FOX
+    }
+#endif
+    for (std::set<MSDevice*>::const_iterator di = instances->begin(); di != instances->end(); ++di) {
+        MSDevice_SSM* dev = static_cast<MSDevice_SSM*>(*di);
+        dev->writeWarnings();
+        if (dev->myHolder.isOnRoad()) {
+            dev->computeGlobalMeasures();
+            dev->flushConflicts();
+        } else {
+            dev->resetEncounters();
+            dev->flushConflicts(true);
+        }
+    }
+}
+
+
+void
+MSDevice_SSM::updateLaneOccupancy() {
+    if (myLaneOccupancy.size() != (size_t)MSLane::dictSize()) {
+        myLaneOccupancy.resize(MSLane::dictSize());
+        myLaneScanned.resize(MSLane::dictSize(), false);
+        const MSEdgeVector& edges = MSEdge::getAllEdges();
+        for (MSEdgeVector::const_iterator i = edges.begin(); i != edges.end(); ++i) {
+            const std::vector<MSLane*>& lanes = (*i)->getLanes();
+            for (std::vector<MSLane*>::const_iterator j = lanes.begin(); j != lanes.end(); ++j) {
+                // fill the lazily computed successor now, the encounter classification must not modify the net
+                (*j)->getCanonicalSuccessorLane();
+            }
+        }
+    }
+    for (std::vector<const MSLane*>::const_iterator i = myScannedLanes.begin(); i != myScannedLanes.end(); ++i) {
+        myLaneOccupancy[(*i)->getNumericalID()].clear();
+        myLaneScanned[(*i)->getNumericalID()] = false;
+    }
+    myScannedLanes.clear();
+    std::map<const MSEdge*, double> seenRange;
+    for (std::set<MSDevice*>::const_iterator di = instances->begin(); di != instances->end(); ++di) {
+        const MSDevice_SSM* dev = static_cast<MSDevice_SSM*>(*di);
+        if (!dev->myHolder.isOnRoad()) {
+            continue;
+        }
+        addLanesInRange(*dev->myHolderMS, dev->myRange, seenRange);
+        // foes of active encounters are traced even after they left the range
+        for (EncounterVector::const_iterator ei = dev->myActiveEncounters.begin(); ei != dev->myActiveEncounters.end(); ++ei) {
+            const MSVehicle* foe = static_cast<const MSVehicle*>(MSNet::getInstance()->getVehicleControl().getVehicle((*ei)->foeID));
+            if (foe != 0 && foe->getLane() != 0) {
+                addScannedLane(foe->getLane());
+            }
+        }
+    }
+    for (std::vector<const MSLane*>::const_iterator i = myScannedLanes.begin(); i != myScannedLanes.end(); ++i) {
+        const MSLane* const lane = *i;
+        std::vector<LaneOccupant>& occupants = myLaneOccupancy[lane->getNumericalID()];
+        const MSLane::VehCont& vehicles = lane->getVehiclesSecure();
+        for (MSLane::VehCont::const_iterator vi = vehicles.begin(); vi != vehicles.end(); ++vi) {
+            // getPosition() fills the vehicle's position cache, this must not happen in the worker threads
+            const LaneOccupant occ = {*vi, (*vi)->getPositionOnLane(), (*vi)->getPositionOnLane() - (*vi)->getLength(),
+                                      (*vi)->getPosition(), (*vi)->getVelocityVector()
+                                     };
+            occupants.push_back(occ);
+        }
+        lane->releaseVehicles();
+    }
+}
+
+
+void
+MSDevice_SSM::addLanesInRange(const MSVehicle& veh, double range, std::map<const MSEdge*, double>& seenRange) {
+    // this follows the search in findSurroundingVehicles() and getUpstreamVehicles()
+    const MSLane* lane = veh.getLane();
+    const std::vector<MSLane*>& bestLanes = veh.getBestLanesContinuation();
+    std::vector<MSLane*>::const_iterator laneIter = bestLanes.begin();
+    double pos = veh.getPositionOnLane();
+    addScannedLane(lane);
+    if (lane->isInternal()) {
+        const MSJunction* junction = lane->getEdge().getToJunction();
+        addJunctionLanes(junction);
+        const ConstMSEdgeVector& incoming = junction->getIncoming();
+        for (ConstMSEdgeVector::const_iterator ei = incoming.begin(); ei != incoming.end(); ++ei) {
+            if (!(*ei)->isInternal()) {
+                addUpstreamLanes(*ei, range + veh.getLength(), seenRange);
+            }
+        }
+        if (laneIter == bestLanes.end() || ++laneIter == bestLanes.end()) {
+            return;
+        }
+        lane = *laneIter;
+        pos = 0.;
     } else {
-        resetEncounters();
-        // Write out past conflicts
-        flushConflicts(true);
+        addUpstreamLanes(&lane->getEdge(), range + veh.getLength() + lane->getLength() - pos, seenRange);
+    }
+    double remainingDownstreamRange = range;
+    while (remainingDownstreamRange > 0. && lane != 0) {
+        addUpstreamLanes(&lane->getEdge(), 0., seenRange);
+        if (pos + remainingDownstreamRange < lane->getLength() || laneIter == bestLanes.end() || ++laneIter == bestLanes.end()) {
+            break;
+        }
+        remainingDownstreamRange -= lane->getLength() - pos;
+        pos = 0.;
+        const MSJunction* junction = lane->getEdge().getToJunction();
+        addJunctionLanes(junction);
+        const ConstMSEdgeVector& incoming = junction->getIncoming();
+        for (ConstMSEdgeVector::const_iterator ei = incoming.begin(); ei != incoming.end(); ++ei) {
+            if (!(*ei)->isInternal()) {
+                addUpstreamLanes(*ei, range, seenRange);
+            }
+        }
+        lane = *laneIter;
+    }
+}
+
+
+void
+MSDevice_SSM::addUpstreamLanes(const MSEdge* edge, double range, std::map<const MSEdge*, double>& seenRange) {
+    std::map<const MSEdge*, double>::iterator seen = seenRange.find(edge);
+    if (seen != seenRange.end() && seen->second >= range) {
+        return;
+    }
+    seenRange[edge] = range;
+    const std::vector<MSLane*>& lanes = edge->getLanes();
+    for (std::vector<MSLane*>::const_iterator li = lanes.begin(); li != lanes.end(); ++li) {
+        addScannedLane(*li);
+    }
+    if (range <= edge->getLength()) {
+        return;
+    }
+    const MSJunction* junction = edge->getFromJunction();
+    addJunctionLanes(junction);
+    const ConstMSEdgeVector& incoming = junction->getIncoming();
+    for (ConstMSEdgeVector::const_iterator ei = incoming.begin(); ei != incoming.end(); ++ei) {
+        if (!(*ei)->isInternal()) {
+            addUpstreamLanes(*ei, range - edge->getLength(), seenRange);
+        }
+    }
+}
+
+
+void
+MSDevice_SSM::addJunctionLanes(const MSJunction* junction) {
+    const std::vector<MSLane*> lanes = junction->getInternalLanes();
+    for (std::vector<MSLane*>::const_iterator li = lanes.begin(); li != lanes.end(); ++li) {
+        addScannedLane(*li);
+        const MSLane* via = (*li)->getLinkCont().empty() ? 0 : (*li)->getLinkCont()[0]->getViaLane();
+        if (via != 0) {
+            addScannedLane(via);
+        }
+    }
+}
+
+
+void
+MSDevice_SSM::addScannedLane(const MSLane* lane) {
+    if (!myLaneScanned[lane->getNumericalID()]) {
+        myLaneScanned[lane->getNumericalID()] = true;
+        myScannedLanes.push_back(lane);
+    }
+}
+
+
+void
+MSDevice_SSM::getSnapshotState(const MSVehicle* veh, Position& pos, Position& velocity) {
+    const MSLane* lane = veh->getLane();
+    if (lane != 0) {
+        const std::vector<LaneOccupant>& occupants = myLaneOccupancy[lane->getNumericalID()];
+        for (std::vector<LaneOccupant>::const_iterator i = occupants.begin(); i != occupants.end(); ++i) {
+            if (i->veh == veh) {
+                pos = i->position;
+                velocity = i->velocity;
+                return;
+            }
+        }
+    }
+    // vehicles which are not on a lane (teleporting or parking) do not use the position cache
+    pos = veh->getPosition();
+    velocity = veh->getVelocityVector();
+}
+
+
+void
+MSDevice_SSM::writeWarnings() {
+    for (std::vector<std::string>::const_iterator i = myWarnings.begin(); i != myWarnings.end(); ++i) {
+        WRITE_WARNING(*i);
     }
+    myWarnings.clear();
 }
 
+
 void
 MSDevice_SSM::update() {
 #ifdef DEBUG_SSM
@@ -415,11 +638,6 @@ MSDevice_SSM::update() {
     // Make new encounters for all foes, which were not removed by processEncounters (and deletes corresponding FoeInfos)
     createEncounters(foes);
     foes.clear();
-
-    // Compute "global SSMs" (only computed once per time-step)
-    computeGlobalMeasures();
-
-
 }
 
 
@@ -673,7 +891,11 @@ MSDevice_SSM::updateEncounter(Encounter* e, FoeInfo* foeInfo) {
     computeSSMs(eInfo);
 
     // Add current states to trajectories and update type
-    e->add(SIMTIME, eInfo.type, e->ego->getPosition(), e->ego->getVelocityVector(), e->foe->getPosition(), e->foe->getVelocityVector(),
+    // positions and velocities are taken from the snapshot, other devices may access the same vehicles concurrently
+    Position egoPos, egoV, foePos, foeV;
+    getSnapshotState(e->ego, egoPos, egoV);
+    getSnapshotState(e->foe, foePos, foeV);
+    e->add(SIMTIME, eInfo.type, egoPos, egoV, foePos, foeV,
            eInfo.conflictPoint, eInfo.egoConflictEntryDist, eInfo.foeConflictEntryDist, eInfo.ttc, eInfo.drac, eInfo.pet);
 
     // free foeInfo
@@ -820,7 +1042,7 @@ MSDevice_SSM::estimateConflictTimes(EncounterApproachInfo& eInfo) {
         type = ENCOUNTER_TYPE_COLLISION;
         std::stringstream ss;
         ss << "SSM device of vehicle '" << e->egoID << "' detected collision with vehicle '" << e->foeID << "'";
-        WRITE_WARNING(ss.str());
+        myWarnings.push_back(ss.str());
     } else if (eInfo.egoEstimatedConflictEntryTime < eInfo.foeEstimatedConflictEntryTime) {
         // ego is estimated first at conflict point
 #ifdef DEBUG_SSM
@@ -844,7 +1066,7 @@ MSDevice_SSM::estimateConflictTimes(EncounterApproachInfo& eInfo) {
 
 
 void
-MSDevice_SSM::computeSSMs(EncounterApproachInfo& eInfo) const {
+MSDevice_SSM::computeSSMs(EncounterApproachInfo& eInfo) {
 #ifdef DEBUG_SSM
     Encounter* e = eInfo.encounter;
     std::cout << SIMTIME << " computeSSMs() for vehicles '"
@@ -879,7 +1101,7 @@ MSDevice_SSM::computeSSMs(EncounterApproachInfo& eInfo) const {
     } else {
         std::stringstream ss;
         ss << "'" << type << "'";
-        WRITE_WARNING("Unknown or undetermined encounter type at computeSSMs(): " + ss.str());
+        myWarnings.push_back("Unknown or undetermined encounter type at computeSSMs(): " + ss.str());
     }
 
 #ifdef DEBUG_SSM
@@ -990,7 +1212,7 @@ MSDevice_SSM::determinePET(EncounterApproachInfo& eInfo) const {
 
 
 void
-MSDevice_SSM::determineTTCandDRAC(EncounterApproachInfo& eInfo) const {
+MSDevice_SSM::determineTTCandDRAC(EncounterApproachInfo& eInfo) {
     Encounter* e = eInfo.encounter;
     const EncounterType& type = eInfo.type;
     double& ttc = eInfo.ttc;
@@ -1148,7 +1370,7 @@ MSDevice_SSM::determineTTCandDRAC(EncounterApproachInfo& eInfo) const {
 #ifdef DEBUG_SSM
         std::stringstream ss;
         ss << "'" << type << "'";
-        WRITE_WARNING("Underspecified or unknown encounter type in MSDevice_SSM::determineTTCandDRAC(): " + ss.str());
+        myWarnings.push_back("Underspecified or unknown encounter type in MSDevice_SSM::determineTTCandDRAC(): " + ss.str());
 #endif
     }
 
@@ -2511,7 +2733,7 @@ MSDevice_SSM::findSurroundingVehicles(const MSVehicle& veh, double range, FoeInf
 }
 
 void
-MSDevice_SSM::getUpstreamVehicles(const MSEdge* edge, double pos, double range, double egoDistToConflictLane, const MSLane* const egoConflictLane, FoeInfoMap& foeCollector, std::set<const MSJunction*> seenJunctions) {
+MSDevice_SSM::getUpstreamVehicles(const MSEdge* edge, double pos, double range, double egoDistToConflictLane, const MSLane* const egoConflictLane, FoeInfoMap& foeCollector, std::set<const MSJunction*>& seenJunctions) {
 #ifdef DEBUG_SSM_SURROUNDING
     std::cout << SIMTIME << " getUpstreamVehicles() for edge '" << edge->getID() << "'"
               << " pos = " << pos << " range = " << range
@@ -2525,21 +2747,18 @@ MSDevice_SSM::getUpstreamVehicles(const MSEdge* edge, double pos, double range,
     const std::vector<MSLane*>& lanes = edge->getLanes();
     // Collect vehicles on the given edge with position in [pos-range,pos]
     for (std::vector<MSLane*>::const_iterator li = lanes.begin(); li != lanes.end(); ++li) {
-        MSLane* lane = *li;
-        const MSLane::VehCont& vehicles = lane->getVehiclesSecure();
-        for (MSLane::VehCont::const_iterator vi = vehicles.begin(); vi != vehicles.end(); ++vi) {
-            MSVehicle* veh = *vi;
-            if (veh->getPositionOnLane() - veh->getLength() <= pos && veh->getPositionOnLane() >= pos - range) {
+        const std::vector<LaneOccupant>& occupants = myLaneOccupancy[(*li)->getNumericalID()];
+        for (std::vector<LaneOccupant>::const_iterator vi = occupants.begin(); vi != occupants.end(); ++vi) {
+            if (vi->backPos <= pos && vi->pos >= pos - range) {
 #ifdef DEBUG_SSM
-                std::cout << veh->getID()  << "\n";
+                std::cout << vi->veh->getID()  << "\n";
 #endif
                 FoeInfo* c = new FoeInfo(); // c is deleted in updateEncounter()
                 c->egoDistToConflictLane = egoDistToConflictLane;
                 c->egoConflictLane = egoConflictLane;
-                foeCollector[veh] = c;
+                foeCollector[vi->veh] = c;
             }
         }
-        lane->releaseVehicles();
     }
 
 #ifdef DEBUG_SSM
@@ -2560,6 +2779,8 @@ MSDevice_SSM::getUpstreamVehicles(const MSEdge* edge, double pos, double range,
     // Junction representing the origin of 'edge'
     const MSJunction* junction = edge->getFromJunction();
     if (seenJunctions.count(junction) == 0) {
+        // the junction is only marked as seen for the recursive calls below (and removed afterwards)
+        bool inserted = false;
         // Collect vehicles from incoming edges of the junction
         if (!edge->isInternal()) {
             // collect vehicles on preceding junction (for internal edges this is already done in caller,
@@ -2568,6 +2789,7 @@ MSDevice_SSM::getUpstreamVehicles(const MSEdge* edge, double pos, double range,
             // Collect vehicles on the junction, if it wasn't considered already
             getVehiclesOnJunction(junction, egoDistToConflictLane, egoConflictLane, foeCollector);
             seenJunctions.insert(junction);
+            inserted = true;
         }
         // Collect vehicles from incoming edges from the junction representing the origin of 'edge'
         const ConstMSEdgeVector& incoming = junction->getIncoming();
@@ -2584,6 +2806,9 @@ MSDevice_SSM::getUpstreamVehicles(const MSEdge* edge, double pos, double range,
             // account for vehicles on the predecessor edge
             getUpstreamVehicles(inEdge, inEdge->getLength(), range - distOnJunction, egoDistToConflictLane, egoConflictLane, foeCollector, seenJunctions);
         }
+        if (inserted) {
+            seenJunctions.erase(junction);
+        }
     } else {
 #ifdef DEBUG_SSM_SURROUNDING
         std::cout << "    Downstream Scan for stops at junction '" << junction->getID()
@@ -2603,23 +2828,20 @@ MSDevice_SSM::getVehiclesOnJunction(const MSJunction* junction, double egoDistTo
     // Collect vehicles on internal lanes
     const std::vector<MSLane*> lanes = junction->getInternalLanes();
     for (std::vector<MSLane*>::const_iterator li = lanes.begin(); li != lanes.end(); ++li) {
-        MSLane* lane = *li;
-        const MSLane::VehCont& vehicles = lane->getVehiclesSecure();
+        const MSLane* lane = *li;
+        const std::vector<LaneOccupant>* occupants = &myLaneOccupancy[lane->getNumericalID()];
 
         // Add FoeInfos (XXX: for some situations, a vehicle may be collected twice. Then the later finding overwrites the earlier in foeCollector.
         // This could lead to neglecting a conflict when determining foeConflictLane later.) -> TODO: test with twice intersecting routes
-        for (MSLane::VehCont::const_iterator vi = vehicles.begin(); vi != vehicles.end(); ++vi) {
+        for (std::vector<LaneOccupant>::const_iterator vi = occupants->begin(); vi != occupants->end(); ++vi) {
             FoeInfo* c = new FoeInfo();
             c->egoConflictLane = egoConflictLane;
             c->egoDistToConflictLane = egoDistToConflictLane;
-            foeCollector[*vi] = c;
+            foeCollector[vi->veh] = c;
 #ifdef DEBUG_SSM_SURROUNDING
-            for (MSLane::VehCont::const_iterator vi = vehicles.begin(); vi != vehicles.end(); ++vi) {
-                std::cout << (*vi)->getID() << "\n";
-            }
+            std::cout << vi->veh->getID() << "\n";
 #endif
         }
-        lane->releaseVehicles();
 
         // If there is an internal continuation lane, also collect vehicles on that lane
         if (lane->getLinkCont().size() > 1 && lane->getLinkCont()[0]->getViaLane() != 0) {
@@ -2629,20 +2851,17 @@ MSDevice_SSM::getVehiclesOnJunction(const MSJunction* junction, double egoDistTo
             assert(lane->getLinkCont().size() == 0 || lane->getLinkCont()[0]->getViaLane() == 0);
 
             // collect vehicles
-            const MSLane::VehCont& vehicles2 = lane->getVehiclesSecure();
+            occupants = &myLaneOccupancy[lane->getNumericalID()];
             // Add FoeInfos. This duplicates the loop for the first internal lane
-            for (MSLane::VehCont::const_iterator vi = vehicles2.begin(); vi != vehicles2.end(); ++vi) {
+            for (std::vector<LaneOccupant>::const_iterator vi = occupants->begin(); vi != occupants->end(); ++vi) {
                 FoeInfo* c = new FoeInfo();
                 c->egoConflictLane = egoConflictLane;
                 c->egoDistToConflictLane = egoDistToConflictLane;
-                foeCollector[*vi] = c;
+                foeCollector[vi->veh] = c;
 #ifdef DEBUG_SSM_SURROUNDING
-                for (MSLane::VehCont::const_iterator vi = vehicles2.begin(); vi != vehicles2.end(); ++vi) {
-                    std::cout << (*vi)->getID() << "\n";
-                }
+                std::cout << vi->veh->getID() << "\n";
 #endif
             }
-            lane->releaseVehicles();
         }
     }
 
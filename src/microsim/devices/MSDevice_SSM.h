@@ -31,10 +31,14 @@
 #endif
 
 #include <queue>
+#include <vector>
 #include "MSDevice.h"
 #include <utils/common/SUMOTime.h>
 #include <utils/iodevices/OutputDevice_File.h>
 #include <utils/geom/Position.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXWorkerThread.h>
+#endif
 
 
 // ===========================================================================
@@ -316,11 +320,14 @@ public:
     /** @brief This is called once per time step in MSNet::writeOutput() and
      *         collects the surrounding vehicles, updates information on encounters
      *         and flushes the encounters qualified as conflicts (@see thresholds)
-     *         to the output file.
+     *         to the output file for all devices. The surroundings and encounters
+     *         are evaluated in parallel if multiple simulation threads are used,
+     *         the conflicts are written sequentially in the order of the devices.
      */
-    void updateAndWriteOutput();
+    static void updateAll();
 
 private:
+    /// @brief collects the surrounding vehicles and updates the encounters (may run in parallel for different devices)
     void update();
     void writeOutConflict(Encounter* e);
 
@@ -355,7 +362,7 @@ public:
 
     /** @brief Collects all vehicles within range 'range' upstream of the position 'pos' on the edge 'edge' into foeCollector
      */
-    static void getUpstreamVehicles(const MSEdge* edge, double pos, double range, double egoDistToConflictLane, const MSLane* const egoConflictLane, FoeInfoMap& foeCollector, std::set<const MSJunction*> seenJunctions);
+    static void getUpstreamVehicles(const MSEdge* edge, double pos, double range, double egoDistToConflictLane, const MSLane* const egoConflictLane, FoeInfoMap& foeCollector, std::set<const MSJunction*>& seenJunctions);
 
     /** @brief Collects all vehicles on the junction into foeCollector
      */
@@ -522,7 +529,7 @@ private:
      *        and egoConflictExitTime, foeConflictExitTime (estimated time until the conflict exit point is reached).
      *        Further the type of the encounter as determined by classifyEncounter(), is refined for the cases CROSSING and MERGING here.
      */
-    static void estimateConflictTimes(EncounterApproachInfo& eInfo);
+    void estimateConflictTimes(EncounterApproachInfo& eInfo);
 
 
     /** @brief Checks whether ego or foe have entered or left the conflict area in the last step and eventually writes
@@ -556,7 +563,7 @@ private:
      *  and update 'e' accordingly (add point to SSM time-series, update maximal/minimal value)
      *  This is called just after adding the current vehicle positions and velocity vectors to the encounter.
      */
-    void computeSSMs(EncounterApproachInfo& e) const;
+    void computeSSMs(EncounterApproachInfo& e);
 
 
     /** @brief Discriminates between different encounter types and correspondingly determines the PET for those cases
@@ -568,7 +575,7 @@ private:
     /** @brief Discriminates between different encounter types and correspondingly determines TTC and DRAC for those cases
      *         and writes the result to eInfo.ttc and eInfo.drac
      */
-    void determineTTCandDRAC(EncounterApproachInfo& eInfo) const;
+    void determineTTCandDRAC(EncounterApproachInfo& eInfo);
 
 
     /** @brief Computes the time to collision (in seconds) for two vehicles with a given initial gap under the assumption
@@ -674,6 +681,73 @@ private:
     /// @brief remember which files were created already (don't duplicate xml root-elements)
     static std::set<std::string> createdOutputFiles;
 
+    /// @brief A vehicle on a lane together with its front and back position, its cartesian position and velocity
+    struct LaneOccupant {
+        const MSVehicle* veh;
+        double pos;
+        double backPos;
+        Position position;
+        Position velocity;
+    };
+
+    /// @brief rebuilds the lane occupancy for the current step (only for the lanes the devices may scan)
+    static void updateLaneOccupancy();
+
+    /// @brief marks all lanes findSurroundingVehicles() may scan for the given vehicle (distances on junctions are ignored)
+    static void addLanesInRange(const MSVehicle& veh, double range, std::map<const MSEdge*, double>& seenRange);
+
+    /// @brief marks the lanes of the given edge and of its predecessors within range (measured from the edge end)
+    static void addUpstreamLanes(const MSEdge* edge, double range, std::map<const MSEdge*, double>& seenRange);
+
+    /// @brief marks the internal lanes of the given junction
+    static void addJunctionLanes(const MSJunction* junction);
+
+    /// @brief marks the given lane for the occupancy update
+    static void addScannedLane(const MSLane* lane);
+
+    /// @brief retrieves the position and velocity of the given vehicle from the occupancy of the current step
+    static void getSnapshotState(const MSVehicle* veh, Position& pos, Position& velocity);
+
+    /// @brief emits the warnings collected during update()
+    void writeWarnings();
+
+    /// @brief The vehicles on each lane (indexed by numerical lane id) in the current step, shared by all devices
+    static std::vector<std::vector<LaneOccupant> > myLaneOccupancy;
+
+    /// @brief The lanes whose occupancy was collected in the current step
+    static std::vector<const MSLane*> myScannedLanes;
+
+    /// @brief Whether a lane (indexed by numerical lane id) is in myScannedLanes
+    static std::vector<bool> myLaneScanned;
+
+    /// @brief The warnings of the current step, update() may run in a worker thread so they are written afterwards
+    std::vector<std::string> myWarnings;
+
+#ifdef HAVE_FOX
+    /**
+     * @class UpdateTask
+     * @brief The task for updating a range of devices in a worker thread
+     */
+    class UpdateTask : public FXWorkerThread::Task {
+    public:
+        UpdateTask(const std::vector<MSDevice_SSM*>::const_iterator begin, const std::vector<MSDevice_SSM*>::const_iterator end)
+            : myBegin(begin), myEnd(end) {}
+        void run(FXWorkerThread* /*context*/) {
+            for (std::vector<MSDevice_SSM*>::const_iterator i = myBegin; i != myEnd; ++i) {
+                (*i)->update();
+            }
+        }
+    private:
+        const std::vector<MSDevice_SSM*>::const_iterator myBegin, myEnd;
+    private:
+        /// @brief Invalidated assignment operator.
+        UpdateTask& operator=(const UpdateTask&) = delete;
+    };
+
+    /// @brief The pool for updating the devices in parallel
+    static FXWorkerThread::Pool myThreadPool;
+#endif
+
 private:
     /// @brief Invalidated copy constructor.
     MSDevice_SSM(const MSDevice_SSM&);
@@ -0,0 +1,347 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2012-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    MSFCDColumnarExport.cpp
+/// @author  Michael Behrisch
+/// @date    2018-11-20
+/// @version $Id$
+///
+// Realises dumping FCD Data in a chunked, columnar binary format
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cmath>
+#include <cstring>
+#include <cerrno>
+#include <utils/common/StdDefs.h>
+#include <utils/common/UtilExceptions.h>
+#include <utils/options/OptionsCont.h>
+#include <utils/geom/GeoConvHelper.h>
+#include <utils/geom/GeomHelper.h>
+#include <microsim/devices/MSDevice_FCD.h>
+#include <microsim/MSEdgeControl.h>
+#include <microsim/MSEdge.h>
+#include <microsim/MSLane.h>
+#include <microsim/MSGlobals.h>
+#include <microsim/MSNet.h>
+#include <microsim/MSVehicle.h>
+#include <microsim/MSTransportableControl.h>
+#include <microsim/pedestrians/MSPerson.h>
+#include "MSFCDColumnarExport.h"
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+MSFCDColumnarExport* MSFCDColumnarExport::myInstance = 0;
+const int MSFCDColumnarExport::ROWS_PER_CHUNK = 1 << 16;
+const int MSFCDColumnarExport::MAX_PENDING_CHUNKS_PER_THREAD = 2;
+
+
+// ===========================================================================
+// helper functions
+// ===========================================================================
+namespace {
+const int KIND_VEHICLE = 0;
+const int KIND_PERSON = 1;
+const int KIND_CONTAINER = 2;
+
+void
+writeVarint(std::string& into, unsigned long long value) {
+    while (value >= 0x80) {
+        into.push_back((char)((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    into.push_back((char)value);
+}
+
+void
+writeSignedVarint(std::string& into, const long long value) {
+    writeVarint(into, ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63));
+}
+
+/// @brief appends the column (size + content) and clears the column buffer
+void
+writeColumn(std::string& into, std::string& column) {
+    writeVarint(into, column.size());
+    into.append(column);
+    column.clear();
+}
+
+void
+encodeIndices(std::string& into, std::string& column, const std::vector<int>& values) {
+    for (std::vector<int>::const_iterator it = values.begin(); it != values.end(); ++it) {
+        writeVarint(column, *it);
+    }
+    writeColumn(into, column);
+}
+
+/// @brief encodes the rounded values as differences to the previous value of the same object
+void
+encodeValues(std::string& into, std::string& column, const std::vector<double>& values, const std::vector<int>& ids,
+             const double scale, std::vector<long long>& last) {
+    last.assign(last.size(), 0);
+    for (int i = 0; i < (int)values.size(); i++) {
+        const long long q = std::llround(values[i] * scale);
+        writeSignedVarint(column, q - last[ids[i]]);
+        last[ids[i]] = q;
+    }
+    writeColumn(into, column);
+}
+}
+
+
+// ===========================================================================
+// static method definitions
+// ===========================================================================
+void
+MSFCDColumnarExport::init() {
+    const OptionsCont& oc = OptionsCont::getOptions();
+    if (oc.isSet("fcd-output.columnar")) {
+        myInstance = new MSFCDColumnarExport(oc.getString("fcd-output.columnar"),
+                                             oc.getBool("fcd-output.signals"), oc.getBool("fcd-output.geo"));
+    }
+}
+
+
+void
+MSFCDColumnarExport::cleanup() {
+    delete myInstance;
+    myInstance = 0;
+}
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+MSFCDColumnarExport::MSFCDColumnarExport(const std::string& filename, const bool signals, const bool useGeo) :
+    myFile(filename.c_str(), std::ios::binary),
+    myChunk(new Chunk()),
+    myHeaderWritten(false),
+    myElevation(false),
+    mySignals(signals),
+    myUseGeo(useGeo),
+    myPosScale(pow(10., useGeo ? gPrecisionGeo : gPrecision)),
+    myScale(pow(10., gPrecision)),
+    myPeriod(string2time(OptionsCont::getOptions().getString("device.fcd.period"))) {
+    if (!myFile.good()) {
+        delete myChunk;
+        throw IOError("Could not build output file '" + filename + "' (" + std::strerror(errno) + ").");
+    }
+#ifdef HAVE_FOX
+    new FXWorkerThread(myWriter);
+    myPendingChunks = 0;
+#endif
+}
+
+
+MSFCDColumnarExport::~MSFCDColumnarExport() {
+    if (myHeaderWritten) {
+        flush();
+    }
+#ifdef HAVE_FOX
+    myWriter.waitAll();
+    myWriter.clear();
+#endif
+    delete myChunk;
+    myFile.close();
+}
+
+
+void
+MSFCDColumnarExport::write(SUMOTime timestep, bool elevation) {
+    if (myPeriod > 0 && timestep % myPeriod != 0) {
+        return;
+    }
+    if (!myHeaderWritten) {
+        myElevation = elevation;
+        const char flags = (char)((myElevation ? 1 : 0) | (mySignals ? 2 : 0) | (myUseGeo ? 4 : 0));
+        const char header[] = {'S', 'F', 'C', 'D', 1, flags,
+                               (char)(myUseGeo ? gPrecisionGeo : gPrecision), (char)gPrecision
+                              };
+        myFile.write(header, sizeof(header));
+        myHeaderWritten = true;
+    }
+    Chunk& c = *myChunk;
+    const int rowsBefore = (int)c.id.size();
+    const bool haveMicro = !MSGlobals::gUseMesoSim;
+    const std::map<std::string, SUMOVehicle*>& equipped = MSDevice_FCD::getEquippedVehicles();
+    for (std::map<std::string, SUMOVehicle*>::const_iterator it = equipped.begin(); it != equipped.end(); ++it) {
+        const SUMOVehicle* veh = it->second;
+        if (veh->isOnRoad() || veh->isParking() || veh->isRemoteControlled()) {
+            const MSVehicle* microVeh = haveMicro ? static_cast<const MSVehicle*>(veh) : 0;
+            Position pos = veh->getPosition();
+            if (myUseGeo) {
+                GeoConvHelper::getFinal().cartesian2geo(pos);
+            }
+            c.kind.push_back(KIND_VEHICLE);
+            c.id.push_back(c.getStringIndex(veh->getID()));
+            c.x.push_back(pos.x());
+            c.y.push_back(pos.y());
+            c.z.push_back(pos.z());
+            c.angle.push_back(GeomHelper::naviDegree(veh->getAngle()));
+            c.type.push_back(c.getStringIndex(veh->getVehicleType().getID()));
+            c.speed.push_back(veh->getSpeed());
+            c.pos.push_back(veh->getPositionOnLane());
+            c.lane.push_back(microVeh != 0 ? c.getStringIndex(microVeh->getLane()->getID()) : 0);
+            c.slope.push_back(veh->getSlope());
+            c.signals.push_back(microVeh != 0 ? microVeh->getSignals() : 0);
+            if (microVeh != 0) {
+                const std::vector<MSTransportable*>& persons = microVeh->getPersons();
+                for (std::vector<MSTransportable*>::const_iterator it_p = persons.begin(); it_p != persons.end(); ++it_p) {
+                    addTransportable(&microVeh->getLane()->getEdge(), *it_p, KIND_PERSON);
+                }
+                const std::vector<MSTransportable*>& containers = microVeh->getContainers();
+                for (std::vector<MSTransportable*>::const_iterator it_c = containers.begin(); it_c != containers.end(); ++it_c) {
+                    addTransportable(&microVeh->getLane()->getEdge(), *it_c, KIND_CONTAINER);
+                }
+            }
+        }
+    }
+    if (MSNet::getInstance()->getPersonControl().hasTransportables()) {
+        const MSEdgeVector& edges = MSNet::getInstance()->getEdgeControl().getEdges();
+        for (MSEdgeVector::const_iterator e = edges.begin(); e != edges.end(); ++e) {
+            const std::vector<MSTransportable*>& persons = (*e)->getSortedPersons(timestep);
+            for (std::vector<MSTransportable*>::const_iterator it_p = persons.begin(); it_p != persons.end(); ++it_p) {
+                addTransportable(*e, *it_p, KIND_PERSON);
+            }
+        }
+    }
+    if (MSNet::getInstance()->getContainerControl().hasTransportables()) {
+        const MSEdgeVector& edges = MSNet::getInstance()->getEdgeControl().getEdges();
+        for (MSEdgeVector::const_iterator e = edges.begin(); e != edges.end(); ++e) {
+            const std::vector<MSTransportable*>& containers = (*e)->getSortedContainers(timestep);
+            for (std::vector<MSTransportable*>::const_iterator it_c = containers.begin(); it_c != containers.end(); ++it_c) {
+                addTransportable(*e, *it_c, KIND_CONTAINER);
+            }
+        }
+    }
+    c.steps.push_back(std::make_pair(timestep, (int)c.id.size() - rowsBefore));
+    if ((int)c.id.size() >= ROWS_PER_CHUNK) {
+        flush();
+    }
+}
+
+
+void
+MSFCDColumnarExport::addTransportable(const MSEdge* e, const MSTransportable* p, const int kind) {
+    Chunk& c = *myChunk;
+    Position pos = p->getPosition();
+    if (myUseGeo) {
+        GeoConvHelper::getFinal().cartesian2geo(pos);
+    }
+    c.kind.push_back(kind);
+    c.id.push_back(c.getStringIndex(p->getID()));
+    c.x.push_back(pos.x());
+    c.y.push_back(pos.y());
+    c.z.push_back(pos.z());
+    c.angle.push_back(GeomHelper::naviDegree(p->getAngle()));
+    c.type.push_back(0);
+    c.speed.push_back(p->getSpeed());
+    c.pos.push_back(p->getEdgePos());
+    c.lane.push_back(c.getStringIndex(e->getID()));
+    c.slope.push_back(e->getLanes()[0]->getShape().slopeDegreeAtOffset(p->getEdgePos()));
+    c.signals.push_back(0);
+}
+
+
+void
+MSFCDColumnarExport::flush() {
+    if (myChunk->steps.empty()) {
+        return;
+    }
+    Chunk* const full = myChunk;
+    myChunk = new Chunk();
+#ifdef HAVE_FOX
+    myWriter.add(new EncodeTask(*this, full));
+    myPendingChunks++;
+    // collect the finished tasks when the writer is idle and wait for it if it falls behind,
+    // so the memory held by the pending chunks stays bounded
+    if (!myWriter.isFull() || myPendingChunks > MAX_PENDING_CHUNKS_PER_THREAD * myWriter.size()) {
+        myWriter.waitAll();
+        myPendingChunks = 0;
+    }
+#else
+    writeChunk(full);
+#endif
+}
+
+
+void
+MSFCDColumnarExport::writeChunk(Chunk* chunk) {
+    myBuffer.clear();
+    chunk->encode(myBuffer, myElevation, mySignals, myPosScale, myScale);
+    delete chunk;
+    myFile.write(myBuffer.data(), myBuffer.size());
+}
+
+
+void
+MSFCDColumnarExport::Chunk::encode(std::string& into, const bool elevation, const bool withSignals,
+                                   const double posScale, const double scale) const {
+    std::string body;
+    std::string column;
+    writeVarint(body, strings.size());
+    for (std::vector<std::string>::const_iterator it = strings.begin(); it != strings.end(); ++it) {
+        writeVarint(body, it->size());
+        body.append(*it);
+    }
+    writeVarint(body, steps.size());
+    SUMOTime lastTime = 0;
+    for (std::vector<std::pair<SUMOTime, int> >::const_iterator it = steps.begin(); it != steps.end(); ++it) {
+        writeSignedVarint(body, it->first - lastTime);
+        writeVarint(body, it->second);
+        lastTime = it->first;
+    }
+    std::vector<long long> last(strings.size(), 0);
+    encodeIndices(body, column, kind);
+    encodeIndices(body, column, id);
+    encodeValues(body, column, x, id, posScale, last);
+    encodeValues(body, column, y, id, posScale, last);
+    if (elevation) {
+        encodeValues(body, column, z, id, scale, last);
+    }
+    encodeValues(body, column, angle, id, scale, last);
+    encodeIndices(body, column, type);
+    encodeValues(body, column, speed, id, scale, last);
+    encodeValues(body, column, pos, id, scale, last);
+    encodeIndices(body, column, lane);
+    encodeValues(body, column, slope, id, scale, last);
+    if (withSignals) {
+        encodeIndices(body, column, signals);
+    }
+    const unsigned int size = (unsigned int)body.size();
+    for (int i = 0; i < 4; i++) {
+        into.push_back((char)((size >> (8 * i)) & 0xff));
+    }
+    into.append(body);
+}
+
+
+#ifdef HAVE_FOX
+// ---------------------------------------------------------------------------
+// MSFCDColumnarExport::EncodeTask-methods
+// ---------------------------------------------------------------------------
+void
+MSFCDColumnarExport::EncodeTask::run(FXWorkerThread* /* context */) {
+    myExporter.writeChunk(myChunk);
+}
+#endif
+
+
+/****************************************************************************/
@@ -0,0 +1,212 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2012-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    MSFCDColumnarExport.h
+/// @author  Michael Behrisch
+/// @date    2018-11-20
+/// @version $Id$
+///
+// Realises dumping FCD Data in a chunked, columnar binary format
+/****************************************************************************/
+#ifndef MSFCDColumnarExport_h
+#define MSFCDColumnarExport_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utils/common/SUMOTime.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXWorkerThread.h>
+#endif
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class MSEdge;
+class MSTransportable;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSFCDColumnarExport
+ * @brief Realises dumping FCD Data in a chunked, columnar binary format
+ *
+ * The rows (vehicles, persons and containers) of the time steps are collected
+ *  column by column into a chunk which is encoded and written when it is full
+ *  (if compiled with FOX on a background thread, so the simulation does not wait
+ *  for the encoding and the disk).
+ *
+ * The file starts with the magic "SFCD", a version byte, a flag byte
+ *  (1 = elevation, 2 = signals, 4 = geo coordinates) and the number of decimal
+ *  digits for positions and for the other values. Each chunk then consists of
+ *  its byte size (uint32, little endian) followed by
+ *  - the chunk local string table (varint count, each string as varint length + bytes,
+ *    index 0 is the empty string),
+ *  - the time steps (varint count, each as zigzag varint time delta in ms + varint row count),
+ *  - the columns kind (0 = vehicle, 1 = person, 2 = container), id, x, y, [z], angle, type,
+ *    speed, pos, lane (the edge for persons and containers), slope, [signals], each
+ *    prefixed by its byte size as varint.
+ * Strings are stored as indices into the string table, numbers are rounded to the
+ *  given number of digits and stored as zigzag varint differences to the value
+ *  of the same object (id) in its previous row within the chunk.
+ *
+ * tools/sumolib/output/fcdcolumnar.py reads this format.
+ */
+class MSFCDColumnarExport {
+public:
+    /// @brief Static intialization, creates the instance if the output is requested
+    static void init();
+
+    /// @brief Writes the remaining data, waits for the writer and closes the file
+    static void cleanup();
+
+    /// @brief Returns the instance or 0 if the output is not active
+    static MSFCDColumnarExport* getInstance() {
+        return myInstance;
+    }
+
+    /** @brief Collects the data of all equipped vehicles and transportables of the time step
+     *
+     * @param[in] timestep The current time step
+     * @param[in] elevation Whether elevation data shall be written
+     */
+    void write(SUMOTime timestep, bool elevation);
+
+private:
+    /// @brief the data of a number of time steps, stored column wise
+    struct Chunk {
+        Chunk() {
+            getStringIndex("");
+        }
+
+        /// @brief returns the index of the given string in the chunk local string table
+        int getStringIndex(const std::string& s) {
+            std::unordered_map<std::string, int>::const_iterator it = stringIndex.find(s);
+            if (it != stringIndex.end()) {
+                return it->second;
+            }
+            const int index = (int)strings.size();
+            strings.push_back(s);
+            stringIndex[s] = index;
+            return index;
+        }
+
+        /// @brief encodes the chunk (including its size) into the given buffer
+        void encode(std::string& into, const bool elevation, const bool signals, const double posScale, const double scale) const;
+
+        std::vector<std::string> strings;
+        std::unordered_map<std::string, int> stringIndex;
+        std::vector<std::pair<SUMOTime, int> > steps;
+        std::vector<int> kind, id, type, lane, signals;
+        std::vector<double> x, y, z, angle, speed, pos, slope;
+    };
+
+#ifdef HAVE_FOX
+    /**
+     * @class EncodeTask
+     * @brief the task which encodes and writes a chunk on the writer thread
+     */
+    class EncodeTask : public FXWorkerThread::Task {
+    public:
+        EncodeTask(MSFCDColumnarExport& exporter, Chunk* chunk)
+            : myExporter(exporter), myChunk(chunk) {}
+        void run(FXWorkerThread* context);
+    private:
+        MSFCDColumnarExport& myExporter;
+        Chunk* myChunk;
+    private:
+        /// @brief Invalidated assignment operator.
+        EncodeTask& operator=(const EncodeTask&);
+    };
+#endif
+
+    /// @brief constructor, opens the file (the header is written with the first time step)
+    MSFCDColumnarExport(const std::string& filename, const bool signals, const bool useGeo);
+
+    /// @brief Destructor, writes the remaining data
+    ~MSFCDColumnarExport();
+
+    /// @brief adds a row for a transportable
+    void addTransportable(const MSEdge* e, const MSTransportable* p, const int kind);
+
+    /// @brief hands the current chunk over to the writer
+    void flush();
+
+    /// @brief encodes the given chunk, writes it to the file and deletes it
+    void writeChunk(Chunk* chunk);
+
+private:
+    /// @brief the output file
+    std::ofstream myFile;
+
+    /// @brief the chunk currently filled
+    Chunk* myChunk;
+
+    /// @brief the buffer for encoding a chunk (used by the writer only)
+    std::string myBuffer;
+
+    /// @brief whether the header has been written
+    bool myHeaderWritten;
+
+    /// @brief whether elevation is written (known with the first time step)
+    bool myElevation;
+
+    /// @brief the content flags given by the options
+    const bool mySignals, myUseGeo;
+
+    /// @brief the factors for rounding positions and the other values
+    const double myPosScale, myScale;
+
+    /// @brief the period of the output (from the fcd device)
+    const SUMOTime myPeriod;
+
+#ifdef HAVE_FOX
+    /// @brief the pool with the single writer thread
+    FXWorkerThread::Pool myWriter;
+
+    /// @brief the number of chunks handed to the writer since it was last collected
+    int myPendingChunks;
+#endif
+
+    /// @brief the number of rows which triggers the writing of a chunk
+    static const int ROWS_PER_CHUNK;
+
+    /// @brief the number of pending chunks per writer thread which makes the simulation wait for the writer
+    static const int MAX_PENDING_CHUNKS_PER_THREAD;
+
+    /// @brief the instance
+    static MSFCDColumnarExport* myInstance;
+
+private:
+    /// @brief Invalidated copy constructor.
+    MSFCDColumnarExport(const MSFCDColumnarExport&);
+
+    /// @brief Invalidated assignment operator.
+    MSFCDColumnarExport& operator=(const MSFCDColumnarExport&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
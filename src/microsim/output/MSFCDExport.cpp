@@ -61,7 +61,7 @@ MSFCDExport::write(OutputDevice& of, SUMOTime timestep, bool elevation) {
     MSVehicleControl& vc = MSNet::getInstance()->getVehicleControl();
     for (MSVehicleControl::constVehIt it = vc.loadedVehBegin(); it != vc.loadedVehEnd(); ++it) {
         const SUMOVehicle* veh = it->second;
-        const MSVehicle* microVeh = dynamic_cast<const MSVehicle*>(veh);
+        const MSVehicle* microVeh = MSGlobals::gUseMesoSim ? 0 : static_cast<const MSVehicle*>(veh);
         if ((veh->isOnRoad() || veh->isParking() || veh->isRemoteControlled()) 
                 && veh->getDevice(typeid(MSDevice_FCD)) != nullptr) {
             Position pos = veh->getPosition();
@@ -30,12 +30,14 @@
 #endif
 
 #include <limits>
+#include <algorithm>
 #include <microsim/MSEdgeControl.h>
 #include <microsim/MSEdge.h>
 #include <microsim/MSLane.h>
 #include <microsim/MSVehicle.h>
 #include <microsim/cfmodels/MSCFModel.h>
 #include <microsim/MSNet.h>
+#include <microsim/MSVehicleControl.h>
 #include <utils/common/SUMOTime.h>
 #include <utils/common/ToString.h>
 #include <utils/iodevices/OutputDevice.h>
@@ -87,6 +89,19 @@ MSMeanData::MeanDataValues::notifyEnter(SUMOVehicle& veh, MSMoveReminder::Notifi
 
 bool
 MSMeanData::MeanDataValues::notifyMove(SUMOVehicle& veh, double oldPos, double newPos, double newSpeed) {
+    MoveValues values;
+    bool keep = true;
+    if (computeMove(veh, oldPos, newPos, newSpeed, values, keep)) {
+        notifyMoveInternal(veh, values.frontOnLane, values.timeOnLane, values.meanSpeedFrontOnLane, values.meanSpeedVehicleOnLane,
+                           values.travelledDistanceFrontOnLane, values.travelledDistanceVehicleOnLane, values.meanLengthOnLane);
+    }
+    return keep;
+}
+
+
+bool
+MSMeanData::MeanDataValues::computeMove(const SUMOVehicle& veh, const double oldPos, const double newPos, const double newSpeed,
+                                        MoveValues& into, bool& keep) const {
     // if the vehicle has arrived, the reminder must be kept so it can be
     // notified of the arrival subsequently
     const double oldSpeed = veh.getPreviousSpeed();
@@ -96,7 +111,7 @@ MSMeanData::MeanDataValues::notifyMove(SUMOVehicle& veh, double oldPos, double n
     // These values will be further decreased below
     double timeOnLane = TS;
     double frontOnLane = oldPos > myLaneLength ? 0. : TS;
-    bool ret = true;
+    keep = true;
 
     // entry and exit times (will be modified below)
     double timeBeforeEnter = 0.;
@@ -138,7 +153,7 @@ MSMeanData::MeanDataValues::notifyMove(SUMOVehicle& veh, double oldPos, double n
         if (fabs(timeOnLane) < NUMERICAL_EPS) { // reduce rounding errors
             timeOnLane = 0.;
         }
-        ret = veh.hasArrived();
+        keep = veh.hasArrived();
     }
 
     // Treat the case that the vehicle's front left the lane in the last step
@@ -160,10 +175,12 @@ MSMeanData::MeanDataValues::notifyMove(SUMOVehicle& veh, double oldPos, double n
 
     if (timeOnLane < 0) {
         WRITE_ERROR("Negative vehicle step fraction for '" + veh.getID() + "' on lane '" + getLane()->getID() + "'.");
-        return veh.hasArrived();
+        keep = veh.hasArrived();
+        return false;
     }
     if (timeOnLane == 0) {
-        return veh.hasArrived();
+        keep = veh.hasArrived();
+        return false;
     }
 
 #ifdef DEBUG_NOTIFY_MOVE
@@ -250,8 +267,14 @@ MSMeanData::MeanDataValues::notifyMove(SUMOVehicle& veh, double oldPos, double n
 //    const double travelledDistanceFrontOnLane = frontOnLane*newSpeed;
 //    const double travelledDistanceVehicleOnLane = timeOnLane*newSpeed;
 
-    notifyMoveInternal(veh, frontOnLane, timeOnLane, (enterSpeed + leaveSpeedFront) / 2., (enterSpeed + leaveSpeed) / 2., travelledDistanceFrontOnLane, travelledDistanceVehicleOnLane, meanLengthOnLane);
-    return ret;
+    into.frontOnLane = frontOnLane;
+    into.timeOnLane = timeOnLane;
+    into.meanSpeedFrontOnLane = (enterSpeed + leaveSpeedFront) / 2.;
+    into.meanSpeedVehicleOnLane = (enterSpeed + leaveSpeed) / 2.;
+    into.travelledDistanceFrontOnLane = travelledDistanceFrontOnLane;
+    into.travelledDistanceVehicleOnLane = travelledDistanceVehicleOnLane;
+    into.meanLengthOnLane = meanLengthOnLane;
+    return true;
 }
 
 
@@ -281,6 +304,57 @@ MSMeanData::MeanDataValues::getSamples() const {
 }
 
 
+// ---------------------------------------------------------------------------
+// MSMeanData::MeanDataValueGroup - methods
+// ---------------------------------------------------------------------------
+MSMeanData::MeanDataValueGroup::MeanDataValueGroup(MSLane* const lane)
+    : MSMoveReminder("meandata_" + lane->getID(), lane) {}
+
+
+bool
+MSMeanData::MeanDataValueGroup::removeMember(MeanDataValues* values) {
+    myMembers.erase(std::remove(myMembers.begin(), myMembers.end(), values), myMembers.end());
+    return myMembers.empty();
+}
+
+
+bool
+MSMeanData::MeanDataValueGroup::notifyEnter(SUMOVehicle& veh, MSMoveReminder::Notification reason, const MSLane* enteredLane) {
+    bool result = false;
+    for (std::vector<MeanDataValues*>::const_iterator i = myMembers.begin(); i != myMembers.end(); ++i) {
+        result |= (*i)->notifyEnter(veh, reason, enteredLane);
+    }
+    return result;
+}
+
+
+bool
+MSMeanData::MeanDataValueGroup::notifyMove(SUMOVehicle& veh, double oldPos, double newPos, double newSpeed) {
+    if (myMembers.empty()) {
+        return false;
+    }
+    MeanDataValues::MoveValues values;
+    bool keep = true;
+    if (myMembers.front()->computeMove(veh, oldPos, newPos, newSpeed, values, keep)) {
+        for (std::vector<MeanDataValues*>::const_iterator i = myMembers.begin(); i != myMembers.end(); ++i) {
+            (*i)->notifyMoveInternal(veh, values.frontOnLane, values.timeOnLane, values.meanSpeedFrontOnLane, values.meanSpeedVehicleOnLane,
+                                     values.travelledDistanceFrontOnLane, values.travelledDistanceVehicleOnLane, values.meanLengthOnLane);
+        }
+    }
+    return keep;
+}
+
+
+bool
+MSMeanData::MeanDataValueGroup::notifyLeave(SUMOVehicle& veh, double lastPos, MSMoveReminder::Notification reason, const MSLane* enteredLane) {
+    bool result = false;
+    for (std::vector<MeanDataValues*>::const_iterator i = myMembers.begin(); i != myMembers.end(); ++i) {
+        result |= (*i)->notifyLeave(veh, lastPos, reason, enteredLane);
+    }
+    return result;
+}
+
+
 // ---------------------------------------------------------------------------
 // MSMeanData::MeanDataValueTracker - methods
 // ---------------------------------------------------------------------------
@@ -403,6 +477,12 @@ MSMeanData::MeanDataValueTracker::getSamples() const {
 }
 
 
+// ---------------------------------------------------------------------------
+// MSMeanData - static members
+// ---------------------------------------------------------------------------
+std::map<const MSLane*, MSMeanData::MeanDataValueGroup*> MSMeanData::myLaneGroups;
+
+
 // ---------------------------------------------------------------------------
 // MSMeanData - methods
 // ---------------------------------------------------------------------------
@@ -429,6 +509,9 @@ MSMeanData::MSMeanData(const std::string& id,
 void
 MSMeanData::init() {
     const MSEdgeVector& edges = MSNet::getInstance()->getEdgeControl().getEdges();
+    // untyped collectors of different outputs share one reminder per lane, this is
+    // only done before the first vehicle departs so no vehicle holds the group already
+    const bool fuseLanes = !isTyped() && MSNet::getInstance()->getVehicleControl().getDepartedVehicleNo() == 0;
     for (MSEdgeVector::const_iterator e = edges.begin(); e != edges.end(); ++e) {
         if ((myDumpInternal || !(*e)->isInternal()) && !(*e)->isCrossing() && !(*e)->isWalkingArea()) {
             myEdges.push_back(*e);
@@ -463,6 +546,13 @@ MSMeanData::init() {
                     } else {
                         myMeasures.back().push_back(new MeanDataValueTracker(*lane, (*lane)->getLength(), this));
                     }
+                } else if (fuseLanes) {
+                    MeanDataValueGroup*& group = myLaneGroups[*lane];
+                    if (group == 0) {
+                        group = new MeanDataValueGroup(*lane);
+                    }
+                    myMeasures.back().push_back(createValues(*lane, (*lane)->getLength(), false));
+                    group->addMember(myMeasures.back().back());
                 } else {
                     myMeasures.back().push_back(createValues(*lane, (*lane)->getLength(), true));
                 }
@@ -475,6 +565,11 @@ MSMeanData::init() {
 MSMeanData::~MSMeanData() {
     for (std::vector<std::vector<MeanDataValues*> >::const_iterator i = myMeasures.begin(); i != myMeasures.end(); ++i) {
         for (std::vector<MeanDataValues*>::const_iterator j = (*i).begin(); j != (*i).end(); ++j) {
+            std::map<const MSLane*, MeanDataValueGroup*>::iterator group = myLaneGroups.find((*j)->getLane());
+            if (group != myLaneGroups.end() && group->second->removeMember(*j)) {
+                delete group->second;
+                myLaneGroups.erase(group);
+            }
             delete *j;
         }
     }
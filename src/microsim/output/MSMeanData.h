@@ -29,6 +29,7 @@
 #endif
 
 #include <vector>
+#include <map>
 #include <set>
 #include <list>
 #include <limits>
@@ -72,6 +73,17 @@ public:
      */
     class MeanDataValues : public MSMoveReminder {
     public:
+        /// @brief The values of a single vehicle move as given to notifyMoveInternal
+        struct MoveValues {
+            double frontOnLane;
+            double timeOnLane;
+            double meanSpeedFrontOnLane;
+            double meanSpeedVehicleOnLane;
+            double travelledDistanceFrontOnLane;
+            double travelledDistanceVehicleOnLane;
+            double meanLengthOnLane;
+        };
+
         /** @brief Constructor */
         MeanDataValues(MSLane* const lane, const double length, const bool doAdd, const MSMeanData* const parent);
 
@@ -118,6 +130,23 @@ public:
                         double newPos, double newSpeed);
 
 
+        /** @brief Computes the values of a vehicle move which are passed to notifyMoveInternal
+         *
+         * The values only depend on the vehicle and the lane length, so they
+         *  can be shared by all collectors of a lane.
+         *
+         * @param[in] veh Vehicle that asks this reminder.
+         * @param[in] oldPos Position before move.
+         * @param[in] newPos Position after move with newSpeed.
+         * @param[in] newSpeed Moving speed.
+         * @param[out] into The computed values
+         * @param[out] keep Whether the reminder has to be kept by the vehicle
+         * @return Whether notifyMoveInternal has to be called with the values
+         */
+        bool computeMove(const SUMOVehicle& veh, const double oldPos, const double newPos, const double newSpeed,
+                         MoveValues& into, bool& keep) const;
+
+
         /** @brief Called if the vehicle leaves the reminder's lane
          *
          * @param veh The leaving vehicle.
@@ -183,6 +212,52 @@ public:
     };
 
 
+    /**
+     * @class MeanDataValueGroup
+     * @brief Forwards the notifications of the vehicles on a lane to all grouped value collectors
+     *
+     * Several mean data outputs register one value collector per lane each. Without
+     *  a type filter and without vehicle tracking these react identically on entering,
+     *  moving and leaving vehicles, so they are registered at the lane as a single
+     *  reminder. The lane based integration of a move is then done once per vehicle
+     *  and step for all of them and each vehicle holds one reminder instead of one
+     *  per output.
+     */
+    class MeanDataValueGroup : public MSMoveReminder {
+    public:
+        /// @brief Constructor, adds the group to the lane
+        MeanDataValueGroup(MSLane* const lane);
+
+        /// @brief Adds the given value collector (which has not been added to the lane itself)
+        void addMember(MeanDataValues* values) {
+            myMembers.push_back(values);
+        }
+
+        /// @brief Removes the given value collector and returns whether the group is empty
+        bool removeMember(MeanDataValues* values);
+
+        /// @name Methods inherited from MSMoveReminder, forwarding to all members
+        /// @{
+        bool notifyEnter(SUMOVehicle& veh, MSMoveReminder::Notification reason, const MSLane* enteredLane = 0);
+
+        bool notifyMove(SUMOVehicle& veh, double oldPos, double newPos, double newSpeed);
+
+        bool notifyLeave(SUMOVehicle& veh, double lastPos, MSMoveReminder::Notification reason, const MSLane* enteredLane = 0);
+        /// @}
+
+    private:
+        /// @brief The grouped value collectors
+        std::vector<MeanDataValues*> myMembers;
+
+    private:
+        /// @brief Invalidated copy constructor.
+        MeanDataValueGroup(const MeanDataValueGroup&);
+
+        /// @brief Invalidated assignment operator.
+        MeanDataValueGroup& operator=(const MeanDataValueGroup&);
+    };
+
+
     /**
      * @class MeanDataValueTracker
      * @brief Data structure for mean (aggregated) edge/lane values for tracked vehicles
@@ -456,6 +531,9 @@ private:
     /// @brief The intervals for which output still has to be generated (only in the tracking case)
     std::list< std::pair<SUMOTime, SUMOTime> > myPendingIntervals;
 
+    /// @brief The value collector groups of the lanes (shared by all mean data outputs)
+    static std::map<const MSLane*, MeanDataValueGroup*> myLaneGroups;
+
 private:
     /// @brief Invalidated copy constructor.
     MSMeanData(const MSMeanData&);
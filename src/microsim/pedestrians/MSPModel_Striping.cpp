@@ -120,6 +120,13 @@ MSPModel_Striping::MSPModel_Striping(const OptionsCont& oc, MSNet* net) :
     if (jamTime <= 0) {
         jamTime = SUMOTime_MAX;
     }
+#ifdef HAVE_FOX
+    if (MSGlobals::gNumSimThreads > 1) {
+        while (myThreadPool.size() < MSGlobals::gNumSimThreads) {
+            new FXWorkerThread(myThreadPool);
+        }
+    }
+#endif
 }
 
 
@@ -548,11 +555,11 @@ MSPModel_Striping::getNextWalkingArea(const MSLane* currentLane, const int dir,
 }
 
 
-MSPModel_Striping::Obstacles
-MSPModel_Striping::getNeighboringObstacles(const Pedestrians& pedestrians, int egoIndex, int stripes) {
+void
+MSPModel_Striping::getNeighboringObstacles(const Pedestrians& pedestrians, int egoIndex, int stripes, Obstacles& obs, std::vector<bool>& haveBlocker) {
     const PState& ego = *pedestrians[egoIndex];
-    Obstacles obs(stripes, Obstacle(ego.myDir));
-    std::vector<bool> haveBlocker(stripes, false);
+    obs.assign(stripes, Obstacle(ego.myDir));
+    haveBlocker.assign(stripes, false);
     for (int index = egoIndex + 1; index < (int)pedestrians.size(); index++) {
         const PState& p = *pedestrians[index];
         if DEBUGCOND(ego) {
@@ -584,7 +591,6 @@ MSPModel_Striping::getNeighboringObstacles(const Pedestrians& pedestrians, int e
         std::cout << SIMTIME << " ped=" << ego.myPerson->getID() << "  neighObs=";
         DEBUG_PRINT(obs);
     }
-    return obs;
 }
 
 
@@ -601,7 +607,7 @@ MSPModel_Striping::getStripeOffset(int origStripes, int destStripes, bool addRem
 const MSPModel_Striping::Obstacles&
 MSPModel_Striping::getNextLaneObstacles(NextLanesObstacles& nextLanesObs, const
                                         MSLane* lane, const MSLane* nextLane, int stripes, int nextDir,
-                                        double currentLength, int currentDir) {
+                                        double currentLength, int currentDir, const bool useSnapshot) {
     if (nextLanesObs.count(nextLane) == 0) {
         const double nextLength = nextLane->getEdge().isWalkingArea() ? myMinNextLengths[nextLane] : nextLane->getLength();
         // figure out the which pedestrians are ahead on the next lane
@@ -628,7 +634,16 @@ MSPModel_Striping::getNextLaneObstacles(NextLanesObstacles& nextLanesObs, const
                 }
             }
         }
-        Pedestrians& pedestrians = getPedestrians(nextLane);
+        Pedestrians snapshot;
+        if (useSnapshot) {
+            LaneSnapshots::iterator it = mySnapshots.find(nextLane);
+            if (it != mySnapshots.end()) {
+                for (std::vector<PState>::iterator it_p = it->second.begin(); it_p != it->second.end(); ++it_p) {
+                    snapshot.push_back(&*it_p);
+                }
+            }
+        }
+        Pedestrians& pedestrians = useSnapshot ? snapshot : getPedestrians(nextLane);
         if (nextLane->getEdge().isWalkingArea()) {
             transformToCurrentLanePositions(obs, currentDir, nextDir, currentLength, nextLength);
             // complex transformation into the coordinate system of the current lane
@@ -683,7 +698,8 @@ MSPModel_Striping::getNextLaneObstacles(NextLanesObstacles& nextLanesObs, const
                 addCrossingVehs(nextLane, stripes, offset, nextDir, obs);
             }
             if (nextLane->getVehicleNumberWithPartials() > 0) {
-                Obstacles vehObs = getVehicleObstacles(nextLane, nextDir);
+                Obstacles vehObs;
+                getVehicleObstacles(nextLane, nextDir, 0, vehObs);
                 PState::mergeObstacles(obs, vehObs, nextDir, offset);
             }
             transformToCurrentLanePositions(obs, currentDir, nextDir, currentLength, nextLength);
@@ -731,77 +747,175 @@ MSPModel_Striping::addCloserObstacle(Obstacles& obs, double x, int stripe, int n
 
 void
 MSPModel_Striping::moveInDirection(SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir) {
+    if (MSGlobals::gNumSimThreads <= 1) {
+        for (ActiveLanes::iterator it_lane = myActiveLanes.begin(); it_lane != myActiveLanes.end(); ++it_lane) {
+            if (it_lane->second.size() > 0) {
+                moveLane(it_lane->first, it_lane->second, currentTime, changedLane, dir, 0);
+            }
+        }
+        return;
+    }
+    // all lanes are moved based on the state before the first lane was moved
+    // and the changes are applied in lane order afterwards, so the result does not depend on the number of threads
+    buildSnapshots(dir);
+    myLaneUpdates.clear();
     for (ActiveLanes::iterator it_lane = myActiveLanes.begin(); it_lane != myActiveLanes.end(); ++it_lane) {
-        const MSLane* lane = it_lane->first;
-        Pedestrians& pedestrians = it_lane->second;
-        if (pedestrians.size() == 0) {
-            continue;
+        if (it_lane->second.size() > 0) {
+            myLaneUpdates.push_back(LaneUpdate(it_lane->first, &it_lane->second));
         }
-        //std::cout << SIMTIME << ">>> lane=" << lane->getID() << " numPeds=" << pedestrians.size() << "\n";
-        if (lane->getEdge().isWalkingArea()) {
-            const double lateral_offset = (lane->getWidth() - stripeWidth) * 0.5;
-            const double minY = stripeWidth * - 0.5 + NUMERICAL_EPS;
-            const double maxY = stripeWidth * (numStripes(lane) - 0.5) - NUMERICAL_EPS;
-            const WalkingAreaPath* debugPath = 0;
-            // need to handle each walkingAreaPath seperately and transform
-            // coordinates beforehand
-            std::set<const WalkingAreaPath*, walkingarea_path_sorter> paths;
-            for (Pedestrians::iterator it = pedestrians.begin(); it != pedestrians.end(); ++it) {
-                const PState* p = *it;
-                assert(p->myWalkingAreaPath != 0);
-                if (p->myDir == dir) {
-                    paths.insert(p->myWalkingAreaPath);
-                    if DEBUGCOND(*p) {
-                        debugPath = p->myWalkingAreaPath;
-                        std::cout << SIMTIME << " debugging WalkingAreaPath from=" << debugPath->from->getID() << " to=" << debugPath->to->getID() << "\n";
-                    }
+    }
+#ifdef HAVE_FOX
+    if (myThreadPool.size() > 0) {
+        // lanes sharing a random number generator go to the same thread (in lane order)
+        for (std::vector<LaneUpdate>::iterator i = myLaneUpdates.begin(); i != myLaneUpdates.end(); ++i) {
+            myThreadPool.add(new MoveLaneTask(*this, *i, currentTime, changedLane, dir), i->lane->getRNGIndex() % myThreadPool.size());
+        }
+        myThreadPool.waitAll();
+    } else {
+#endif
+        for (std::vector<LaneUpdate>::iterator i = myLaneUpdates.begin(); i != myLaneUpdates.end(); ++i) {
+            moveLane(i->lane, *i->pedestrians, currentTime, changedLane, dir, &*i);
+        }
+#ifdef HAVE_FOX
+    }
+#endif
+    mySnapshots.clear();
+    for (std::vector<LaneUpdate>::const_iterator i = myLaneUpdates.begin(); i != myLaneUpdates.end(); ++i) {
+        applyUpdate(*i, currentTime, changedLane);
+    }
+}
+
+
+void
+MSPModel_Striping::moveLane(const MSLane* lane, Pedestrians& pedestrians, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir, LaneUpdate* update) {
+    //std::cout << SIMTIME << ">>> lane=" << lane->getID() << " numPeds=" << pedestrians.size() << "\n";
+    if (lane->getEdge().isWalkingArea()) {
+        const double lateral_offset = (lane->getWidth() - stripeWidth) * 0.5;
+        const double minY = stripeWidth * - 0.5 + NUMERICAL_EPS;
+        const double maxY = stripeWidth * (numStripes(lane) - 0.5) - NUMERICAL_EPS;
+        const WalkingAreaPath* debugPath = 0;
+        // need to handle each walkingAreaPath seperately and transform
+        // coordinates beforehand
+        std::set<const WalkingAreaPath*, walkingarea_path_sorter> paths;
+        for (Pedestrians::iterator it = pedestrians.begin(); it != pedestrians.end(); ++it) {
+            const PState* p = *it;
+            assert(p->myWalkingAreaPath != 0);
+            if (p->myDir == dir) {
+                paths.insert(p->myWalkingAreaPath);
+                if DEBUGCOND(*p) {
+                    debugPath = p->myWalkingAreaPath;
+                    std::cout << SIMTIME << " debugging WalkingAreaPath from=" << debugPath->from->getID() << " to=" << debugPath->to->getID() << "\n";
                 }
             }
-            for (std::set<const WalkingAreaPath*, walkingarea_path_sorter>::iterator it = paths.begin(); it != paths.end(); ++it) {
-                const WalkingAreaPath* path = *it;
-                Pedestrians toDelete;
-                Pedestrians transformedPeds;
-                transformedPeds.reserve(pedestrians.size());
-                for (Pedestrians::iterator it_p = pedestrians.begin(); it_p != pedestrians.end(); ++it_p) {
-                    PState* p = *it_p;
-                    if (p->myWalkingAreaPath == path
-                            // opposite direction is already in the correct coordinate system
-                            || (p->myWalkingAreaPath->from == path->to && p->myWalkingAreaPath->to == path->from)) {
-                        transformedPeds.push_back(p);
-                        if (path == debugPath) std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << p->myRelX << " relY=" << p->myRelY << " (untransformed), vecCoord="
-                                                             << path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1)) << "\n";
+        }
+        for (std::set<const WalkingAreaPath*, walkingarea_path_sorter>::iterator it = paths.begin(); it != paths.end(); ++it) {
+            const WalkingAreaPath* path = *it;
+            Pedestrians toDelete;
+            Pedestrians transformedPeds;
+            transformedPeds.reserve(pedestrians.size());
+            for (Pedestrians::iterator it_p = pedestrians.begin(); it_p != pedestrians.end(); ++it_p) {
+                PState* p = *it_p;
+                if (p->myWalkingAreaPath == path
+                        // opposite direction is already in the correct coordinate system
+                        || (p->myWalkingAreaPath->from == path->to && p->myWalkingAreaPath->to == path->from)) {
+                    transformedPeds.push_back(p);
+                    if (path == debugPath) std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << p->myRelX << " relY=" << p->myRelY << " (untransformed), vecCoord="
+                                                         << path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1)) << "\n";
+                } else {
+                    const Position relPos = path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1));
+                    const double newY = relPos.y() + lateral_offset;
+                    if (relPos != Position::INVALID && newY >= minY && newY <= maxY) {
+                        PState* tp = new PState(*p);
+                        tp->myRelX = relPos.x();
+                        tp->myRelY = newY;
+                        // only an obstacle, speed may be orthogonal to dir
+                        tp->myDir = !dir;
+                        tp->mySpeed = 0;
+                        toDelete.push_back(tp);
+                        transformedPeds.push_back(tp);
+                        if (path == debugPath) {
+                            std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << relPos.x() << " relY=" << newY << " (transformed), vecCoord=" << relPos << "\n";
+                        }
                     } else {
-                        const Position relPos = path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1));
-                        const double newY = relPos.y() + lateral_offset;
-                        if (relPos != Position::INVALID && newY >= minY && newY <= maxY) {
-                            PState* tp = new PState(*p);
-                            tp->myRelX = relPos.x();
-                            tp->myRelY = newY;
-                            // only an obstacle, speed may be orthogonal to dir
-                            tp->myDir = !dir;
-                            tp->mySpeed = 0;
-                            toDelete.push_back(tp);
-                            transformedPeds.push_back(tp);
-                            if (path == debugPath) {
-                                std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << relPos.x() << " relY=" << newY << " (transformed), vecCoord=" << relPos << "\n";
-                            }
-                        } else {
-                            if (path == debugPath) {
-                                std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << relPos.x() << " relY=" << newY << " (invalid), vecCoord=" << relPos << "\n";
-                            }
+                        if (path == debugPath) {
+                            std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << relPos.x() << " relY=" << newY << " (invalid), vecCoord=" << relPos << "\n";
                         }
                     }
                 }
-                moveInDirectionOnLane(transformedPeds, lane, currentTime, changedLane, dir);
+            }
+            moveInDirectionOnLane(transformedPeds, lane, currentTime, changedLane, dir, update);
+            if (update == 0) {
                 arriveAndAdvance(pedestrians, currentTime, changedLane, dir);
-                // clean up
-                for (Pedestrians::iterator it_p = toDelete.begin(); it_p != toDelete.end(); ++it_p) {
-                    delete *it_p;
+            } else {
+                collectLeaving(pedestrians, dir, update->leaving);
+            }
+            // clean up
+            for (Pedestrians::iterator it_p = toDelete.begin(); it_p != toDelete.end(); ++it_p) {
+                delete *it_p;
+            }
+        }
+    } else {
+        moveInDirectionOnLane(pedestrians, lane, currentTime, changedLane, dir, update);
+        if (update == 0) {
+            arriveAndAdvance(pedestrians, currentTime, changedLane, dir);
+        } else {
+            collectLeaving(pedestrians, dir, update->leaving);
+        }
+    }
+}
+
+
+void
+MSPModel_Striping::buildSnapshots(int dir) {
+    mySnapshots.clear();
+    for (ActiveLanes::const_iterator it_lane = myActiveLanes.begin(); it_lane != myActiveLanes.end(); ++it_lane) {
+        for (Pedestrians::const_iterator it_p = it_lane->second.begin(); it_p != it_lane->second.end(); ++it_p) {
+            const MSLane* nextLane = (*it_p)->myNLI.lane;
+            if ((*it_p)->myDir == dir && nextLane != 0 && mySnapshots.count(nextLane) == 0) {
+                const Pedestrians& nextPeds = getPedestrians(nextLane);
+                std::vector<PState>& snapshot = mySnapshots[nextLane];
+                snapshot.reserve(nextPeds.size());
+                for (Pedestrians::const_iterator it_next = nextPeds.begin(); it_next != nextPeds.end(); ++it_next) {
+                    snapshot.push_back(**it_next);
                 }
             }
+        }
+    }
+}
+
+
+void
+MSPModel_Striping::collectLeaving(Pedestrians& pedestrians, int dir, Pedestrians& leaving) {
+    sort(pedestrians.begin(), pedestrians.end(), by_xpos_sorter(dir));
+    for (Pedestrians::iterator it = pedestrians.begin(); it != pedestrians.end();) {
+        if ((*it)->myDir == dir && (*it)->distToLaneEnd() < 0) {
+            leaving.push_back(*it);
+            it = pedestrians.erase(it);
         } else {
-            moveInDirectionOnLane(pedestrians, lane, currentTime, changedLane, dir);
-            arriveAndAdvance(pedestrians, currentTime, changedLane, dir);
+            ++it;
+        }
+    }
+}
+
+
+void
+MSPModel_Striping::applyUpdate(const LaneUpdate& update, SUMOTime currentTime, std::set<MSPerson*>& changedLane) {
+    for (int i = 0; i < update.numJammed; i++) {
+        MSNet::getInstance()->getPersonControl().registerJammed();
+    }
+    for (std::vector<std::string>::const_iterator it = update.warnings.begin(); it != update.warnings.end(); ++it) {
+        WRITE_WARNING(*it);
+    }
+    for (Pedestrians::const_iterator it = update.leaving.begin(); it != update.leaving.end(); ++it) {
+        PState* const p = *it;
+        p->moveToNextLane(currentTime);
+        if (p->myLane != 0) {
+            changedLane.insert(p->myPerson);
+            myActiveLanes[p->myLane].push_back(p);
+        } else {
+            // end walking stage and destroy PState
+            p->myStage->moveToNextEdge(p->myPerson, currentTime);
+            myNumActivePedestrians--;
         }
     }
 }
@@ -834,7 +948,7 @@ MSPModel_Striping::arriveAndAdvance(Pedestrians& pedestrians, SUMOTime currentTi
 
 
 void
-MSPModel_Striping::moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane* lane, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir) {
+MSPModel_Striping::moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane* lane, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir, LaneUpdate* update) {
     const int stripes = numStripes(lane);
     //std::cout << " laneWidth=" << lane->getWidth() << " stripeWidth=" << stripeWidth << " stripes=" << stripes << "\n";
     Obstacles obs(stripes, Obstacle(dir)); // continously updated
@@ -846,11 +960,16 @@ MSPModel_Striping::moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane*
     if (lane->getEdge().isCrossing()) {
         hasCrossingVehObs = addCrossingVehs(lane, stripes, 0, dir, crossingVehs);
     }
+    // buffers reused for all pedestrians of the lane
+    Obstacles currentObs;
+    Obstacles neighObs;
+    Obstacles vehObs;
+    std::vector<bool> haveBlocker;
 
     for (int ii = 0; ii < (int)pedestrians.size(); ++ii) {
         PState& p = *pedestrians[ii];
         //std::cout << SIMTIME << "CHECKING" << p.myPerson->getID() << "\n";
-        Obstacles currentObs = obs;
+        currentObs = obs;
         if (p.myDir != dir || changedLane.count(p.myPerson) != 0) {
             if (!p.myWaitingToEnter) {
                 //if DEBUGCOND(p) {
@@ -879,7 +998,7 @@ MSPModel_Striping::moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane*
             const double currentLength = (p.myWalkingAreaPath == 0 ? lane->getLength() : p.myWalkingAreaPath->length);
             const Obstacles& nextObs = getNextLaneObstacles(
                                            nextLanesObs, lane, nextLane, stripes,
-                                           p.myNLI.dir, currentLength, dir);
+                                           p.myNLI.dir, currentLength, dir, update != 0);
 
             if DEBUGCOND(p) {
                 std::cout << SIMTIME << " ped=" << p.myPerson->getID() << "  nextObs=";
@@ -891,7 +1010,8 @@ MSPModel_Striping::moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane*
             std::cout << SIMTIME << " ped=" << p.myPerson->getID() << "  obsWithNext=";
             DEBUG_PRINT(currentObs);
         }
-        p.mergeObstacles(currentObs, getNeighboringObstacles(pedestrians, ii, stripes));
+        getNeighboringObstacles(pedestrians, ii, stripes, neighObs, haveBlocker);
+        p.mergeObstacles(currentObs, neighObs);
         if DEBUGCOND(p) {
             std::cout << SIMTIME << " ped=" << p.myPerson->getID() << "  obsWithNeigh=";
             DEBUG_PRINT(currentObs);
@@ -933,7 +1053,7 @@ MSPModel_Striping::moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane*
         if (lane->getVehicleNumberWithPartials() > 0) {
             // react to vehicles on the same lane
             // @todo: improve efficiency by using the same iterator for all pedestrians on this lane
-            Obstacles vehObs = getVehicleObstacles(lane, dir, &p);
+            getVehicleObstacles(lane, dir, &p, vehObs);
             p.mergeObstacles(currentObs, vehObs);
             if DEBUGCOND(p) {
                 std::cout << SIMTIME << " ped=" << p.myPerson->getID() << "  obsWithVehs=";
@@ -949,8 +1069,25 @@ MSPModel_Striping::moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane*
         }
 
         // walk, taking into account all obstacles
-        p.walk(currentObs, currentTime);
-        gDebugFlag1 = false;
+        const bool wasJammed = p.myAmJammed;
+        // moving in parallel uses the generator of the lane, the sequential step keeps the global one
+        p.walk(currentObs, currentTime, update == 0 ? 0 : lane->getRNG());
+        if (update == 0 || DEBUGCOND(p)) {
+            // worker threads only touch the global debug flag when debugging
+            gDebugFlag1 = false;
+        }
+        if (p.myAmJammed && !wasJammed) {
+            const std::string warning = "Person '" + p.myPerson->getID()
+                                        + "' is jammed on edge '" + p.myStage->getEdge()->getID()
+                                        + "', time=" + time2string(MSNet::getInstance()->getCurrentTimeStep()) + ".";
+            if (update == 0) {
+                MSNet::getInstance()->getPersonControl().registerJammed();
+                WRITE_WARNING(warning);
+            } else {
+                update->numJammed++;
+                update->warnings.push_back(warning);
+            }
+        }
         if (!p.myWaitingToEnter && !p.myAmJammed) {
             Obstacle o(p);
             obs[p.stripe()] = o;
@@ -963,8 +1100,13 @@ MSPModel_Striping::moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane*
                             Obstacle cObs(c);
                             // we check only for real collisions, no min gap violations
                             if (p.distanceTo(cObs, false) == DIST_OVERLAP) {
-                                WRITE_WARNING("Collision of person '" + p.myPerson->getID() + "' and person '" + c.myPerson->getID()
-                                              + "', lane='" + lane->getID() + "', time=" + time2string(currentTime) + ".");
+                                const std::string warning = "Collision of person '" + p.myPerson->getID() + "' and person '" + c.myPerson->getID()
+                                                            + "', lane='" + lane->getID() + "', time=" + time2string(currentTime) + ".";
+                                if (update == 0) {
+                                    WRITE_WARNING(warning);
+                                } else {
+                                    update->warnings.push_back(warning);
+                                }
                             }
                         }
                     }
@@ -1031,10 +1173,10 @@ MSPModel_Striping::addCrossingVehs(const MSLane* crossing, int stripes, double l
 }
 
 
-MSPModel_Striping::Obstacles 
-MSPModel_Striping::getVehicleObstacles(const MSLane* lane, int dir, PState* ped) {
+void
+MSPModel_Striping::getVehicleObstacles(const MSLane* lane, int dir, PState* ped, Obstacles& vehObs) {
     const int stripes = numStripes(lane);
-    Obstacles vehObs(stripes, Obstacle(dir));
+    vehObs.assign(stripes, Obstacle(dir));
     int current = -1;
     double minX = 0.;
     double maxX = 0.;
@@ -1104,7 +1246,6 @@ MSPModel_Striping::getVehicleObstacles(const MSLane* lane, int dir, PState* ped)
             }
         }
     }
-    return vehObs;
 }
 
 
@@ -1403,7 +1544,7 @@ MSPModel_Striping::PState::moveToNextLane(SUMOTime currentTime) {
 
 
 void
-MSPModel_Striping::PState::walk(const Obstacles& obs, SUMOTime currentTime) {
+MSPModel_Striping::PState::walk(const Obstacles& obs, SUMOTime currentTime, std::mt19937* rng) {
     const int stripes = (int)obs.size();
     const int sMax =  stripes - 1;
     assert(stripes == numStripes(myLane));
@@ -1520,20 +1661,15 @@ MSPModel_Striping::PState::walk(const Obstacles& obs, SUMOTime currentTime) {
     if (xSpeed == 0) {
         if (myWaitingTime > jamTime || myAmJammed) {
             // squeeze slowly through the crowd ignoring others
-            if (!myAmJammed) {
-                MSNet::getInstance()->getPersonControl().registerJammed();
-                WRITE_WARNING("Person '" + myPerson->getID()
-                              + "' is jammed on edge '" + myStage->getEdge()->getID()
-                              + "', time=" + time2string(MSNet::getInstance()->getCurrentTimeStep()) + ".");
-                myAmJammed = true;
-            }
+            // the caller registers the jam
+            myAmJammed = true;
             xSpeed = vMax / 4;
         }
     } else if (stripe(myRelY) >= 0 && stripe(myRelY) <= sMax)  {
         myAmJammed = false;
     }
     // dawdling
-    const double dawdle = MIN2(xSpeed, RandHelper::rand() * vMax * dawdling);
+    const double dawdle = MIN2(xSpeed, RandHelper::rand(rng) * vMax * dawdling);
     xSpeed -= dawdle;
 
     // XXX ensure that diagonal speed <= vMax
@@ -33,6 +33,9 @@
 #include <utils/common/Command.h>
 #include <utils/options/OptionsCont.h>
 #include <microsim/MSLane.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXWorkerThread.h>
+#endif
 #include "MSPerson.h"
 #include "MSPModel.h"
 
@@ -167,6 +170,7 @@ protected:
     typedef std::map<const MSLane*, Obstacles, lane_by_numid_sorter> NextLanesObstacles;
     typedef std::map<std::pair<const MSLane*, const MSLane*>, WalkingAreaPath> WalkingAreaPaths;
     typedef std::map<const MSLane*, double> MinNextLengths;
+    typedef std::map<const MSLane*, std::vector<PState>, lane_by_numid_sorter> LaneSnapshots;
 
     struct NextLaneInfo {
         NextLaneInfo(const MSLane* _lane, const MSLink* _link, int _dir) :
@@ -322,8 +326,8 @@ protected:
         /// @brief return whether this pedestrian has passed the end of the current lane and update myRelX if so
         bool moveToNextLane(SUMOTime currentTime);
 
-        /// @brief perform position update
-        void walk(const Obstacles& obs, SUMOTime currentTime);
+        /// @brief perform position update (drawing random numbers from the given generator, 0 for the global one)
+        void walk(const Obstacles& obs, SUMOTime currentTime, std::mt19937* rng);
 
         /// @brief returns the impatience
         double getImpatience(SUMOTime now) const;
@@ -388,15 +392,72 @@ protected:
     };
 
 
+    /** @brief the changes resulting from moving the pedestrians of one lane
+     * which are applied after all lanes have been moved (if running with threads)
+     */
+    struct LaneUpdate {
+        LaneUpdate(const MSLane* _lane, Pedestrians* _pedestrians) :
+            lane(_lane), pedestrians(_pedestrians), numJammed(0) {}
+
+        const MSLane* lane;
+        Pedestrians* pedestrians;
+        /// @brief the pedestrians which passed the end of the lane in the order of their advancement
+        Pedestrians leaving;
+        /// @brief the warnings to write in the order of their occurence
+        std::vector<std::string> warnings;
+        /// @brief the number of pedestrians which became jammed
+        int numJammed;
+    };
+
     /// @brief move all pedestrians forward and advance to the next lane if applicable
     void moveInDirection(SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir);
 
+    /** @brief move the pedestrians of one lane (of all paths for walkingAreas) forward
+     * @note if update is given, the lane may be moved concurrently to other lanes,
+     *  pedestrians on other lanes are only seen as they were before the first lane was moved
+     *  and all changes to the state of the model are collected in update
+     */
+    void moveLane(const MSLane* lane, Pedestrians& pedestrians, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir, LaneUpdate* update);
+
     /// @brief move pedestrians forward on one lane
-    void moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane* lane, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir);
+    void moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane* lane, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir, LaneUpdate* update);
 
     /// @brief handle arrivals and lane advancement
     void arriveAndAdvance(Pedestrians& pedestrians, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir);
 
+    /// @brief removes the pedestrians which passed the end of the lane (for a later advancement)
+    static void collectLeaving(Pedestrians& pedestrians, int dir, Pedestrians& leaving);
+
+    /// @brief writes the warnings, registers the jams and advances the leaving pedestrians of a moved lane
+    void applyUpdate(const LaneUpdate& update, SUMOTime currentTime, std::set<MSPerson*>& changedLane);
+
+    /// @brief stores the current state of the pedestrians on the lanes which may be the next lane of a pedestrian walking in dir
+    void buildSnapshots(int dir);
+
+#ifdef HAVE_FOX
+    /**
+     * @class MoveLaneTask
+     * @brief The task for moving the pedestrians of a lane in a worker thread
+     */
+    class MoveLaneTask : public FXWorkerThread::Task {
+    public:
+        MoveLaneTask(MSPModel_Striping& model, LaneUpdate& update, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir)
+            : myModel(model), myUpdate(update), myTime(currentTime), myChangedLane(changedLane), myDir(dir) {}
+        void run(FXWorkerThread* /*context*/) {
+            myModel.moveLane(myUpdate.lane, *myUpdate.pedestrians, myTime, myChangedLane, myDir, &myUpdate);
+        }
+    private:
+        MSPModel_Striping& myModel;
+        LaneUpdate& myUpdate;
+        const SUMOTime myTime;
+        std::set<MSPerson*>& myChangedLane;
+        const int myDir;
+    private:
+        /// @brief Invalidated assignment operator.
+        MoveLaneTask& operator=(const MoveLaneTask&) = delete;
+    };
+#endif
+
     const ActiveLanes& getActiveLanes() {
         return myActiveLanes;
     }
@@ -425,10 +486,11 @@ private:
     /// @brief return the maximum number of pedestrians walking side by side
     static int numStripes(const MSLane* lane);
 
-    static Obstacles getNeighboringObstacles(const Pedestrians& pedestrians, int egoIndex, int stripes);
+    /// @brief fills obs with the closest pedestrians ahead of the given one (haveBlocker is just a reusable buffer)
+    static void getNeighboringObstacles(const Pedestrians& pedestrians, int egoIndex, int stripes, Obstacles& obs, std::vector<bool>& haveBlocker);
 
     const Obstacles& getNextLaneObstacles(NextLanesObstacles& nextLanesObs, const MSLane* lane, const MSLane* nextLane, int stripes,
-                                          int nextDir, double currentLength, int currentDir);
+                                          int nextDir, double currentLength, int currentDir, const bool useSnapshot);
 
     static void transformToCurrentLanePositions(Obstacles& o, int currentDir, int nextDir, double currentLength, double nextLength);
 
@@ -447,7 +509,7 @@ private:
     static bool addCrossingVehs(const MSLane* crossing, int stripes, double lateral_offset, int dir, Obstacles& crossingVehs);
 
     ///@brief retrieve vehicle obstacles on the given lane
-    static Obstacles getVehicleObstacles(const MSLane* lane, int dir, PState* ped = 0); 
+    static void getVehicleObstacles(const MSLane* lane, int dir, PState* ped, Obstacles& vehObs);
 private:
     /// @brief the total number of active pedestrians
     int myNumActivePedestrians;
@@ -455,6 +517,17 @@ private:
     /// @brief store of all lanes which have pedestrians on them
     ActiveLanes myActiveLanes;
 
+    /// @brief the pedestrians of possible next lanes as they were before moving the lanes in parallel
+    LaneSnapshots mySnapshots;
+
+    /// @brief the changes of the lanes moved in parallel (reused)
+    std::vector<LaneUpdate> myLaneUpdates;
+
+#ifdef HAVE_FOX
+    /// @brief the pool for moving the lanes in parallel
+    FXWorkerThread::Pool myThreadPool;
+#endif
+
     /// @brief store for walkinArea elements
     static WalkingAreaPaths myWalkingAreaPaths;
     static MinNextLengths myMinNextLengths;
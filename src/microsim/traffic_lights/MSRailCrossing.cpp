@@ -96,7 +96,7 @@ MSRailCrossing::updateCurrentPhase() {
     // check rail links for approaching foes to determine whether and how long
     // the crossing must remain closed
     for (std::vector<MSLink*>::const_iterator it_link = myIncomingRailLinks.begin(); it_link != myIncomingRailLinks.end(); ++it_link) {
-        for (std::map<const SUMOVehicle*, MSLink::ApproachingVehicleInformation>::const_iterator
+        for (MSLink::ApproachInfos::const_iterator
                 it_avi = (*it_link)->getApproaching().begin();
                 it_avi != (*it_link)->getApproaching().end(); ++it_avi) {
             const MSLink::ApproachingVehicleInformation& avi = it_avi->second;
@@ -124,13 +124,45 @@ NBTurningDirectionsComputer::computeTurnDirectionsForNode(NBNode* node, bool war
 // NBNodesEdgesSorter
 // ---------------------------------------------------------------------------
 void
-NBNodesEdgesSorter::sortNodesEdges(NBNodeCont& nc, bool useNodeShape) {
+NBNodesEdgesSorter::sortNodesEdges(NBNodeCont& nc, bool useNodeShape, const int numThreads) {
+#ifdef HAVE_FOX
+    const int numNodes = nc.size();
+    if (!useNodeShape && numThreads > 1 && numNodes > numThreads) {
+        FXWorkerThread::Pool threadPool(numThreads);
+        const int chunkSize = MAX2(1, numNodes / (4 * numThreads));
+        std::vector<NBNode*> chunk;
+        for (std::map<std::string, NBNode*>::const_iterator i = nc.begin(); i != nc.end(); ++i) {
+            chunk.push_back(i->second);
+            if ((int)chunk.size() == chunkSize) {
+                threadPool.add(new SortTask(chunk));
+                chunk.clear();
+            }
+        }
+        if (!chunk.empty()) {
+            threadPool.add(new SortTask(chunk));
+        }
+        threadPool.waitAll();
+        return;
+    }
+#else
+    UNUSED_PARAMETER(numThreads);
+#endif
     for (std::map<std::string, NBNode*>::const_iterator i = nc.begin(); i != nc.end(); ++i) {
         i->second->sortEdges(useNodeShape);
     }
 }
 
 
+#ifdef HAVE_FOX
+void
+NBNodesEdgesSorter::SortTask::run(FXWorkerThread* /* context */) {
+    for (std::vector<NBNode*>::const_iterator i = myNodes.begin(); i != myNodes.end(); ++i) {
+        (*i)->sortEdges(false);
+    }
+}
+#endif
+
+
 void
 NBNodesEdgesSorter::swapWhenReversed(const NBNode* const n,
                                      const std::vector<NBEdge*>::iterator& i1,
@@ -29,8 +29,12 @@
 #endif
 
 #include <map>
+#include <vector>
 #include "NBEdgeCont.h"
 #include "NBNodeCont.h"
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXWorkerThread.h>
+#endif
 
 // ===========================================================================
 // class declarations
@@ -107,8 +111,10 @@ public:
     /** @brief Sorts a node's edges clockwise regarding driving direction
      * @param[in] nc The container of nodes to loop along
      * @param[in] useNodeShape Whether to sort based on the node shape (instead of only the edge angle)
+     * @param[in] numThreads The number of threads to use, only effective if the node shape is not used
+     *  since resorting may then recompute the shapes of edges shared with other nodes
      */
-    static void sortNodesEdges(NBNodeCont& nc, bool useNodeShape = false);
+    static void sortNodesEdges(NBNodeCont& nc, bool useNodeShape = false, const int numThreads = 0);
 
     /** @class crossing_by_junction_angle_sorter
      * @brief Sorts crossings by minimum clockwise clockwise edge angle. Use the
@@ -194,6 +200,24 @@ public:
 
     };
 
+#ifdef HAVE_FOX
+private:
+    /**
+     * @class SortTask
+     * @brief Sorts the edges of a range of nodes (every node only modifies its own edge vectors)
+     */
+    class SortTask : public FXWorkerThread::Task {
+    public:
+        SortTask(const std::vector<NBNode*>& nodes) : myNodes(nodes) {}
+        void run(FXWorkerThread* context);
+    private:
+        const std::vector<NBNode*> myNodes;
+    private:
+        /// @brief Invalidated assignment operator.
+        SortTask& operator=(const SortTask&);
+    };
+#endif
+
 };
 
 
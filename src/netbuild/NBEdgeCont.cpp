@@ -765,13 +765,44 @@ NBEdgeCont::sortOutgoingLanesConnections() {
 
 
 void
-NBEdgeCont::computeEdge2Edges(bool noLeftMovers) {
+NBEdgeCont::computeEdge2Edges(bool noLeftMovers, const int numThreads) {
+#ifdef HAVE_FOX
+    if (numThreads > 1 && (int)myEdges.size() > numThreads) {
+        FXWorkerThread::Pool threadPool(numThreads);
+        const int chunkSize = MAX2(1, (int)myEdges.size() / (4 * numThreads));
+        std::vector<NBEdge*> chunk;
+        for (EdgeCont::iterator i = myEdges.begin(); i != myEdges.end(); i++) {
+            chunk.push_back((*i).second);
+            if ((int)chunk.size() == chunkSize) {
+                threadPool.add(new Edge2EdgesTask(chunk, noLeftMovers));
+                chunk.clear();
+            }
+        }
+        if (!chunk.empty()) {
+            threadPool.add(new Edge2EdgesTask(chunk, noLeftMovers));
+        }
+        threadPool.waitAll();
+        return;
+    }
+#else
+    UNUSED_PARAMETER(numThreads);
+#endif
     for (EdgeCont::iterator i = myEdges.begin(); i != myEdges.end(); i++) {
         (*i).second->computeEdge2Edges(noLeftMovers);
     }
 }
 
 
+#ifdef HAVE_FOX
+void
+NBEdgeCont::Edge2EdgesTask::run(FXWorkerThread* /* context */) {
+    for (std::vector<NBEdge*>::const_iterator i = myEdges.begin(); i != myEdges.end(); ++i) {
+        (*i)->computeEdge2Edges(myNoLeftMovers);
+    }
+}
+#endif
+
+
 void
 NBEdgeCont::computeLanes2Edges() {
     for (EdgeCont::iterator i = myEdges.begin(); i != myEdges.end(); i++) {
@@ -837,13 +868,45 @@ NBEdgeCont::appendTurnarounds(const std::set<std::string>& ids, bool noTLSContro
 
 
 void
-NBEdgeCont::computeEdgeShapes() {
+NBEdgeCont::computeEdgeShapes(const int numThreads) {
+#ifdef HAVE_FOX
+    if (numThreads > 1 && (int)myEdges.size() > numThreads) {
+        FXWorkerThread::Pool threadPool(numThreads);
+        // several tasks per thread to balance the differing geometry sizes
+        const int chunkSize = MAX2(1, (int)myEdges.size() / (4 * numThreads));
+        std::vector<NBEdge*> chunk;
+        for (EdgeCont::iterator i = myEdges.begin(); i != myEdges.end(); i++) {
+            chunk.push_back((*i).second);
+            if ((int)chunk.size() == chunkSize) {
+                threadPool.add(new EdgeShapeTask(chunk));
+                chunk.clear();
+            }
+        }
+        if (!chunk.empty()) {
+            threadPool.add(new EdgeShapeTask(chunk));
+        }
+        threadPool.waitAll();
+        return;
+    }
+#else
+    UNUSED_PARAMETER(numThreads);
+#endif
     for (EdgeCont::iterator i = myEdges.begin(); i != myEdges.end(); i++) {
         (*i).second->computeEdgeShape();
     }
 }
 
 
+#ifdef HAVE_FOX
+void
+NBEdgeCont::EdgeShapeTask::run(FXWorkerThread* /* context */) {
+    for (std::vector<NBEdge*>::const_iterator i = myEdges.begin(); i != myEdges.end(); ++i) {
+        (*i)->computeEdgeShape();
+    }
+}
+#endif
+
+
 void
 NBEdgeCont::computeLaneShapes() {
     for (EdgeCont::iterator i = myEdges.begin(); i != myEdges.end(); ++i) {
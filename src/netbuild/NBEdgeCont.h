@@ -39,6 +39,9 @@
 #include <utils/common/UtilExceptions.h>
 #include <utils/geom/PositionVector.h>
 #include <utils/common/NamedRTree.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXWorkerThread.h>
+#endif
 
 
 // ===========================================================================
@@ -381,12 +384,15 @@ public:
     /** @brief Computes for each edge the approached edges
      *
      * Calls "NBEdge::computeEdge2Edges" for all edges within the container.
+     *  Every edge only adds connections to itself, so the edges may be processed
+     *  in parallel without changing the result.
      *
      * @param[in] noLeftMovers Whether left-moving connections shall be omitted
+     * @param[in] numThreads The number of threads to use (0 or 1 for sequential computation)
      * @todo Recheck whether a visitor-pattern should be used herefor
      * @see NBEdge::computeEdge2Edges
      */
-    void computeEdge2Edges(bool noLeftMovers);
+    void computeEdge2Edges(bool noLeftMovers, const int numThreads = 0);
 
 
     /** @brief Computes for each edge which lanes approach the next edges
@@ -432,12 +438,15 @@ public:
     /** @brief Computes the shapes of all edges stored in the container
      *
      * Calls "NBEdge::computeEdgeShape" for all edges within the container.
+     *  Every edge only modifies its own lane shapes, so the edges may be processed
+     *  in parallel without changing the result.
      *
+     * @param[in] numThreads The number of threads to use (0 or 1 for sequential computation)
      * @todo Recheck whether a visitor-pattern should be used herefor
      * @todo Recheck usage
      * @see NBEdge::computeEdgeShape
      */
-    void computeEdgeShapes();
+    void computeEdgeShapes(const int numThreads = 0);
 
 
     /** @brief Computes the shapes of all lanes of all edges stored in the container
@@ -713,6 +722,41 @@ private:
     };
 
 
+#ifdef HAVE_FOX
+    /**
+     * @class EdgeShapeTask
+     * @brief Computes the shapes of a range of edges
+     */
+    class EdgeShapeTask : public FXWorkerThread::Task {
+    public:
+        EdgeShapeTask(const std::vector<NBEdge*>& edges) : myEdges(edges) {}
+        void run(FXWorkerThread* context);
+    private:
+        const std::vector<NBEdge*> myEdges;
+    private:
+        /// @brief Invalidated assignment operator.
+        EdgeShapeTask& operator=(const EdgeShapeTask&);
+    };
+
+
+    /**
+     * @class Edge2EdgesTask
+     * @brief Computes the approached edges of a range of edges
+     */
+    class Edge2EdgesTask : public FXWorkerThread::Task {
+    public:
+        Edge2EdgesTask(const std::vector<NBEdge*>& edges, const bool noLeftMovers) : myEdges(edges), myNoLeftMovers(noLeftMovers) {}
+        void run(FXWorkerThread* context);
+    private:
+        const std::vector<NBEdge*> myEdges;
+        const bool myNoLeftMovers;
+    private:
+        /// @brief Invalidated assignment operator.
+        Edge2EdgesTask& operator=(const Edge2EdgesTask&);
+    };
+#endif
+
+
 private:
     /// @brief invalidated copy constructor
     NBEdgeCont(const NBEdgeCont& s);
@@ -95,6 +95,9 @@ NBFrame::fillOptions(bool forNetgen) {
     oc.doRegister("reserved-ids", new Option_FileName());
     oc.addDescription("reserved-ids", "Processing", "Ensures that generated ids do not included any of the typed IDs from FILE (SUMO-GUI selection file format)");
 
+    oc.doRegister("threads", new Option_Integer(0));
+    oc.addDescription("threads", "Processing", "Defines the number of threads for computing independent per-node and per-edge steps in parallel, the result does not depend on the number of threads");
+
     if (!forNetgen) {
         oc.doRegister("dismiss-vclasses", new Option_Bool(false));
         oc.addDescription("dismiss-vclasses", "Processing", "Removes vehicle class restrictions from imported edges");
@@ -509,6 +512,15 @@ NBFrame::checkOptions() {
         // make sure the option is set so heuristics cannot ignore it
         oc.set("no-internal-links", "false");
     }
+    if (oc.getInt("threads") < 0) {
+        WRITE_ERROR("The number of threads must not be negative.");
+        ok = false;
+    }
+#ifndef HAVE_FOX
+    if (oc.getInt("threads") > 1) {
+        WRITE_WARNING("Parallel network computation is only possible when compiled with Fox, running sequentially.");
+    }
+#endif
     return ok;
 }
 
@@ -86,6 +86,7 @@ NBNetBuilder::compute(OptionsCont& oc, const std::set<std::string>& explicitTurn
     if (lefthand) {
         mirrorX();
     }
+    const int numThreads = oc.exists("threads") ? oc.getInt("threads") : 0;
 
     // MODIFYING THE SETS OF NODES AND EDGES
 
@@ -313,7 +314,7 @@ NBNetBuilder::compute(OptionsCont& oc, const std::set<std::string>& explicitTurn
     //
     before = SysUtils::getCurrentMillis();
     PROGRESS_BEGIN_MESSAGE("Sorting nodes' edges");
-    NBNodesEdgesSorter::sortNodesEdges(myNodeCont);
+    NBNodesEdgesSorter::sortNodesEdges(myNodeCont, false, numThreads);
     PROGRESS_TIME_MESSAGE(before);
     myEdgeCont.computeLaneShapes();
     //
@@ -328,7 +329,7 @@ NBNetBuilder::compute(OptionsCont& oc, const std::set<std::string>& explicitTurn
     //
     before = SysUtils::getCurrentMillis();
     PROGRESS_BEGIN_MESSAGE("Computing edge shapes");
-    myEdgeCont.computeEdgeShapes();
+    myEdgeCont.computeEdgeShapes(numThreads);
     PROGRESS_TIME_MESSAGE(before);
     // resort edges based on the node and edge shapes
     NBNodesEdgesSorter::sortNodesEdges(myNodeCont, true);
@@ -391,7 +392,7 @@ NBNetBuilder::compute(OptionsCont& oc, const std::set<std::string>& explicitTurn
     //
     before = SysUtils::getCurrentMillis();
     PROGRESS_BEGIN_MESSAGE("Computing approached edges");
-    myEdgeCont.computeEdge2Edges(oc.getBool("no-left-connections"));
+    myEdgeCont.computeEdge2Edges(oc.getBool("no-left-connections"), numThreads);
     PROGRESS_TIME_MESSAGE(before);
     //
     if (mayAddOrRemove && oc.getBool("roundabouts.guess")) {
@@ -412,7 +413,7 @@ NBNetBuilder::compute(OptionsCont& oc, const std::set<std::string>& explicitTurn
     //
     before = SysUtils::getCurrentMillis();
     PROGRESS_BEGIN_MESSAGE("Dividing of lanes on approached lanes");
-    myNodeCont.computeLanes2Lanes();
+    myNodeCont.computeLanes2Lanes(numThreads);
     myEdgeCont.sortOutgoingLanesConnections();
     PROGRESS_TIME_MESSAGE(before);
     //
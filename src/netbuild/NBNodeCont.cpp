@@ -1360,13 +1360,44 @@ NBNodeCont::setAsTLControlled(NBNode* node, NBTrafficLightLogicCont& tlc,
 
 // -----------
 void
-NBNodeCont::computeLanes2Lanes() {
+NBNodeCont::computeLanes2Lanes(const int numThreads) {
+#ifdef HAVE_FOX
+    if (numThreads > 1 && (int)myNodes.size() > numThreads) {
+        FXWorkerThread::Pool threadPool(numThreads);
+        const int chunkSize = MAX2(1, (int)myNodes.size() / (4 * numThreads));
+        std::vector<NBNode*> chunk;
+        for (NodeCont::iterator i = myNodes.begin(); i != myNodes.end(); i++) {
+            chunk.push_back((*i).second);
+            if ((int)chunk.size() == chunkSize) {
+                threadPool.add(new Lanes2LanesTask(chunk));
+                chunk.clear();
+            }
+        }
+        if (!chunk.empty()) {
+            threadPool.add(new Lanes2LanesTask(chunk));
+        }
+        threadPool.waitAll();
+        return;
+    }
+#else
+    UNUSED_PARAMETER(numThreads);
+#endif
     for (NodeCont::iterator i = myNodes.begin(); i != myNodes.end(); i++) {
         (*i).second->computeLanes2Lanes();
     }
 }
 
 
+#ifdef HAVE_FOX
+void
+NBNodeCont::Lanes2LanesTask::run(FXWorkerThread* /* context */) {
+    for (std::vector<NBNode*>::const_iterator i = myNodes.begin(); i != myNodes.end(); ++i) {
+        (*i)->computeLanes2Lanes();
+    }
+}
+#endif
+
+
 // computes the "wheel" of incoming and outgoing edges for every node
 void
 NBNodeCont::computeLogics(const NBEdgeCont& ec, OptionsCont& oc) {
@@ -40,6 +40,9 @@
 #include "NBEdgeCont.h"
 #include "NBNode.h"
 #include <utils/common/UtilExceptions.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXWorkerThread.h>
+#endif
 
 
 // ===========================================================================
@@ -243,8 +246,14 @@ public:
     /// @brief Renames the node. Throws exception if newID already exists
     void rename(NBNode* node, const std::string& newID);
 
-    /// divides the incoming lanes on outgoing lanes
-    void computeLanes2Lanes();
+    /** @brief divides the incoming lanes on outgoing lanes
+     *
+     * Every node only modifies the connections of its incoming edges, so the nodes
+     *  may be processed in parallel without changing the result.
+     *
+     * @param[in] numThreads The number of threads to use (0 or 1 for sequential computation)
+     */
+    void computeLanes2Lanes(const int numThreads = 0);
 
     /// build the list of outgoing edges and lanes
     void computeLogics(const NBEdgeCont& ec, OptionsCont& oc);
@@ -336,6 +345,24 @@ private:
     /// @}
 
 
+#ifdef HAVE_FOX
+    /**
+     * @class Lanes2LanesTask
+     * @brief Divides the incoming lanes on the outgoing lanes for a range of nodes
+     */
+    class Lanes2LanesTask : public FXWorkerThread::Task {
+    public:
+        Lanes2LanesTask(const std::vector<NBNode*>& nodes) : myNodes(nodes) {}
+        void run(FXWorkerThread* context);
+    private:
+        const std::vector<NBNode*> myNodes;
+    private:
+        /// @brief Invalidated assignment operator.
+        Lanes2LanesTask& operator=(const Lanes2LanesTask&);
+    };
+#endif
+
+
 private:
     /// @brief The running internal id
     int myInternalID;
@@ -263,6 +263,9 @@ NIFrame::fillOptions() {
     oc.doRegister("osm.skip-duplicates-check", new Option_Bool(false));
     oc.addDescription("osm.skip-duplicates-check", "Processing", "Skips the check for duplicate nodes and edges");
 
+    oc.doRegister("osm.streaming", new Option_Bool(false));
+    oc.addDescription("osm.streaming", "Processing", "Parses the ways before the nodes and only keeps the nodes referenced by ways or relations to reduce memory usage");
+
     oc.doRegister("osm.elevation", new Option_Bool(false));
     oc.addDescription("osm.elevation", "Processing", "Imports elevation data");
 
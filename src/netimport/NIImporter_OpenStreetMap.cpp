@@ -133,31 +133,69 @@ NIImporter_OpenStreetMap::load(const OptionsCont& oc, NBNetBuilder& nb) {
         return;
     }
     /* Parse file(s)
-     * Each file is parsed twice: first for nodes, second for edges. */
+     * Each file is parsed twice: first for nodes, second for edges.
+     * When streaming, the edges are parsed first and only the nodes
+     * referenced by them (or by relations) are kept. */
     std::vector<std::string> files = oc.getStringVector("osm-files");
-    // load nodes, first
-    NodesHandler nodesHandler(myOSMNodes, myUniqueNodes, oc);
-    for (std::vector<std::string>::const_iterator file = files.begin(); file != files.end(); ++file) {
-        // nodes
-        if (!FileHelpers::isReadable(*file)) {
-            WRITE_ERROR("Could not open osm-file '" + *file + "'.");
-            return;
+    if (oc.getBool("osm.streaming")) {
+        std::vector<long long int> usedNodes;
+        EdgesHandler edgesHandler(myOSMNodes, myEdges, myPlatformShapes, &usedNodes);
+        for (std::vector<std::string>::const_iterator file = files.begin(); file != files.end(); ++file) {
+            if (!FileHelpers::isReadable(*file)) {
+                WRITE_ERROR("Could not open osm-file '" + *file + "'.");
+                return;
+            }
+            edgesHandler.setFileName(*file);
+            PROGRESS_BEGIN_MESSAGE("Parsing edges from osm-file '" + *file + "'");
+            if (!XMLSubSys::runParser(edgesHandler, *file)) {
+                return;
+            }
+            PROGRESS_DONE_MESSAGE();
         }
-        nodesHandler.setFileName(*file);
-        PROGRESS_BEGIN_MESSAGE("Parsing nodes from osm-file '" + *file + "'");
-        if (!XMLSubSys::runParser(nodesHandler, *file)) {
-            return;
+        for (std::map<long long int, Edge*>::const_iterator i = myEdges.begin(); i != myEdges.end(); ++i) {
+            usedNodes.insert(usedNodes.end(), i->second->myCurrentNodes.begin(), i->second->myCurrentNodes.end());
+        }
+        for (std::map<long long int, Edge*>::const_iterator i = myPlatformShapes.begin(); i != myPlatformShapes.end(); ++i) {
+            usedNodes.insert(usedNodes.end(), i->second->myCurrentNodes.begin(), i->second->myCurrentNodes.end());
+        }
+        std::sort(usedNodes.begin(), usedNodes.end());
+        usedNodes.erase(std::unique(usedNodes.begin(), usedNodes.end()), usedNodes.end());
+        NodesHandler nodesHandler(myOSMNodes, myUniqueNodes, oc, &usedNodes);
+        for (std::vector<std::string>::const_iterator file = files.begin(); file != files.end(); ++file) {
+            nodesHandler.setFileName(*file);
+            PROGRESS_BEGIN_MESSAGE("Parsing nodes from osm-file '" + *file + "'");
+            if (!XMLSubSys::runParser(nodesHandler, *file)) {
+                return;
+            }
+            PROGRESS_DONE_MESSAGE();
+        }
+        resolveNodeRefs(myEdges);
+        resolveNodeRefs(myPlatformShapes);
+    } else {
+        // load nodes, first
+        NodesHandler nodesHandler(myOSMNodes, myUniqueNodes, oc);
+        for (std::vector<std::string>::const_iterator file = files.begin(); file != files.end(); ++file) {
+            // nodes
+            if (!FileHelpers::isReadable(*file)) {
+                WRITE_ERROR("Could not open osm-file '" + *file + "'.");
+                return;
+            }
+            nodesHandler.setFileName(*file);
+            PROGRESS_BEGIN_MESSAGE("Parsing nodes from osm-file '" + *file + "'");
+            if (!XMLSubSys::runParser(nodesHandler, *file)) {
+                return;
+            }
+            PROGRESS_DONE_MESSAGE();
+        }
+        // load edges, then
+        EdgesHandler edgesHandler(myOSMNodes, myEdges, myPlatformShapes);
+        for (std::vector<std::string>::const_iterator file = files.begin(); file != files.end(); ++file) {
+            // edges
+            edgesHandler.setFileName(*file);
+            PROGRESS_BEGIN_MESSAGE("Parsing edges from osm-file '" + *file + "'");
+            XMLSubSys::runParser(edgesHandler, *file);
+            PROGRESS_DONE_MESSAGE();
         }
-        PROGRESS_DONE_MESSAGE();
-    }
-    // load edges, then
-    EdgesHandler edgesHandler(myOSMNodes, myEdges, myPlatformShapes);
-    for (std::vector<std::string>::const_iterator file = files.begin(); file != files.end(); ++file) {
-        // edges
-        edgesHandler.setFileName(*file);
-        PROGRESS_BEGIN_MESSAGE("Parsing edges from osm-file '" + *file + "'");
-        XMLSubSys::runParser(edgesHandler, *file);
-        PROGRESS_DONE_MESSAGE();
     }
 
     /* Remove duplicate edges with the same shape and attributes */
@@ -266,6 +304,25 @@ NIImporter_OpenStreetMap::load(const OptionsCont& oc, NBNetBuilder& nb) {
     }
 }
 
+void
+NIImporter_OpenStreetMap::resolveNodeRefs(std::map<long long int, Edge*>& edges) const {
+    for (std::map<long long int, Edge*>::iterator i = edges.begin(); i != edges.end(); ++i) {
+        std::vector<long long int> refs;
+        refs.swap(i->second->myCurrentNodes);
+        for (std::vector<long long int>::const_iterator j = refs.begin(); j != refs.end(); ++j) {
+            auto node = myOSMNodes.find(*j);
+            if (node == myOSMNodes.end()) {
+                WRITE_WARNING("The referenced geometry information (ref='" + toString(*j) + "') is not known");
+                continue;
+            }
+            const long long int ref = node->second->id; // node may have been substituted
+            if (i->second->myCurrentNodes.empty() || i->second->myCurrentNodes.back() != ref) {
+                i->second->myCurrentNodes.push_back(ref);
+            }
+        }
+    }
+}
+
 NBNode*
 NIImporter_OpenStreetMap::insertNodeChecking(long long int id, NBNodeCont& nc, NBTrafficLightLogicCont& tlsc) {
     NBNode* node = nc.retrieve(toString(id));
@@ -665,7 +722,7 @@ NIImporter_OpenStreetMap::insertEdge(Edge* e, int index, NBNode* from, NBNode* t
 // ---------------------------------------------------------------------------
 NIImporter_OpenStreetMap::NodesHandler::NodesHandler(std::map<long long int, NIOSMNode*>& toFill,
         std::set<NIOSMNode*, CompareNodes>& uniqueNodes,
-        const OptionsCont& oc)
+        const OptionsCont& oc, const std::vector<long long int>* nodeFilter)
 
     :
     SUMOSAXHandler("osm - file"),
@@ -675,7 +732,8 @@ NIImporter_OpenStreetMap::NodesHandler::NodesHandler(std::map<long long int, NIO
     myHierarchyLevel(0),
     myUniqueNodes(uniqueNodes),
     myImportElevation(oc.getBool("osm.elevation")),
-    myOptionsCont(oc) {
+    myOptionsCont(oc),
+    myNodeFilter(nodeFilter) {
 }
 
 NIImporter_OpenStreetMap::NodesHandler::~NodesHandler() = default;
@@ -699,6 +757,9 @@ NIImporter_OpenStreetMap::NodesHandler::myStartElement(int element, const SUMOSA
             return;
         }
         myLastNodeID = -1;
+        if (myNodeFilter != nullptr && !std::binary_search(myNodeFilter->begin(), myNodeFilter->end(), id)) {
+            return;
+        }
         if (myToFill.find(id) == myToFill.end()) {
             myLastNodeID = id;
             // assume we are loading multiple files...
@@ -806,12 +867,15 @@ NIImporter_OpenStreetMap::NodesHandler::myEndElement(int element) {
 // ---------------------------------------------------------------------------
 NIImporter_OpenStreetMap::EdgesHandler::EdgesHandler(
     const std::map<long long int, NIOSMNode*>& osmNodes,
-    std::map<long long int, Edge*>& toFill, std::map<long long int, Edge*>& platformShapes)
+    std::map<long long int, Edge*>& toFill, std::map<long long int, Edge*>& platformShapes,
+    std::vector<long long int>* relationNodes)
     :
     SUMOSAXHandler("osm - file"),
     myOSMNodes(osmNodes),
     myEdgeMap(toFill),
-    myPlatformShapesMap(platformShapes) {
+    myPlatformShapesMap(platformShapes),
+    myCurrentEdge(nullptr),
+    myRelationNodes(relationNodes) {
     mySpeedMap["signals"] = MAXSPEED_UNGIVEN;
     mySpeedMap["none"] = 300.;
     mySpeedMap["no"] = 300.;
@@ -839,10 +903,23 @@ NIImporter_OpenStreetMap::EdgesHandler::myStartElement(int element,
         }
         myCurrentEdge = new Edge(id);
     }
+    // collect the nodes needed by relations if the nodes are parsed later
+    if (element == SUMO_TAG_MEMBER && myRelationNodes != nullptr && attrs.getStringSecure(SUMO_ATTR_TYPE, "") == "node") {
+        bool ok = true;
+        const long long int ref = attrs.get<long long int>(SUMO_ATTR_REF, nullptr, ok);
+        if (ok) {
+            myRelationNodes->push_back(ref);
+        }
+    }
     // parse "nd" (node) elements
     if (element == SUMO_TAG_ND && myCurrentEdge != 0) {
         bool ok = true;
         long long int ref = attrs.get<long long int>(SUMO_ATTR_REF, 0, ok);
+        if (ok && myRelationNodes != nullptr) {
+            // nodes are not known yet, references are resolved after parsing them
+            myCurrentEdge->myCurrentNodes.push_back(ref);
+            return;
+        }
         if (ok) {
             auto node = myOSMNodes.find(ref);
             if (node == myOSMNodes.end()) {
@@ -33,6 +33,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <utils/xml/SUMOSAXHandler.h>
 #include <utils/common/UtilExceptions.h>
 #include <utils/common/Parameterised.h>
@@ -261,6 +262,16 @@ private:
     NBNode* insertNodeChecking(long long int id, NBNodeCont& nc, NBTrafficLightLogicCont& tlsc);
 
 
+    /** @brief Replaces the raw node references of the given ways by the loaded (and possibly substituted) nodes
+     *
+     * Used when the ways were parsed before the nodes. Unknown references are dropped
+     *  with a warning and consecutive duplicates are removed, as done by the EdgesHandler
+     *  if the nodes are already known.
+     * @param[in, out] edges The ways to update
+     */
+    void resolveNodeRefs(std::map<long long int, Edge*>& edges) const;
+
+
     /** @brief Builds an NBEdge
      *
      * @param[in] e The definition of the edge
@@ -298,10 +309,12 @@ protected:
          * @param[in, out] toFill The nodes container to fill
          * @param[in, out] uniqueNodes The nodes container for ensuring uniqueness
          * @param[in] options The options to use
+         * @param[in] nodeFilter If given, the sorted ids of the only nodes to load
          */
         NodesHandler(std::map<long long int, NIOSMNode*>& toFill, std::set<NIOSMNode*,
                      CompareNodes>& uniqueNodes,
-                     const OptionsCont& cont);
+                     const OptionsCont& cont,
+                     const std::vector<long long int>* nodeFilter = nullptr);
 
 
         /// @brief Destructor
@@ -355,6 +368,9 @@ protected:
         /// @brief the options
         const OptionsCont& myOptionsCont;
 
+        /// @brief the sorted ids of the nodes to load (all nodes if 0)
+        const std::vector<long long int>* const myNodeFilter;
+
 
     private:
         /** @brief invalidated copy constructor */
@@ -373,12 +389,17 @@ protected:
     class EdgesHandler : public SUMOSAXHandler {
     public:
         /** @brief Constructor
+         *
+         * If relationNodes is given, the nodes are not known yet. The raw node references
+         *  are then stored with the ways and the nodes referenced by relations are collected.
          *
          * @param[in] osmNodes The previously parsed (osm-)nodes
          * @param[in, out] toFill The edges container to fill with read edges
+         * @param[in, out] relationNodes The container to collect the node members of relations in
          */
         EdgesHandler(const std::map<long long int, NIOSMNode*>& osmNodes,
-                     std::map<long long int, Edge*>& toFill, std::map<long long int, Edge*>& platformShapes);
+                     std::map<long long int, Edge*>& toFill, std::map<long long int, Edge*>& platformShapes,
+                     std::vector<long long int>* relationNodes = nullptr);
 
 
         /// @brief Destructor
@@ -428,6 +449,9 @@ protected:
         /// @brief A map of non-numeric speed descriptions to their numeric values
         std::map<std::string, double> mySpeedMap;
 
+        /// @brief the node members of relations (if the nodes are parsed after the ways)
+        std::vector<long long int>* const myRelationNodes;
+
     private:
         /** @brief invalidated copy constructor */
         EdgesHandler(const EdgesHandler& s);
@@ -63,21 +63,32 @@ void single(const std::string& of, const std::string& className, SUMOEmissionCla
     if (verbose) {
         WRITE_MESSAGE("Writing map of '" + className + "' into '" + of + "'.");
     }
-    std::ofstream o(of.c_str());
+    std::vector<double> vs, as, ss;
     for (double v = vMin; v <= vMax; v += vStep) {
         for (double a = aMin; a <= aMax; a += aStep) {
             for (double s = sMin; s <= sMax; s += sStep) {
-                const PollutantsInterface::Emissions result = PollutantsInterface::computeAll(c, v, a, s);
-                o << v << ";" << a << ";" << s << ";" << "CO" << ";" << result.CO << std::endl;
-                o << v << ";" << a << ";" << s << ";" << "CO2" << ";" << result.CO2 << std::endl;
-                o << v << ";" << a << ";" << s << ";" << "HC" << ";" << result.HC << std::endl;
-                o << v << ";" << a << ";" << s << ";" << "PMx" << ";" << result.PMx << std::endl;
-                o << v << ";" << a << ";" << s << ";" << "NOx" << ";" << result.NOx << std::endl;
-                o << v << ";" << a << ";" << s << ";" << "fuel" << ";" << result.fuel << std::endl;
-                o << v << ";" << a << ";" << s << ";" << "electricity" << ";" << result.electricity << std::endl;
+                vs.push_back(v);
+                as.push_back(a);
+                ss.push_back(s);
             }
         }
     }
+    std::vector<PollutantsInterface::Emissions> results;
+    PollutantsInterface::computeAll(c, vs, as, ss, results);
+    std::ofstream o(of.c_str());
+    for (int i = 0; i < (int)results.size(); i++) {
+        const double v = vs[i];
+        const double a = as[i];
+        const double s = ss[i];
+        const PollutantsInterface::Emissions& result = results[i];
+        o << v << ";" << a << ";" << s << ";" << "CO" << ";" << result.CO << std::endl;
+        o << v << ";" << a << ";" << s << ";" << "CO2" << ";" << result.CO2 << std::endl;
+        o << v << ";" << a << ";" << s << ";" << "HC" << ";" << result.HC << std::endl;
+        o << v << ";" << a << ";" << s << ";" << "PMx" << ";" << result.PMx << std::endl;
+        o << v << ";" << a << ";" << s << ";" << "NOx" << ";" << result.NOx << std::endl;
+        o << v << ";" << a << ";" << s << ";" << "fuel" << ";" << result.fuel << std::endl;
+        o << v << ";" << a << ";" << s << ";" << "electricity" << ";" << result.electricity << std::endl;
+    }
 }
 
 
@@ -599,6 +599,12 @@
 // last action time (get: vehicles)
 #define VAR_LASTACTIONTIME 0x7f
 
+// typed platooning data exchange, see PLEXE_DATA_* in CC_Const.h (get & set: vehicles)
+#define VAR_PLEXE_DATA 0x1b
+
+// numerical handle, usable as id "#<handle>" while the vehicle exists (get: vehicles)
+#define VAR_HANDLE 0x1c
+
 // driver's desired headway (get: vehicle types)
 #define VAR_TAU 0x48
 
@@ -891,10 +891,12 @@ TraCIServer::postProcessSimulationStep() {
 #endif
     writeStatusCmd(CMD_SIMSTEP, RTYPE_OK, "");
     int noActive = 0;
+    const std::vector<std::string>& arrived = myVehicleStateChanges[MSNet::VEHICLE_STATE_ARRIVED];
+    const std::set<std::string> arrivedVehicles(arrived.begin(), arrived.end());
     for (std::vector<libsumo::Subscription>::iterator i = mySubscriptions.begin(); i != mySubscriptions.end();) {
         const libsumo::Subscription& s = *i;
         bool isArrivedVehicle = (s.commandId == CMD_SUBSCRIBE_VEHICLE_VARIABLE || s.commandId == CMD_SUBSCRIBE_VEHICLE_CONTEXT)
-                                && (find(myVehicleStateChanges[MSNet::VEHICLE_STATE_ARRIVED].begin(), myVehicleStateChanges[MSNet::VEHICLE_STATE_ARRIVED].end(), s.id) != myVehicleStateChanges[MSNet::VEHICLE_STATE_ARRIVED].end());
+                                && arrivedVehicles.count(s.id) > 0;
         bool isArrivedPerson = (s.commandId == CMD_SUBSCRIBE_PERSON_VARIABLE || s.commandId == CMD_SUBSCRIBE_PERSON_CONTEXT) && MSNet::getInstance()->getPersonControl().get(s.id) == 0;
         if ((s.endTime < t) || isArrivedVehicle || isArrivedPerson) {
             i = mySubscriptions.erase(i);
@@ -915,26 +917,29 @@ TraCIServer::postProcessSimulationStep() {
 #ifdef DEBUG_SUBSCRIPTIONS
     std::cout << "   Size after writing an int is " << mySubscriptionCache.size() << std::endl;
 #endif
-    for (std::vector<libsumo::Subscription>::iterator i = mySubscriptions.begin(); i != mySubscriptions.end();) {
-        const libsumo::Subscription& s = *i;
-        if (s.beginTime > t) {
-            ++i;
-            continue;
-        }
-        tcpip::Storage into;
-        std::string errors;
-        bool ok = processSingleSubscription(s, into, errors);
+    // the responses are written directly into the cache, erasing is done in one go afterwards
+    std::vector<libsumo::Subscription>::iterator kept = mySubscriptions.begin();
+    for (std::vector<libsumo::Subscription>::iterator i = mySubscriptions.begin(); i != mySubscriptions.end(); ++i) {
+        if (i->beginTime <= t) {
+            std::string errors;
 #ifdef DEBUG_SUBSCRIPTIONS
-        std::cout << "   Size of into-store for subscription " << s.id
-                  << ": " << into.size() << std::endl;
+            const int sizeBefore = (int)mySubscriptionCache.size();
 #endif
-        mySubscriptionCache.writeStorage(into);
-        if (ok) {
-            ++i;
-        } else {
-            i = mySubscriptions.erase(i);
+            const bool ok = processSingleSubscription(*i, mySubscriptionCache, errors);
+#ifdef DEBUG_SUBSCRIPTIONS
+            std::cout << "   Size of into-store for subscription " << i->id
+                      << ": " << (int)mySubscriptionCache.size() - sizeBefore << std::endl;
+#endif
+            if (!ok) {
+                continue;
+            }
+        }
+        if (kept != i) {
+            *kept = std::move(*i);
         }
+        ++kept;
     }
+    mySubscriptions.erase(kept, mySubscriptions.end());
     myOutputStorage.writeStorage(mySubscriptionCache);
 #ifdef DEBUG_SUBSCRIPTIONS
     std::cout << "   Size after writing subscriptions is " << mySubscriptionCache.size() << std::endl;
@@ -1140,8 +1145,14 @@ bool
 TraCIServer::processSingleSubscription(const libsumo::Subscription& s, tcpip::Storage& writeInto,
                                        std::string& errors) {
     bool ok = true;
-    tcpip::Storage outputStorage;
+    // the buffers are members in order to keep their capacity between the calls
+    tcpip::Storage& outputStorage = mySubscriptionOutput;
+    tcpip::Storage& message = mySubscriptionMessage;
+    tcpip::Storage& tmpOutput = mySubscriptionResponse;
+    outputStorage.reset();
     const int getCommandId = s.contextDomain > 0 ? s.contextDomain : s.commandId - 0x30;
+    // all variables of the subscription go to the same executor
+    const std::map<int, CmdExecutor>::const_iterator executor = myExecutors.find(getCommandId);
     std::set<std::string> objIDs;
     if (s.contextDomain > 0) {
         PositionVector shape;
@@ -1165,13 +1176,13 @@ TraCIServer::processSingleSubscription(const libsumo::Subscription& s, tcpip::St
         if (numVars > 0) {
             std::vector<std::vector<unsigned char> >::const_iterator k = s.parameters.begin();
             for (std::vector<int>::const_iterator i = s.variables.begin(); i != s.variables.end(); ++i, ++k) {
-                tcpip::Storage message;
+                message.reset();
                 message.writeUnsignedByte(*i);
                 message.writeString(*j);
                 message.writePacket(*k);
-                tcpip::Storage tmpOutput;
-                if (myExecutors.find(getCommandId) != myExecutors.end()) {
-                    ok &= myExecutors[getCommandId](*this, message, tmpOutput);
+                tmpOutput.reset();
+                if (executor != myExecutors.end()) {
+                    ok &= executor->second(*this, message, tmpOutput);
                 } else {
                     writeStatusCmd(s.commandId, RTYPE_NOTIMPLEMENTED, "Unsupported command specified", tmpOutput);
                     ok = false;
@@ -1182,22 +1193,18 @@ TraCIServer::processSingleSubscription(const libsumo::Subscription& s, tcpip::St
                     while (--length > 0) {
                         tmpOutput.readUnsignedByte();
                     }
-                    int lengthLength = 1;
                     length = tmpOutput.readUnsignedByte();
                     if (length == 0) {
-                        lengthLength = 5;
-                        length = tmpOutput.readInt();
+                        tmpOutput.readInt();
                     }
                     //read responseType
                     tmpOutput.readUnsignedByte();
                     int variable = tmpOutput.readUnsignedByte();
-                    std::string id = tmpOutput.readString();
+                    tmpOutput.readString();
                     outputStorage.writeUnsignedByte(variable);
                     outputStorage.writeUnsignedByte(RTYPE_OK);
-                    length -= (lengthLength + 1 + 4 + (int)id.length());
-                    while (--length > 0) {
-                        outputStorage.writeUnsignedByte(tmpOutput.readUnsignedByte());
-                    }
+                    // the value is the remainder of the response
+                    outputStorage.writeStorage(tmpOutput);
                 } else {
                     //read length
                     tmpOutput.readUnsignedByte();
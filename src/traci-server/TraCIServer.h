@@ -374,6 +374,9 @@ private:
     /// @brief The last timestep's subscription results
     tcpip::Storage mySubscriptionCache;
 
+    /// @brief Reused buffers for the request, the response and the collected values of a single subscription
+    tcpip::Storage mySubscriptionMessage, mySubscriptionResponse, mySubscriptionOutput;
+
     /// @brief Whether the server runs in embedded mode
     const bool myAmEmbedded;
 
@@ -105,6 +105,8 @@ TraCIServerAPI_Vehicle::processGet(TraCIServer& server, tcpip::Storage& inputSto
             && variable != VAR_LINE
             && variable != VAR_VIA
             && variable != VAR_ACCELERATION
+            && variable != VAR_PLEXE_DATA
+            && variable != VAR_HANDLE
             && variable != CMD_CHANGELANE
        ) {
         return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Get Vehicle Variable: unsupported variable " + toHex(variable, 2) + " specified", outputStorage);
@@ -126,6 +128,10 @@ TraCIServerAPI_Vehicle::processGet(TraCIServer& server, tcpip::Storage& inputSto
                 tempMsg.writeUnsignedByte(TYPE_INTEGER);
                 tempMsg.writeInt(libsumo::Vehicle::getIDCount());
                 break;
+            case VAR_HANDLE:
+                tempMsg.writeUnsignedByte(TYPE_INTEGER);
+                tempMsg.writeInt(libsumo::Vehicle::getHandle(id));
+                break;
             case VAR_SPEED:
                 tempMsg.writeUnsignedByte(TYPE_DOUBLE);
                 tempMsg.writeDouble(libsumo::Vehicle::getSpeed(id));
@@ -479,6 +485,46 @@ TraCIServerAPI_Vehicle::processGet(TraCIServer& server, tcpip::Storage& inputSto
                 tempMsg.writeDouble(libsumo::Vehicle::getLastActionTime(id));
             }
             break;
+            case VAR_PLEXE_DATA: {
+                int kind = 0;
+                if (!server.readTypeCheckingUnsignedByte(inputStorage, kind)) {
+                    return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Retrieval of platooning data requires the data type as an unsigned byte.", outputStorage);
+                }
+                if (kind == PLEXE_DATA_SPEED_AND_ACCELERATION || kind == PLEXE_DATA_SPEED_AND_ACCELERATION_REALISTIC) {
+                    Plexe::SPEED_AND_ACCELERATION data;
+                    libsumo::Vehicle::getPlatoonSpeedAndAcceleration(id, data, kind == PLEXE_DATA_SPEED_AND_ACCELERATION_REALISTIC);
+                    const double values[] = {data.speed, data.acceleration, data.controllerAcceleration, data.positionX, data.positionY,
+                                             data.time, data.speedX, data.speedY, data.angle
+                                            };
+                    tempMsg.writeUnsignedByte(TYPE_COMPOUND);
+                    tempMsg.writeInt(9);
+                    for (double value : values) {
+                        tempMsg.writeUnsignedByte(TYPE_DOUBLE);
+                        tempMsg.writeDouble(value);
+                    }
+                } else if (kind == PLEXE_DATA_VEHICLE_DATA || kind == PLEXE_DATA_VEHICLE_DATA_REALISTIC) {
+                    int index = 0;
+                    if (!server.readTypeCheckingInt(inputStorage, index)) {
+                        return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Retrieval of platoon member data requires the member index as an integer.", outputStorage);
+                    }
+                    Plexe::VEHICLE_DATA data;
+                    libsumo::Vehicle::getPlatoonVehicleData(id, index, data, kind == PLEXE_DATA_VEHICLE_DATA_REALISTIC);
+                    const double values[] = {data.speed, data.acceleration, data.positionX, data.positionY, data.time,
+                                             data.length, data.u, data.speedX, data.speedY, data.angle
+                                            };
+                    tempMsg.writeUnsignedByte(TYPE_COMPOUND);
+                    tempMsg.writeInt(11);
+                    tempMsg.writeUnsignedByte(TYPE_INTEGER);
+                    tempMsg.writeInt(data.index);
+                    for (double value : values) {
+                        tempMsg.writeUnsignedByte(TYPE_DOUBLE);
+                        tempMsg.writeDouble(value);
+                    }
+                } else {
+                    return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Unknown platooning data type " + toHex(kind, 2) + ".", outputStorage);
+                }
+            }
+            break;
             default:
                 TraCIServerAPI_VehicleType::getVariable(variable, libsumo::Vehicle::getVehicleType(id).getID(), tempMsg);
                 break;
@@ -521,6 +567,7 @@ TraCIServerAPI_Vehicle::processSet(TraCIServer& server, tcpip::Storage& inputSto
             && variable != VAR_MINGAP_LAT
             && variable != VAR_LINE
             && variable != VAR_VIA
+            && variable != VAR_PLEXE_DATA
             && variable != MOVE_TO_XY && variable != VAR_PARAMETER/* && variable != VAR_SPEED_TIME_LINE && variable != VAR_LANE_TIME_LINE*/
        ) {
         return server.writeErrorStatusCmd(CMD_SET_VEHICLE_VARIABLE, "Change Vehicle State: unsupported variable " + toHex(variable, 2) + " specified", outputStorage);
@@ -531,7 +578,7 @@ TraCIServerAPI_Vehicle::processSet(TraCIServer& server, tcpip::Storage& inputSto
     std::cout << SIMTIME << " processSet veh=" << id << "\n";
 #endif
     const bool shouldExist = variable != ADD && variable != ADD_FULL;
-    SUMOVehicle* sumoVehicle = MSNet::getInstance()->getVehicleControl().getVehicle(id);
+    SUMOVehicle* sumoVehicle = libsumo::Vehicle::findVehicle(id);
     if (sumoVehicle == 0) {
         if (shouldExist) {
             return server.writeErrorStatusCmd(CMD_SET_VEHICLE_VARIABLE, "Vehicle '" + id + "' is not known", outputStorage);
@@ -1129,6 +1176,76 @@ TraCIServerAPI_Vehicle::processSet(TraCIServer& server, tcpip::Storage& inputSto
                 }
             }
             break;
+            case VAR_PLEXE_DATA: {
+                if (inputStorage.readUnsignedByte() != TYPE_COMPOUND) {
+                    return server.writeErrorStatusCmd(CMD_SET_VEHICLE_VARIABLE, "Setting platooning data requires a compound object.", outputStorage);
+                }
+                const int itemNo = inputStorage.readInt();
+                int kind = 0;
+                if (!server.readTypeCheckingUnsignedByte(inputStorage, kind)) {
+                    return server.writeErrorStatusCmd(CMD_SET_VEHICLE_VARIABLE, "The first platooning data item must be the data type as an unsigned byte.", outputStorage);
+                }
+                int index = 0;
+                int numValues = 0;
+                switch (kind) {
+                    case PLEXE_DATA_LEADER_SPEED_AND_ACCELERATION:
+                    case PLEXE_DATA_PRECEDING_SPEED_AND_ACCELERATION:
+                        numValues = 9;
+                        break;
+                    case PLEXE_DATA_VEHICLE_DATA:
+                        if (!server.readTypeCheckingInt(inputStorage, index)) {
+                            return server.writeErrorStatusCmd(CMD_SET_VEHICLE_VARIABLE, "Platoon member data requires the member index as an integer.", outputStorage);
+                        }
+                        numValues = 10;
+                        break;
+                    case PLEXE_DATA_LEADER_FAKE_DATA:
+                        numValues = 3;
+                        break;
+                    case PLEXE_DATA_FRONT_FAKE_DATA:
+                        numValues = 4;
+                        break;
+                    default:
+                        return server.writeErrorStatusCmd(CMD_SET_VEHICLE_VARIABLE, "Unknown platooning data type " + toHex(kind, 2) + ".", outputStorage);
+                }
+                const int expected = numValues + (kind == PLEXE_DATA_VEHICLE_DATA ? 2 : 1);
+                if (itemNo != expected) {
+                    return server.writeErrorStatusCmd(CMD_SET_VEHICLE_VARIABLE, "Platooning data type " + toHex(kind, 2) + " requires " + toString(expected) + " items.", outputStorage);
+                }
+                double v[10];
+                for (int i = 0; i < numValues; ++i) {
+                    if (!server.readTypeCheckingDouble(inputStorage, v[i])) {
+                        return server.writeErrorStatusCmd(CMD_SET_VEHICLE_VARIABLE, "Platooning data values must be given as doubles.", outputStorage);
+                    }
+                }
+                try {
+                    switch (kind) {
+                        case PLEXE_DATA_LEADER_SPEED_AND_ACCELERATION:
+                        case PLEXE_DATA_PRECEDING_SPEED_AND_ACCELERATION: {
+                            const Plexe::SPEED_AND_ACCELERATION data = {v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8]};
+                            if (kind == PLEXE_DATA_LEADER_SPEED_AND_ACCELERATION) {
+                                libsumo::Vehicle::setPlatoonLeaderData(id, data);
+                            } else {
+                                libsumo::Vehicle::setPlatoonFrontData(id, data);
+                            }
+                            break;
+                        }
+                        case PLEXE_DATA_VEHICLE_DATA: {
+                            const Plexe::VEHICLE_DATA data = {index, v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8], v[9]};
+                            libsumo::Vehicle::setPlatoonVehicleData(id, data);
+                            break;
+                        }
+                        case PLEXE_DATA_LEADER_FAKE_DATA:
+                            libsumo::Vehicle::setPlatoonLeaderFakeData(id, v[0], v[1], v[2]);
+                            break;
+                        default:
+                            libsumo::Vehicle::setPlatoonFrontFakeData(id, v[0], v[1], v[2], v[3]);
+                            break;
+                    }
+                } catch (libsumo::TraCIException& e) {
+                    return server.writeErrorStatusCmd(CMD_SET_VEHICLE_VARIABLE, e.what(), outputStorage);
+                }
+            }
+            break;
             case VAR_ACTIONSTEPLENGTH: {
                 double value = 0;
                 if (!server.readTypeCheckingDouble(inputStorage, value)) {
@@ -1166,7 +1283,7 @@ TraCIServerAPI_Vehicle::processSet(TraCIServer& server, tcpip::Storage& inputSto
 // ------ helper functions ------
 bool
 TraCIServerAPI_Vehicle::getPosition(const std::string& id, Position& p) {
-    MSVehicle* v = dynamic_cast<MSVehicle*>(MSNet::getInstance()->getVehicleControl().getVehicle(id));
+    MSVehicle* v = dynamic_cast<MSVehicle*>(libsumo::Vehicle::findVehicle(id));
     if (v == 0) {
         return false;
     }
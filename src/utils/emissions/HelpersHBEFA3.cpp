@@ -471,6 +471,11 @@ HelpersHBEFA3::HelpersHBEFA3() : PollutantsInterface::Helper("HBEFA3") {
         index++;
     }
     myEmissionClassStrings.addAlias("unknown", myEmissionClassStrings.get("PC_G_EU4"));
+    for (int i = 0; i < 45; i++) {
+        const SUMOEmissionClass c = (HBEFA3_BASE + i + 1) | (i < 33 ? 0 : PollutantsInterface::HEAVY_BIT);
+        // divide by average diesel density of 836 g/l or gasoline density of 742 g/l
+        myFuelScale[i] = 3.6 * (getFuel(c) == "Diesel" ? 836. : 742.);
+    }
 }
 
 
@@ -109,15 +109,74 @@ public:
             return 0.;
         }
         const int index = (c & ~PollutantsInterface::HEAVY_BIT) - HBEFA3_BASE - 1;
-        double scale = 3.6;
-        if (e == PollutantsInterface::FUEL) {
-            if (getFuel(c) == "Diesel") {
-                scale *= 836.;
+        return evaluate(myFunctionParameter[index][e], v, a, e == PollutantsInterface::FUEL ? myFuelScale[index] : 3.6);
+    }
+
+
+    /** @brief Computes all pollutants at once using the given speed and acceleration
+     *
+     * Looks up the class parameters only once, see compute for the details.
+     *
+     * @param[in] c emission class for the function parameters to use
+     * @param[in] v The vehicle's current velocity
+     * @param[in] a The vehicle's current acceleration
+     * @param[in] slope The road's slope at vehicle's position [deg]
+     * @return The amounts emitted by the given emission class when moving with the given velocity and acceleration [mg/s or ml/s]
+     */
+    PollutantsInterface::Emissions computeAll(const SUMOEmissionClass c, const double v, const double a, const double slope, const std::map<int, double>* param) const {
+        UNUSED_PARAMETER(slope);
+        UNUSED_PARAMETER(param);
+        if (c == HBEFA3_BASE || a < 0.) {
+            return PollutantsInterface::Emissions();
+        }
+        const int index = (c & ~PollutantsInterface::HEAVY_BIT) - HBEFA3_BASE - 1;
+        const double (*const f)[6] = myFunctionParameter[index];
+        return PollutantsInterface::Emissions(evaluate(f[PollutantsInterface::CO2], v, a, 3.6), evaluate(f[PollutantsInterface::CO], v, a, 3.6),
+                                              evaluate(f[PollutantsInterface::HC], v, a, 3.6), evaluate(f[PollutantsInterface::FUEL], v, a, myFuelScale[index]),
+                                              evaluate(f[PollutantsInterface::NO_X], v, a, 3.6), evaluate(f[PollutantsInterface::PM_X], v, a, 3.6));
+    }
+
+
+    /** @brief Computes all pollutants for a batch of states of the same class
+     *
+     * The parameters of the class are fetched once for the whole batch, the loop
+     *  itself only consists of the polynomial evaluations.
+     *
+     * @param[in] c emission class for the function parameters to use
+     * @param[in] n The number of states
+     * @param[in] v The velocities
+     * @param[in] a The accelerations
+     * @param[in] slope The slopes [deg] (unused)
+     * @param[out] into The emissions per state [mg/s or ml/s]
+     */
+    void computeBatch(const SUMOEmissionClass c, const int n, const double* v, const double* a, const double* slope, PollutantsInterface::Emissions* into) const {
+        UNUSED_PARAMETER(slope);
+        if (c == HBEFA3_BASE) {
+            std::fill(into, into + n, PollutantsInterface::Emissions());
+            return;
+        }
+        const int index = (c & ~PollutantsInterface::HEAVY_BIT) - HBEFA3_BASE - 1;
+        const double* const fCO2 = myFunctionParameter[index][PollutantsInterface::CO2];
+        const double* const fCO = myFunctionParameter[index][PollutantsInterface::CO];
+        const double* const fHC = myFunctionParameter[index][PollutantsInterface::HC];
+        const double* const fFuel = myFunctionParameter[index][PollutantsInterface::FUEL];
+        const double* const fNOx = myFunctionParameter[index][PollutantsInterface::NO_X];
+        const double* const fPMx = myFunctionParameter[index][PollutantsInterface::PM_X];
+        const double fuelScale = myFuelScale[index];
+        for (int i = 0; i < n; i++) {
+            if (a[i] < 0.) {
+                into[i] = PollutantsInterface::Emissions();
             } else {
-                scale *= 742.;
+                into[i] = PollutantsInterface::Emissions(evaluate(fCO2, v[i], a[i], 3.6), evaluate(fCO, v[i], a[i], 3.6), evaluate(fHC, v[i], a[i], 3.6),
+                                                         evaluate(fFuel, v[i], a[i], fuelScale), evaluate(fNOx, v[i], a[i], 3.6), evaluate(fPMx, v[i], a[i], 3.6));
             }
         }
-        const double* f = myFunctionParameter[index][e];
+    }
+
+
+private:
+    /// @brief evaluates the emission polynomial with the given parameters and divides by the given scale
+    static inline double evaluate(const double* f, const double v, const double a, const double scale) {
         return (double) MAX2((f[0] + f[1] * a * v + f[2] * a * a * v + f[3] * v + f[4] * v * v + f[5] * v * v * v) / scale, 0.);
     }
 
@@ -126,6 +185,9 @@ private:
     /// @brief The function parameter
     static double myFunctionParameter[45][6][6];
 
+    /// @brief The divisor for the fuel values per class (3.6 times the density of the fuel)
+    double myFuelScale[45];
+
 };
 
 
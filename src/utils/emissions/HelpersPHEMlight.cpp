@@ -248,7 +248,7 @@ HelpersPHEMlight::getEmission(const PHEMCEP* oldCep, PHEMlightdll::CEP* currCep,
 
 double
 HelpersPHEMlight::getModifiedAccel(const SUMOEmissionClass c, const double v, const double a, const double slope) const {
-    PHEMlightdll::CEP* currCep = myCEPs.count(c) == 0 ? 0 : myCEPs.find(c)->second;
+    PHEMlightdll::CEP* currCep = getCEP(c);
     if (currCep != 0) {
         return v == 0.0 ? 0.0 : MIN2(a, currCep->GetMaxAccel(v, slope));
     }
@@ -276,7 +276,7 @@ HelpersPHEMlight::compute(const SUMOEmissionClass c, const PollutantsInterface::
 #else
     const PHEMCEP* const oldCep = 0;
 #endif
-    PHEMlightdll::CEP* currCep = myCEPs.count(c) == 0 ? 0 : myCEPs.find(c)->second;
+    PHEMlightdll::CEP* currCep = getCEP(c);
     if (currCep != 0) {
         const double corrAcc = getModifiedAccel(c, corrSpeed, a, slope);
         if (currCep->getFuelType() != PHEMlightdll::Constants::strBEV && corrAcc < currCep->GetDecelCoast(corrSpeed, corrAcc, slope) && corrSpeed > PHEMlightdll::Constants::ZERO_SPEED_ACCURACY) {
@@ -324,4 +324,55 @@ HelpersPHEMlight::compute(const SUMOEmissionClass c, const PollutantsInterface::
 }
 
 
+PollutantsInterface::Emissions
+HelpersPHEMlight::computeAll(const SUMOEmissionClass c, const double v, const double a, const double slope, const std::map<int, double>* /* param */) const {
+    if (c == PHEMLIGHT_BASE) { // zero emission class
+        return PollutantsInterface::Emissions();
+    }
+    const double corrSpeed = MAX2((double) 0.0, v);
+    double power = 0.;
+#ifdef INTERNAL_PHEM
+    const PHEMCEP* const oldCep = PHEMCEPHandler::getHandlerInstance().GetCep(c);
+    if (oldCep != 0) {
+        if (v > IDLE_SPEED && a < oldCep->GetDecelCoast(corrSpeed, a, slope, 0)) {
+            // coasting without power use only works if the engine runs above idle speed and
+            // the vehicle does not accelerate beyond friction losses
+            return PollutantsInterface::Emissions();
+        }
+        power = oldCep->CalcPower(corrSpeed, a, slope);
+    }
+#else
+    const PHEMCEP* const oldCep = 0;
+#endif
+    PHEMlightdll::CEP* const currCep = getCEP(c);
+    if (currCep != 0) {
+        const double corrAcc = corrSpeed == 0.0 ? 0.0 : MIN2(a, currCep->GetMaxAccel(corrSpeed, slope));
+        if (currCep->getFuelType() != PHEMlightdll::Constants::strBEV && corrAcc < currCep->GetDecelCoast(corrSpeed, corrAcc, slope) && corrSpeed > PHEMlightdll::Constants::ZERO_SPEED_ACCURACY) {
+            return PollutantsInterface::Emissions();
+        }
+        power = currCep->CalcPower(corrSpeed, corrAcc, slope);
+    }
+    const std::string& fuelType = oldCep != 0 ? oldCep->GetVehicleFuelType() : currCep->getFuelType();
+    const double fc = getEmission(oldCep, currCep, "FC", power, corrSpeed);
+    const double co = getEmission(oldCep, currCep, "CO", power, corrSpeed);
+    const double hc = getEmission(oldCep, currCep, "HC", power, corrSpeed);
+    const double nox = getEmission(oldCep, currCep, "NOx", power, corrSpeed);
+    const double pm = getEmission(oldCep, currCep, "PM", power, corrSpeed);
+    const double co2 = oldCep != 0 ? fc * 3.15 : currCep->GetCO2Emission(fc, co, hc, &myHelper);
+    double fuel = 0.;
+    double elec = 0.;
+    if (fuelType == PHEMlightdll::Constants::strDiesel) { // divide by average diesel density of 836 g/l
+        fuel = fc / 836. / SECONDS_PER_HOUR * 1000.;
+    } else if (fuelType == PHEMlightdll::Constants::strGasoline) { // divide by average gasoline density of 742 g/l
+        fuel = fc / 742. / SECONDS_PER_HOUR * 1000.;
+    } else if (fuelType == PHEMlightdll::Constants::strBEV) {
+        elec = fc / SECONDS_PER_HOUR * 1000.;
+    } else {
+        fuel = fc / SECONDS_PER_HOUR * 1000.; // surely false, but at least not additionally modified
+    }
+    return PollutantsInterface::Emissions(co2 / SECONDS_PER_HOUR * 1000., co / SECONDS_PER_HOUR * 1000., hc / SECONDS_PER_HOUR * 1000.,
+                                          fuel, nox / SECONDS_PER_HOUR * 1000., pm / SECONDS_PER_HOUR * 1000., elec);
+}
+
+
 /****************************************************************************/
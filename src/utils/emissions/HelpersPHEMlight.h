@@ -111,6 +111,17 @@ public:
      */
     double compute(const SUMOEmissionClass c, const PollutantsInterface::EmissionType e, const double v, const double a, const double slope, const std::map<int, double>* param) const;
 
+    /** @brief Returns the amount of all emitted pollutants given the vehicle type and state (in mg/s or in ml/s for fuel)
+     * The power demand is computed only once and each emission curve is evaluated only once
+     *  (CO2 is derived from the already evaluated fuel consumption, CO and HC values).
+     * @param[in] c The vehicle emission class
+     * @param[in] v The vehicle's current velocity
+     * @param[in] a The vehicle's current acceleration
+     * @param[in] slope The road's slope at vehicle's position [deg]
+     * @return The amounts of the pollutants emitted by the given emission class when moving with the given velocity and acceleration [mg/s or ml/s]
+     */
+    PollutantsInterface::Emissions computeAll(const SUMOEmissionClass c, const double v, const double a, const double slope, const std::map<int, double>* param) const;
+
     /** @brief Returns the adapted acceleration value, useful for comparing with external PHEMlight references.
      * @param[in] c the emission class
      * @param[in] v the speed value
@@ -130,6 +141,12 @@ private:
     */
     double getEmission(const PHEMCEP* oldCep, PHEMlightdll::CEP* currCep, const std::string& e, const double p, const double v) const;
 
+    /// @brief Returns the PHEMlight CEP of the given class (or 0 if there is none)
+    PHEMlightdll::CEP* getCEP(const SUMOEmissionClass c) const {
+        const std::map<SUMOEmissionClass, PHEMlightdll::CEP*>::const_iterator it = myCEPs.find(c);
+        return it == myCEPs.end() ? 0 : it->second;
+    }
+
     /// @brief the index of the next class
     int myIndex;
     PHEMlightdll::CEPHandler myCEPHandler;
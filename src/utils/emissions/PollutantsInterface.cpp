@@ -137,10 +137,17 @@ PollutantsInterface::compute(const SUMOEmissionClass c, const EmissionType e, co
 
 PollutantsInterface::Emissions
 PollutantsInterface::computeAll(const SUMOEmissionClass c, const double v, const double a, const double slope, const std::map<int, double>* param) {
-    const Helper* const h = myHelpers[c >> 16];
-    return Emissions(h->compute(c, CO2, v, a, slope, param), h->compute(c, CO, v, a, slope, param), h->compute(c, HC, v, a, slope, param),
-                     h->compute(c, FUEL, v, a, slope, param), h->compute(c, NO_X, v, a, slope, param), h->compute(c, PM_X, v, a, slope, param),
-                     h->compute(c, ELEC, v, a, slope, param));
+    return myHelpers[c >> 16]->computeAll(c, v, a, slope, param);
+}
+
+
+void
+PollutantsInterface::computeAll(const SUMOEmissionClass c, const std::vector<double>& v, const std::vector<double>& a, const std::vector<double>& slope, std::vector<Emissions>& into) {
+    const int n = (int)v.size();
+    into.resize(n);
+    if (n > 0) {
+        myHelpers[c >> 16]->computeBatch(c, n, &v[0], &a[0], &slope[0], &into[0]);
+    }
 }
 
 
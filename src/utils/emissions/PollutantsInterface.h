@@ -230,6 +230,38 @@ public:
          */
         virtual double compute(const SUMOEmissionClass c, const EmissionType e, const double v, const double a, const double slope, const std::map<int, double>* param) const = 0;
 
+        /** @brief Returns the amount of all emitted pollutants given the vehicle type and state (in mg/s or ml/s for fuel)
+         * Models which share intermediate results (like the power demand) between the pollutants
+         *  should override this, the default implementation calls compute for each pollutant.
+         * @param[in] c The vehicle emission class
+         * @param[in] v The vehicle's current velocity
+         * @param[in] a The vehicle's current acceleration
+         * @param[in] slope The road's slope at vehicle's position [deg]
+         * @return The amounts emitted by the given emission class when moving with the given velocity and acceleration [mg/s or ml/s]
+         */
+        virtual Emissions computeAll(const SUMOEmissionClass c, const double v, const double a, const double slope, const std::map<int, double>* param) const {
+            return Emissions(compute(c, CO2, v, a, slope, param), compute(c, CO, v, a, slope, param), compute(c, HC, v, a, slope, param),
+                             compute(c, FUEL, v, a, slope, param), compute(c, NO_X, v, a, slope, param), compute(c, PM_X, v, a, slope, param),
+                             compute(c, ELEC, v, a, slope, param));
+        }
+
+        /** @brief Computes all pollutants for a batch of vehicle states of the same emission class
+         * The states are given as separate arrays (structure of arrays) so models with
+         *  a closed form can evaluate them in tight loops. The default implementation
+         *  calls computeAll for each state.
+         * @param[in] c The vehicle emission class
+         * @param[in] n The number of states
+         * @param[in] v The velocities
+         * @param[in] a The accelerations
+         * @param[in] slope The slopes [deg]
+         * @param[out] into The emissions per state [mg/s or ml/s]
+         */
+        virtual void computeBatch(const SUMOEmissionClass c, const int n, const double* v, const double* a, const double* slope, Emissions* into) const {
+            for (int i = 0; i < n; i++) {
+                into[i] = computeAll(c, v[i], a[i], slope[i], 0);
+            }
+        }
+
         /** @brief Returns the adapted acceleration value, useful for comparing with external PHEMlight references.
          * Default implementation returns always the input accel.
          * @param[in] c the emission class
@@ -369,6 +401,16 @@ public:
     static Emissions computeAll(const SUMOEmissionClass c, const double v, const double a, const double slope, const std::map<int, double>* param = 0);
 
 
+    /** @brief Computes all emitted pollutants for a batch of vehicle states of the same emission class (in mg/s or ml/s for fuel)
+     * @param[in] c The vehicle emission class
+     * @param[in] v The velocities
+     * @param[in] a The accelerations (same size as v)
+     * @param[in] slope The slopes [deg] (same size as v)
+     * @param[out] into The emissions per state, resized to the size of v
+     */
+    static void computeAll(const SUMOEmissionClass c, const std::vector<double>& v, const std::vector<double>& a, const std::vector<double>& slope, std::vector<Emissions>& into);
+
+
     /** @brief Returns the amount of emitted pollutant given the vehicle type and default values for the state (in mg)
      * @param[in] c The vehicle emission class
      * @param[in] e the type of emission (CO, CO2, ...)
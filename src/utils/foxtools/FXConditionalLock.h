@@ -0,0 +1,79 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2004-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    FXConditionalLock.h
+/// @author  Michael Behrisch
+/// @date    2018-11-14
+/// @version $Id$
+///
+// A scoped lock which only triggers on condition
+/****************************************************************************/
+
+#ifndef FXConditionalLock_h
+#define FXConditionalLock_h
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <fx.h>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class FXConditionalLock
+ * @brief A scoped lock which only triggers on condition
+ *
+ * Locks the given mutex on construction and unlocks it on destruction
+ *  but only if the condition was true at construction time. This allows to
+ *  skip the locking overhead when running single threaded.
+ */
+class FXConditionalLock {
+public:
+    /// @brief Constructor, locks the mutex if condition is true
+    FXConditionalLock(FXMutex& fxMutex, const bool condition)
+        : myMutex(fxMutex), myCondition(condition) {
+        if (condition) {
+            fxMutex.lock();
+        }
+    }
+
+    /// @brief Destructor, unlocks the mutex if it was locked
+    ~FXConditionalLock() {
+        if (myCondition) {
+            myMutex.unlock();
+        }
+    }
+
+private:
+    /// @brief the mutex to lock
+    FXMutex& myMutex;
+
+    /// @brief whether the mutex was locked
+    const bool myCondition;
+
+private:
+    /// @brief invalidated copy constructor
+    FXConditionalLock(const FXConditionalLock&);
+
+    /// @brief invalidated assignment operator
+    FXConditionalLock& operator=(const FXConditionalLock&);
+};
+
+
+#endif
+
+/****************************************************************************/
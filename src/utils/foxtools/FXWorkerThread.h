@@ -28,6 +28,7 @@
 #include <config.h>
 #endif
 
+#include <algorithm>
 #include <list>
 #include <vector>
 #include <fx.h>
@@ -88,8 +89,9 @@ public:
          * May initialize the pool with a given number of workers.
          *
          * @param[in] numThreads the number of threads to create
+         * @param[in] workStealing whether idle workers may take over the pending tasks of other workers
          */
-        Pool(int numThreads = 0) : myPoolMutex(true), myRunningIndex(0), myNumFinished(0) {
+        Pool(int numThreads = 0, const bool workStealing = false) : myPoolMutex(true), myRunningIndex(0), myNumFinished(0), myWorkStealing(workStealing) {
             while (numThreads > 0) {
                 new FXWorkerThread(*this);
                 numThreads--;
@@ -107,6 +109,10 @@ public:
         /** @brief Stops and deletes all worker threads.
          */
         void clear() {
+            // stop all threads first, a running thread may still try to steal from the others
+            for (std::vector<FXWorkerThread*>::iterator it = myWorkers.begin(); it != myWorkers.end(); ++it) {
+                (*it)->stop();
+            }
             for (std::vector<FXWorkerThread*>::iterator it = myWorkers.begin(); it != myWorkers.end(); ++it) {
                 delete *it;
             }
@@ -119,7 +125,9 @@ public:
          */
         void addWorker(FXWorkerThread* const w) {
 //            if (myWorkers.empty()) std::cout << "created pool at " << SysUtils::getCurrentMillis() << std::endl;
+            myWorkersMutex.lock();
             myWorkers.push_back(w);
+            myWorkersMutex.unlock();
         }
 
         /** @brief Gives a number to the given task and assigns it to the worker with the given index.
@@ -136,20 +144,47 @@ public:
             myWorkers[index]->add(t);
         }
 
-        /** @brief Adds the given task to the list of finished tasks and assigns it to a randomly chosen worker.
+        /** @brief Adds the given tasks to the list of finished tasks.
          *
-         * Locks the internal mutex and counts the finished tasks. This is to be called by the worker thread only.
+         * Locks the internal mutex and counts the finished tasks. This is to be called by the worker thread only
+         *  which reports its finished tasks in bulk whenever it runs out of work.
          *
-         * @param[in] t the task to add
+         * @param[in] tasks the finished tasks, the list is emptied
          */
-        void addFinished(Task* const t) {
+        void addFinished(std::list<Task*>& tasks) {
+            if (tasks.empty()) {
+                return;
+            }
             myMutex.lock();
-            myNumFinished++;
-            myFinishedTasks.push_back(t);
+            myNumFinished += (int)tasks.size();
+            myFinishedTasks.splice(myFinishedTasks.end(), tasks);
             myCondition.signal();
             myMutex.unlock();
         }
 
+        /** @brief Takes a pending task from another worker if work stealing is enabled.
+         *
+         * The workers are visited starting with the one after the thief and the most recently added task is taken
+         *  from the first worker which has one. This is to be called by the worker thread only.
+         *
+         * @param[in] thief the worker which ran out of tasks
+         * @return the stolen task or 0 if there is none
+         */
+        Task* steal(const FXWorkerThread* const thief) {
+            if (!myWorkStealing) {
+                return 0;
+            }
+            Task* t = 0;
+            myWorkersMutex.lock();
+            const int numWorkers = (int)myWorkers.size();
+            const int start = (int)(std::find(myWorkers.begin(), myWorkers.end(), thief) - myWorkers.begin());
+            for (int i = 1; i < numWorkers && t == 0; i++) {
+                t = myWorkers[(start + i) % numWorkers]->popBack();
+            }
+            myWorkersMutex.unlock();
+            return t;
+        }
+
         /// @brief waits for all tasks to be finished
         void waitAll(const bool deleteFinished = true) {
             myMutex.lock();
@@ -200,6 +235,8 @@ public:
     private:
         /// @brief the current worker threads
         std::vector<FXWorkerThread*> myWorkers;
+        /// @brief the mutex guarding the worker list against additions while others are stealing
+        FXMutex myWorkersMutex;
         /// @brief the internal mutex for the task list
         FXMutex myMutex;
         /// @brief the pool mutex for external sync
@@ -212,6 +249,8 @@ public:
         int myRunningIndex;
         /// @brief the number of finished tasks (is reset when the pool runs empty)
         int myNumFinished;
+        /// @brief whether idle workers take pending tasks from the other workers
+        const bool myWorkStealing;
     };
 
 public:
@@ -245,30 +284,56 @@ public:
         myMutex.unlock();
     }
 
+    /** @brief Removes the most recently added pending task of this thread (used for work stealing)
+     *
+     * @return the removed task or 0 if there is no pending task
+     */
+    Task* popBack() {
+        Task* t = 0;
+        myMutex.lock();
+        if (!myTasks.empty()) {
+            t = myTasks.back();
+            myTasks.pop_back();
+        }
+        myMutex.unlock();
+        return t;
+    }
+
     /** @brief Main execution method of this thread.
      *
-     * Checks for new tasks, calculates them and puts them in the finished list of the pool until being stopped.
+     * Checks for new tasks (own ones first, then the ones of other workers if the pool allows stealing),
+     *  calculates them and puts them in the finished list of the pool when running out of work until being stopped.
      *
      * @return always 0
      */
     FXint run() {
+        std::list<Task*> finished;
         while (!myStopped) {
+            Task* t = 0;
             myMutex.lock();
-            while (!myStopped && myTasks.empty()) {
-                myCondition.wait(myMutex);
+            if (!myTasks.empty()) {
+                t = myTasks.front();
+                myTasks.pop_front();
+            }
+            myMutex.unlock();
+            if (t == 0) {
+                t = myPool.steal(this);
             }
-            if (myStopped) {
+            if (t == 0) {
+                myPool.addFinished(finished);
+                myMutex.lock();
+                while (!myStopped && myTasks.empty()) {
+                    myCondition.wait(myMutex);
+                }
                 myMutex.unlock();
-                break;
+                continue;
             }
-            Task* t = myTasks.front();
-            myTasks.pop_front();
-            myMutex.unlock();
             t->run(this);
             myCounter++;
 //            if (myCounter % 1000 == 0) std::cout << (int)this << " ran " << myCounter << " tasks " << std::endl;
-            myPool.addFinished(t);
+            finished.push_back(t);
         }
+        myPool.addFinished(finished);
 //        std::cout << "ran " << myCounter << " tasks " << std::endl;
         return 0;
     }
@@ -28,6 +28,7 @@
 
 #include <string>
 #include <utils/common/StdDefs.h>
+#include <utils/common/UtilExceptions.h>
 #include <utils/geom/Position.h>
 #include "BinaryFormatter.h"
 #include "BinaryInputDevice.h"
@@ -43,7 +44,7 @@
 // ===========================================================================
 BinaryInputDevice::BinaryInputDevice(const std::string& name,
                                      const bool isTyped, const bool doValidate)
-    : myStream(name.c_str(), std::fstream::in | std::fstream::binary),
+    : myName(name), myStream(name.c_str(), std::fstream::in | std::fstream::binary),
       myAmTyped(isTyped), myEnableValidation(doValidate) {}
 
 
@@ -79,7 +80,7 @@ int
 BinaryInputDevice::checkType(BinaryFormatter::DataType t) {
     if (myAmTyped) {
         char c;
-        myStream.read(&c, sizeof(char));
+        readRaw(&c, sizeof(char));
         if (myEnableValidation && c != t) {
             throw ProcessError("Unexpected type.");
         }
@@ -89,10 +90,19 @@ BinaryInputDevice::checkType(BinaryFormatter::DataType t) {
 }
 
 
+void
+BinaryInputDevice::readRaw(void* into, const int numBytes) {
+    myStream.read((char*) into, numBytes);
+    if (myStream.gcount() != numBytes) {
+        throw ProcessError("Unexpected end of binary file '" + myName + "'.");
+    }
+}
+
+
 BinaryInputDevice&
 operator>>(BinaryInputDevice& os, char& c) {
     os.checkType(BinaryFormatter::BF_BYTE);
-    os.myStream.read(&c, sizeof(char));
+    os.readRaw(&c, sizeof(char));
     return os;
 }
 
@@ -100,7 +110,7 @@ operator>>(BinaryInputDevice& os, char& c) {
 BinaryInputDevice&
 operator>>(BinaryInputDevice& os, unsigned char& c) {
     os.checkType(BinaryFormatter::BF_BYTE);
-    os.myStream.read((char*) &c, sizeof(unsigned char));
+    os.readRaw(&c, sizeof(unsigned char));
     return os;
 }
 
@@ -108,7 +118,7 @@ operator>>(BinaryInputDevice& os, unsigned char& c) {
 BinaryInputDevice&
 operator>>(BinaryInputDevice& os, int& i) {
     os.checkType(BinaryFormatter::BF_INTEGER);
-    os.myStream.read((char*) &i, sizeof(int));
+    os.readRaw(&i, sizeof(int));
     return os;
 }
 
@@ -118,10 +128,10 @@ operator>>(BinaryInputDevice& os, double& f) {
     int t = os.checkType(BinaryFormatter::BF_FLOAT);
     if (t == BinaryFormatter::BF_SCALED2INT) {
         int v;
-        os.myStream.read((char*) &v, sizeof(int));
+        os.readRaw(&v, sizeof(int));
         f = v / 100.;
     } else {
-        os.myStream.read((char*) &f, sizeof(double));
+        os.readRaw(&f, sizeof(double));
     }
     return os;
 }
@@ -131,7 +141,7 @@ BinaryInputDevice&
 operator>>(BinaryInputDevice& os, bool& b) {
     os.checkType(BinaryFormatter::BF_BYTE);
     b = false;
-    os.myStream.read((char*) &b, sizeof(char));
+    os.readRaw(&b, sizeof(char));
     return os;
 }
 
@@ -140,11 +150,11 @@ BinaryInputDevice&
 operator>>(BinaryInputDevice& os, std::string& s) {
     os.checkType(BinaryFormatter::BF_STRING);
     int size;
-    os.myStream.read((char*) &size, sizeof(int));
+    os.readRaw(&size, sizeof(int));
     int done = 0;
     while (done < size) {
         const int toRead = MIN2((int)size - done, (int)BUF_MAX - 1);
-        os.myStream.read((char*) &os.myBuffer, sizeof(char)*toRead);
+        os.readRaw(os.myBuffer, sizeof(char)*toRead);
         os.myBuffer[toRead] = 0;
         s += std::string(os.myBuffer);
         done += toRead;
@@ -157,7 +167,7 @@ BinaryInputDevice&
 operator>>(BinaryInputDevice& os, std::vector<std::string>& v) {
     os.checkType(BinaryFormatter::BF_LIST);
     int size;
-    os.myStream.read((char*) &size, sizeof(int));
+    os.readRaw(&size, sizeof(int));
     while (size > 0) {
         std::string s;
         os >> s;
@@ -172,7 +182,7 @@ BinaryInputDevice&
 operator>>(BinaryInputDevice& os, std::vector<int>& v) {
     os.checkType(BinaryFormatter::BF_LIST);
     int size;
-    os.myStream.read((char*) &size, sizeof(int));
+    os.readRaw(&size, sizeof(int));
     while (size > 0) {
         int i;
         os >> i;
@@ -187,7 +197,7 @@ BinaryInputDevice&
 operator>>(BinaryInputDevice& os, std::vector< std::vector<int> >& v) {
     os.checkType(BinaryFormatter::BF_LIST);
     int size;
-    os.myStream.read((char*) &size, sizeof(int));
+    os.readRaw(&size, sizeof(int));
     while (size > 0) {
         std::vector<int> nested;
         os >> nested;
@@ -202,21 +212,21 @@ BinaryInputDevice&
 operator>>(BinaryInputDevice& os, Position& p) {
     int t = os.checkType(BinaryFormatter::BF_POSITION_2D);
     double x, y, z = 0;
-    if (t == BinaryFormatter::BF_SCALED2INT_POSITION_2D || t == BinaryFormatter::BF_SCALED2INT_POSITION_2D) {
+    if (t == BinaryFormatter::BF_SCALED2INT_POSITION_2D || t == BinaryFormatter::BF_SCALED2INT_POSITION_3D) {
         int v;
-        os.myStream.read((char*) &v, sizeof(int));
+        os.readRaw(&v, sizeof(int));
         x = v / 100.;
-        os.myStream.read((char*) &v, sizeof(int));
+        os.readRaw(&v, sizeof(int));
         y = v / 100.;
         if (t == BinaryFormatter::BF_SCALED2INT_POSITION_3D) {
-            os.myStream.read((char*) &v, sizeof(int));
+            os.readRaw(&v, sizeof(int));
             z = v / 100.;
         }
     } else {
-        os.myStream.read((char*) &x, sizeof(double));
-        os.myStream.read((char*) &y, sizeof(double));
+        os.readRaw(&x, sizeof(double));
+        os.readRaw(&y, sizeof(double));
         if (t == BinaryFormatter::BF_POSITION_3D) {
-            os.myStream.read((char*) &z, sizeof(double));
+            os.readRaw(&z, sizeof(double));
         }
     }
     p.set(x, y, z);
@@ -217,7 +217,13 @@ public:
 private:
     int checkType(BinaryFormatter::DataType t);
 
+    /// @brief Reads the given number of bytes, throws a ProcessError if the file ends before
+    void readRaw(void* into, const int numBytes);
+
 private:
+    /// @brief The name of the file
+    const std::string myName;
+
     /// @brief The encapsulated stream
     std::ifstream myStream;
 
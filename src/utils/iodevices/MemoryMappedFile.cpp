@@ -0,0 +1,117 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2018-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    MemoryMappedFile.cpp
+/// @author  Michael Behrisch
+/// @date    2018-11-26
+/// @version $Id$
+///
+// Read only access to a file mapped into memory
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <utils/common/UtilExceptions.h>
+#include "MemoryMappedFile.h"
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#else
+#define NOMINMAX
+#include <windows.h>
+#undef NOMINMAX
+#endif
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+#ifndef WIN32
+MemoryMappedFile::MemoryMappedFile(const std::string& name) :
+    myData(0), mySize(0) {
+    const int fd = open(name.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw ProcessError("Could not open '" + name + "'.");
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw ProcessError("Could not determine the size of '" + name + "'.");
+    }
+    mySize = (long long int)info.st_size;
+    if (mySize > 0) {
+        void* data = mmap(0, (size_t)mySize, PROT_READ, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            throw ProcessError("Could not map '" + name + "' into memory.");
+        }
+        myData = (const char*)data;
+    }
+    // the mapping stays valid after closing the descriptor
+    close(fd);
+}
+
+
+MemoryMappedFile::~MemoryMappedFile() {
+    if (myData != 0) {
+        munmap((void*)myData, (size_t)mySize);
+    }
+}
+
+#else
+MemoryMappedFile::MemoryMappedFile(const std::string& name) :
+    myData(0), mySize(0), myFile(INVALID_HANDLE_VALUE), myMapping(0) {
+    myFile = CreateFileA(name.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (myFile == INVALID_HANDLE_VALUE) {
+        throw ProcessError("Could not open '" + name + "'.");
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(myFile, &size)) {
+        CloseHandle(myFile);
+        throw ProcessError("Could not determine the size of '" + name + "'.");
+    }
+    mySize = (long long int)size.QuadPart;
+    if (mySize > 0) {
+        myMapping = CreateFileMapping(myFile, 0, PAGE_READONLY, 0, 0, 0);
+        if (myMapping != 0) {
+            myData = (const char*)MapViewOfFile(myMapping, FILE_MAP_READ, 0, 0, 0);
+        }
+        if (myData == 0) {
+            if (myMapping != 0) {
+                CloseHandle(myMapping);
+            }
+            CloseHandle(myFile);
+            throw ProcessError("Could not map '" + name + "' into memory.");
+        }
+    }
+}
+
+
+MemoryMappedFile::~MemoryMappedFile() {
+    if (myData != 0) {
+        UnmapViewOfFile(myData);
+        CloseHandle(myMapping);
+    }
+    CloseHandle(myFile);
+}
+#endif
+
+
+/****************************************************************************/
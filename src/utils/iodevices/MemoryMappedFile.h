@@ -0,0 +1,91 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2018-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    MemoryMappedFile.h
+/// @author  Michael Behrisch
+/// @date    2018-11-26
+/// @version $Id$
+///
+// Read only access to a file mapped into memory
+/****************************************************************************/
+#ifndef MemoryMappedFile_h
+#define MemoryMappedFile_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <string>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MemoryMappedFile
+ * @brief Read only access to a file mapped into memory
+ *
+ * The pages of the file are loaded lazily by the operating system and shared
+ *  between all processes mapping the same file, so large precomputed tables
+ *  do not need to be parsed or copied.
+ */
+class MemoryMappedFile {
+public:
+    /** @brief Constructor, maps the whole file
+     *
+     * @param[in] name The name of the file to map
+     * @exception ProcessError If the file could not be opened or mapped
+     */
+    MemoryMappedFile(const std::string& name);
+
+    /// @brief Destructor, unmaps the file
+    ~MemoryMappedFile();
+
+    /// @brief Returns the start of the mapped data
+    const char* getData() const {
+        return myData;
+    }
+
+    /// @brief Returns the size of the mapped data in bytes
+    long long int getSize() const {
+        return mySize;
+    }
+
+private:
+    /// @brief the start of the mapped data
+    const char* myData;
+
+    /// @brief the size of the mapped data in bytes
+    long long int mySize;
+
+#ifdef WIN32
+    /// @brief the handles of the file and the mapping
+    void* myFile;
+    void* myMapping;
+#endif
+
+private:
+    /// @brief Invalidated copy constructor.
+    MemoryMappedFile(const MemoryMappedFile&);
+
+    /// @brief Invalidated assignment operator.
+    MemoryMappedFile& operator=(const MemoryMappedFile&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
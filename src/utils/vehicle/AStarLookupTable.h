@@ -27,8 +27,11 @@
 #include <config.h>
 #endif
 
+#include <cstring>
 #include <iostream>
 #include <fstream>
+#include <utils/common/StringUtils.h>
+#include <utils/iodevices/MemoryMappedFile.h>
 
 #ifdef HAVE_FOX
 #include <utils/foxtools/FXWorkerThread.h>
@@ -62,6 +65,9 @@
 template<class E, class V>
 class AbstractLookupTable {
 public:
+    /// @brief Destructor
+    virtual ~AbstractLookupTable() {}
+
     /// @brief provide a lower bound on the distance between from and to (excluding traveltime of both edges)
     virtual double lowerBound(const E* from, const E* to, double speed, double speedFactor, double fromEffort, double toEffort) const = 0;
 
@@ -70,23 +76,27 @@ public:
 };
 
 
+/**
+ * @class FullLookupTable
+ * @brief The complete distance matrix (as written by marouter --all-pairs-output)
+ *
+ * The file is mapped into memory, so it is neither parsed nor copied and
+ *  processes using the same file share the memory.
+ */
 template<class E, class V>
 class FullLookupTable : public AbstractLookupTable<E, V> {
 public:
     FullLookupTable(const std::string& filename, const int size) :
-        myTable(size) {
-        BinaryInputDevice dev(filename);
-        for (int i = 0; i < size; i++) {
-            for (int j = 0; j < size; j++) {
-                double val;
-                dev >> val;
-                myTable[i].push_back(val);
-            }
+        mySize(size),
+        myFile(filename),
+        myTable((const double*)myFile.getData()) {
+        if (myFile.getSize() < (long long int)size * size * (long long int)sizeof(double)) {
+            throw ProcessError("The lookup table '" + filename + "' is too small for " + toString(size) + " edges.");
         }
     }
 
     double lowerBound(const E* from, const E* to, double /*speed*/, double speedFactor, double /*fromEffort*/, double /*toEffort*/) const {
-        return myTable[from->getNumericalID()][to->getNumericalID()] / speedFactor;
+        return myTable[(long long int)from->getNumericalID() * mySize + to->getNumericalID()] / speedFactor;
     }
 
     bool consistent() const {
@@ -94,14 +104,33 @@ public:
     }
 
 private:
-    std::vector<std::vector<double> > myTable;
+    /// @brief the number of rows and columns
+    const int mySize;
+    /// @brief the mapped file
+    const MemoryMappedFile myFile;
+    /// @brief the matrix in row major order
+    const double* const myTable;
 };
 
 
+/**
+ * @class LandmarkLookupTable
+ * @brief The distances from and to a set of landmarks for the ALT variant of A*
+ *
+ * The table is either read from a text file (landmark ids followed by lines
+ *  "landmark edge distFrom distTo", missing values are computed using the given router)
+ *  or mapped into memory from a binary file. The binary file (written when the output
+ *  name ends with ".bin") starts with the magic "SLMT", followed by the version, the number
+ *  of landmarks and the number of (non internal) edges as int32 and a hash of the edge ids
+ *  as uint64. Then the distances from all landmarks and to all landmarks follow as
+ *  double matrices (one row per landmark) and finally the landmark ids, each as
+ *  int32 length and characters. The byte order is the one of the writing machine.
+ */
 template<class E, class V>
 class LandmarkLookupTable : public AbstractLookupTable<E, V> {
 public:
-    LandmarkLookupTable(const std::string& filename, const std::vector<E*>& edges, SUMOAbstractRouter<E, V>* router, const V* defaultVehicle, const std::string& outfile, const int maxNumThreads) {
+    LandmarkLookupTable(const std::string& filename, const std::vector<E*>& edges, SUMOAbstractRouter<E, V>* router, const V* defaultVehicle, const std::string& outfile, const int maxNumThreads) :
+        myNumLandmarks(0), myNumEdges(0), myFromDists(0), myToDists(0), myFile(0) {
         myFirstNonInternal = -1;
         std::map<std::string, int> numericID;
         for (E* e : edges) {
@@ -112,12 +141,23 @@ public:
                 numericID[e->getID()] = e->getNumericalID() - myFirstNonInternal;
             }
         }
+        myNumEdges = myFirstNonInternal == -1 ? 0 : (int)edges.size() - myFirstNonInternal;
+        if (isBinaryFile(filename)) {
+            loadBinary(filename, edges);
+            if (!outfile.empty()) {
+                save(outfile, edges);
+            }
+            return;
+        }
         std::ifstream strm(filename.c_str());
         if (!strm.good()) {
             throw ProcessError("Could not load landmark-lookup-table from '" + filename + "'.");
         }
+        const bool binaryOutput = StringUtils::endsWith(outfile, ".bin");
+        std::vector<std::vector<double> > fromDists;
+        std::vector<std::vector<double> > toDists;
         std::ofstream* ostrm = 0;
-        if (!outfile.empty()) {
+        if (!outfile.empty() && !binaryOutput) {
             ostrm = new std::ofstream(outfile.c_str());
             if (!ostrm->good()) {
                 throw ProcessError("Could not open file '" + outfile + "' for writing.");
@@ -134,8 +174,8 @@ public:
             if (st.size() == 1) {
                 const std::string lm = st.get(0);
                 myLandmarks[lm] = numLandMarks++;
-                myFromLandmarkDists.push_back(std::vector<double>(0));
-                myToLandmarkDists.push_back(std::vector<double>(0));
+                fromDists.push_back(std::vector<double>(0));
+                toDists.push_back(std::vector<double>(0));
                 if (ostrm != 0) {
                     (*ostrm) << lm << "\n";
                 }
@@ -143,13 +183,13 @@ public:
                 assert(st.size() == 4);
                 const std::string lm = st.get(0);
                 const std::string edge = st.get(1);
-                if (numericID[edge] != (int)myFromLandmarkDists[myLandmarks[lm]].size()) {
+                if (numericID[edge] != (int)fromDists[myLandmarks[lm]].size()) {
                     WRITE_WARNING("Unknown or unordered edge '" + edge + "' in landmark file.");
                 }
                 const double distFrom = TplConvert::_2double(st.get(2).c_str());
                 const double distTo = TplConvert::_2double(st.get(3).c_str());
-                myFromLandmarkDists[myLandmarks[lm]].push_back(distFrom);
-                myToLandmarkDists[myLandmarks[lm]].push_back(distTo);
+                fromDists[myLandmarks[lm]].push_back(distFrom);
+                toDists[myLandmarks[lm]].push_back(distTo);
             }
         }
         if (myLandmarks.empty()) {
@@ -161,7 +201,7 @@ public:
         FXWorkerThread::Pool threadPool;
 #endif
         for (int i = 0; i < (int)myLandmarks.size(); ++i) {
-            if ((int)myFromLandmarkDists[i].size() != (int)edges.size() - myFirstNonInternal) {
+            if ((int)fromDists[i].size() != (int)edges.size() - myFirstNonInternal) {
                 const std::string landmarkID = getLandmark(i);
                 const E* landmark = 0;
                 // retrieve landmark edge
@@ -177,7 +217,7 @@ public:
                 if (router != 0) {
                     const std::string missing = outfile.empty() ? filename + ".missing" : outfile;
                     WRITE_WARNING("Not all network edges were found in the lookup table '" + filename + "' for landmark '" + landmarkID + "'. Saving missing values to '" + missing + "'.");
-                    if (ostrm == 0) {
+                    if (ostrm == 0 && !binaryOutput) {
                         ostrm = new std::ofstream(missing.c_str());
                         if (!ostrm->good()) {
                             throw ProcessError("Could not open file '" + missing + "' for writing.");
@@ -201,7 +241,7 @@ public:
                         }
                     }
                     std::vector<RoutingTask*> currentTasks;
-                    for (int j = (int)myFromLandmarkDists[i].size() + myFirstNonInternal; j < (int)edges.size(); ++j) {
+                    for (int j = (int)fromDists[i].size() + myFirstNonInternal; j < (int)edges.size(); ++j) {
                         const E* edge = edges[j];
                         if (landmark != edge) {
                             std::vector<const E*> routeE(1, edge);
@@ -220,7 +260,7 @@ public:
                     }
                     threadPool.waitAll(false);
                     int taskIndex = 0;
-                    for (int j = (int)myFromLandmarkDists[i].size() + myFirstNonInternal; j < (int)edges.size(); ++j) {
+                    for (int j = (int)fromDists[i].size() + myFirstNonInternal; j < (int)edges.size(); ++j) {
                         const E* edge = edges[j];
                         double distFrom = -1;
                         double distTo = -1;
@@ -237,15 +277,17 @@ public:
                                 delete currentTasks[taskIndex++];
                             }
                         }
-                        myFromLandmarkDists[i].push_back(distFrom);
-                        myToLandmarkDists[i].push_back(distTo);
-                        (*ostrm) << landmarkID << " " << edge->getID() << " " << distFrom << " " << distTo << "\n";
+                        fromDists[i].push_back(distFrom);
+                        toDists[i].push_back(distTo);
+                        if (ostrm != 0) {
+                            (*ostrm) << landmarkID << " " << edge->getID() << " " << distFrom << " " << distTo << "\n";
+                        }
                     }
                     currentTasks.clear();
                     continue;
                 }
 #endif
-                for (int j = (int)myFromLandmarkDists[i].size() + myFirstNonInternal; j < (int)edges.size(); ++j) {
+                for (int j = (int)fromDists[i].size() + myFirstNonInternal; j < (int)edges.size(); ++j) {
                     const E* edge = edges[j];
                     double distFrom = -1;
                     double distTo = -1;
@@ -270,13 +312,69 @@ public:
                             }
                         }
                     }
-                    myFromLandmarkDists[i].push_back(distFrom);
-                    myToLandmarkDists[i].push_back(distTo);
-                    (*ostrm) << landmarkID << " " << edge->getID() << " " << distFrom << " " << distTo << "\n";
+                    fromDists[i].push_back(distFrom);
+                    toDists[i].push_back(distTo);
+                    if (ostrm != 0) {
+                        (*ostrm) << landmarkID << " " << edge->getID() << " " << distFrom << " " << distTo << "\n";
+                    }
                 }
             }
         }
         delete ostrm;
+        // store all distances in one block, missing values are unreachable
+        myNumLandmarks = (int)myLandmarks.size();
+        myDists.assign(2 * myNumLandmarks * myNumEdges, -1.);
+        for (int i = 0; i < myNumLandmarks; ++i) {
+            std::copy(fromDists[i].begin(), fromDists[i].begin() + MIN2((int)fromDists[i].size(), myNumEdges), myDists.begin() + i * myNumEdges);
+            std::copy(toDists[i].begin(), toDists[i].begin() + MIN2((int)toDists[i].size(), myNumEdges), myDists.begin() + (myNumLandmarks + i) * myNumEdges);
+        }
+        myFromDists = myDists.data();
+        myToDists = myFromDists + myNumLandmarks * myNumEdges;
+        if (binaryOutput) {
+            save(outfile, edges);
+        }
+    }
+
+    /// @brief Destructor
+    ~LandmarkLookupTable() {
+        delete myFile;
+    }
+
+    /// @brief saves the table, in the binary format if the filename ends with ".bin"
+    void save(const std::string& filename, const std::vector<E*>& edges) const {
+        std::ofstream out(filename.c_str(), std::ios::binary);
+        if (!out.good()) {
+            throw ProcessError("Could not open file '" + filename + "' for writing.");
+        }
+        if (StringUtils::endsWith(filename, ".bin")) {
+            out.write("SLMT", 4);
+            const int header[3] = {BINARY_VERSION, myNumLandmarks, myNumEdges};
+            out.write((const char*)header, sizeof(header));
+            const unsigned long long hash = computeEdgeHash(edges);
+            out.write((const char*)&hash, sizeof(hash));
+            out.write((const char*)myFromDists, sizeof(double) * myNumLandmarks * myNumEdges);
+            out.write((const char*)myToDists, sizeof(double) * myNumLandmarks * myNumEdges);
+            for (int i = 0; i < myNumLandmarks; ++i) {
+                const std::string landmarkID = getLandmark(i);
+                const int length = (int)landmarkID.size();
+                out.write((const char*)&length, sizeof(length));
+                out.write(landmarkID.data(), length);
+            }
+        } else {
+            for (int i = 0; i < myNumLandmarks; ++i) {
+                out << getLandmark(i) << "\n";
+            }
+            for (int i = 0; i < myNumLandmarks; ++i) {
+                const std::string landmarkID = getLandmark(i);
+                for (int j = 0; j < myNumEdges; ++j) {
+                    out << landmarkID << " " << edges[j + myFirstNonInternal]->getID() << " "
+                        << myFromDists[i * myNumEdges + j] << " " << myToDists[i * myNumEdges + j] << "\n";
+                }
+            }
+        }
+        if (!out.good()) {
+            throw ProcessError("Could not write landmark-lookup-table to '" + filename + "'.");
+        }
     }
 
     double lowerBound(const E* from, const E* to, double speed, double speedFactor, double fromEffort, double toEffort) const {
@@ -286,10 +384,13 @@ public:
             std::cout << " lowerBound to=" << to->getID() << " result1=" << result << "\n";
         }
 #endif
-        for (int i = 0; i < (int)myLandmarks.size(); ++i) {
+        const int fromIndex = from->getNumericalID() - myFirstNonInternal;
+        const int toIndex = to->getNumericalID() - myFirstNonInternal;
+        for (int i = 0; i < myNumLandmarks; ++i) {
             // a cost of -1 is used to encode unreachability.
-            const double fl = myToLandmarkDists[i][from->getNumericalID() - myFirstNonInternal];
-            const double tl = myToLandmarkDists[i][to->getNumericalID() - myFirstNonInternal];
+            const double* const toLandmark = myToDists + i * myNumEdges;
+            const double fl = toLandmark[fromIndex];
+            const double tl = toLandmark[toIndex];
             if (fl >= 0 && tl >= 0) {
                 const double bound = (fl - tl - toEffort) / speedFactor;
 #ifdef ASTAR_DEBUG_LOOKUPTABLE
@@ -300,8 +401,9 @@ public:
 #endif
                 result = MAX2(result, bound);
             }
-            const double lt = myFromLandmarkDists[i][to->getNumericalID() - myFirstNonInternal];
-            const double lf = myFromLandmarkDists[i][from->getNumericalID() - myFirstNonInternal];
+            const double* const fromLandmark = myFromDists + i * myNumEdges;
+            const double lt = fromLandmark[toIndex];
+            const double lf = fromLandmark[fromIndex];
             if (lt >= 0 && lf >= 0) {
                 const double bound = (lt - lf - fromEffort) / speedFactor;
 #ifdef ASTAR_DEBUG_LOOKUPTABLE
@@ -331,12 +433,94 @@ public:
         return false;
     }
 
+private:
+    /// @brief whether the file starts with the magic of the binary format
+    static bool isBinaryFile(const std::string& filename) {
+        std::ifstream strm(filename.c_str(), std::ios::binary);
+        char magic[4];
+        return strm.read(magic, 4) && std::string(magic, 4) == "SLMT";
+    }
+
+    /// @brief a hash of the ids of the non internal edges (FNV-1a) to verify binary tables
+    unsigned long long computeEdgeHash(const std::vector<E*>& edges) const {
+        unsigned long long hash = 14695981039346656037ULL;
+        for (int j = 0; j < myNumEdges; ++j) {
+            const std::string& id = edges[j + myFirstNonInternal]->getID();
+            for (std::string::const_iterator c = id.begin(); c != id.end(); ++c) {
+                hash = (hash ^ (unsigned char)*c) * 1099511628211ULL;
+            }
+            // separator
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    /// @brief maps the given binary file and lets the distances point into it
+    void loadBinary(const std::string& filename, const std::vector<E*>& edges) {
+        myFile = new MemoryMappedFile(filename);
+        const char* const data = myFile->getData();
+        const long long int headerSize = 4 + 3 * sizeof(int) + sizeof(unsigned long long);
+        if (myFile->getSize() < headerSize) {
+            throw ProcessError("The landmark-lookup-table '" + filename + "' is truncated.");
+        }
+        int header[3];
+        memcpy(header, data + 4, sizeof(header));
+        unsigned long long hash;
+        memcpy(&hash, data + 4 + sizeof(header), sizeof(hash));
+        if (header[0] != BINARY_VERSION) {
+            throw ProcessError("Unsupported version " + toString(header[0]) + " of landmark-lookup-table '" + filename + "'.");
+        }
+        if (header[2] != myNumEdges || hash != computeEdgeHash(edges)) {
+            throw ProcessError("The landmark-lookup-table '" + filename + "' was computed for a different network.");
+        }
+        myNumLandmarks = header[1];
+        const long long int matrixSize = (long long int)myNumLandmarks * myNumEdges * sizeof(double);
+        if (myFile->getSize() < headerSize + 2 * matrixSize) {
+            throw ProcessError("The landmark-lookup-table '" + filename + "' is truncated.");
+        }
+        myFromDists = (const double*)(data + headerSize);
+        myToDists = myFromDists + myNumLandmarks * myNumEdges;
+        const char* pos = data + headerSize + 2 * matrixSize;
+        const char* const end = data + myFile->getSize();
+        for (int i = 0; i < myNumLandmarks; ++i) {
+            int length;
+            if (end - pos < (long long int)sizeof(length)) {
+                throw ProcessError("The landmark-lookup-table '" + filename + "' is truncated.");
+            }
+            memcpy(&length, pos, sizeof(length));
+            pos += sizeof(length);
+            if (length < 0 || end - pos < length) {
+                throw ProcessError("The landmark-lookup-table '" + filename + "' is truncated.");
+            }
+            myLandmarks[std::string(pos, length)] = i;
+            pos += length;
+        }
+        if (myNumLandmarks == 0) {
+            WRITE_WARNING("No landmarks in '" + filename + "', falling back to standard A*.");
+        }
+    }
+
 private:
     std::map<std::string, int> myLandmarks;
-    std::vector<std::vector<double> > myFromLandmarkDists;
-    std::vector<std::vector<double> > myToLandmarkDists;
     int myFirstNonInternal;
 
+    /// @brief the number of landmarks and (non internal) edges
+    int myNumLandmarks;
+    int myNumEdges;
+
+    /// @brief the distances from and to the landmarks (one row per landmark)
+    const double* myFromDists;
+    const double* myToDists;
+
+    /// @brief the storage for the distances if they were not mapped from a file
+    std::vector<double> myDists;
+
+    /// @brief the mapped binary file (or 0)
+    MemoryMappedFile* myFile;
+
+    /// @brief the version of the binary format
+    static const int BINARY_VERSION = 1;
+
 #ifdef HAVE_FOX
 private:
     class WorkerThread : public FXWorkerThread {
@@ -123,6 +123,9 @@ public:
         // init queue
         std::vector<CHInfo*> queue; // max heap: edge to be contracted is front
         // reset previous connections etc
+        myShortcutTerms.clear();
+        myForwardTerms.assign(numEdges, std::vector<int>());
+        myBackwardTerms.assign(numEdges, std::vector<int>());
         for (int i = 0; i < numEdges; i++) {
             myCHInfos[i].resetContractionState();
             result->forwardUplinks.push_back(std::vector<Connection>());
@@ -154,6 +157,7 @@ public:
             for (typename CHConnections::const_iterator it = max->followers.begin(); it != max->followers.end(); it++) {
                 const CHConnection& con = *it;
                 result->forwardUplinks[edgeID].push_back(Connection(con.target->edge->getNumericalID(), con.cost, con.permissions));
+                myForwardTerms[edgeID].push_back(con.term);
                 disconnect(con.target->approaching, max);
                 con.target->updatePriority(0);
             }
@@ -161,6 +165,7 @@ public:
             for (typename CHConnections::const_iterator it = max->approaching.begin(); it != max->approaching.end(); it++) {
                 const CHConnection& con = *it;
                 result->backwardUplinks[edgeID].push_back(Connection(con.target->edge->getNumericalID(), con.cost, con.permissions));
+                myBackwardTerms[edgeID].push_back(con.term);
                 disconnect(con.target->followers, max);
                 con.target->updatePriority(0);
             }
@@ -170,8 +175,10 @@ public:
                 result->shortcuts[edgePair] = edge;
                 CHInfo* from = getCHInfo(edgePair.first);
                 CHInfo* to = getCHInfo(edgePair.second);
-                from->followers.push_back(CHConnection(to, it->cost, it->permissions, it->underlying));
-                to->approaching.push_back(CHConnection(from, it->cost, it->permissions, it->underlying));
+                const int term = numEdges + (int)myShortcutTerms.size();
+                myShortcutTerms.push_back(it->terms);
+                from->followers.push_back(CHConnection(to, it->cost, it->permissions, it->underlying, term));
+                to->approaching.push_back(CHConnection(from, it->cost, it->permissions, it->underlying, term));
             }
             // if you need to debug the chrouter with MSVC uncomment the following line, hierarchy building will get slower and the hierarchy may change though
             //make_heap(queue.begin(), queue.end(), myCmp);
@@ -199,14 +206,65 @@ public:
         return result;
     }
 
+
+    /// @brief whether a hierarchy was built which can be customized
+    bool canCustomize() const {
+        return !myForwardTerms.empty();
+    }
+
+
+    /** @brief Recomputes the costs of the last built hierarchy for new edge efforts
+     *
+     * The contraction order and the shortcuts of the last call to buildContractionHierarchy
+     *  are kept, only the costs of the connections are recomputed. Each shortcut
+     *  cost is the sum of the two connections it replaces, which were all created
+     *  before the shortcut, so a single pass in creation order suffices.
+     * Since no witness searches are repeated, the routes are optimal only as long
+     *  as the witnesses found during contraction stay shorter than the shortcuts
+     *  they made unnecessary, they are always valid routes with the current costs though.
+     *
+     * @param[in] previous the hierarchy to take the structure from (it stays untouched and usable)
+     * @return the customized hierarchy
+     */
+    const Hierarchy* customizeContractionHierarchy(SUMOTime time, const V* const vehicle, const SUMOAbstractRouter<E, V>* effortProvider,
+            const Hierarchy* const previous) {
+        assert(canCustomize());
+        const int numEdges = (int)myCHInfos.size();
+        PROGRESS_BEGIN_MESSAGE("Customizing Contraction Hierarchy for time=" + time2string(time) + " (" + toString(myShortcutTerms.size()) + " shortcuts)");
+        const long startMillis = SysUtils::getCurrentMillis();
+        Hierarchy* result = new Hierarchy(*previous);
+        myTermCosts.resize(numEdges + myShortcutTerms.size());
+        const double time_seconds = STEPS2TIME(time); // timelines store seconds!
+        const bool prune = !mySPTree->validatePermissions();
+        for (int i = 0; i < numEdges; i++) {
+            const E* const edge = myCHInfos[i].edge;
+            if (prune && ((edge->getPermissions() & mySVC) != mySVC)) {
+                myTermCosts[i] = 0;
+            } else {
+                myTermCosts[i] = effortProvider->getEffort(edge, vehicle, time_seconds);
+            }
+        }
+        for (int i = 0; i < (int)myShortcutTerms.size(); i++) {
+            myTermCosts[numEdges + i] = myTermCosts[myShortcutTerms[i].first] + myTermCosts[myShortcutTerms[i].second];
+        }
+        for (int i = 0; i < numEdges; i++) {
+            customizeUplinks(result->forwardUplinks[i], myForwardTerms[i]);
+            customizeUplinks(result->backwardUplinks[i], myBackwardTerms[i]);
+        }
+        PROGRESS_TIME_MESSAGE(startMillis);
+        return result;
+    }
+
 private:
     struct Shortcut {
-        Shortcut(ConstEdgePair e, double c, int u, SVCPermissions p):
-            edgePair(e), cost(c), underlying(u), permissions(p) {}
+        Shortcut(ConstEdgePair e, double c, int u, SVCPermissions p, std::pair<int, int> t):
+            edgePair(e), cost(c), underlying(u), permissions(p), terms(t) {}
         ConstEdgePair edgePair;
         double cost;
         int underlying;
         SVCPermissions permissions;
+        /// the cost terms of the two connections this shortcut replaces
+        std::pair<int, int> terms;
     };
 
 
@@ -215,13 +273,15 @@ private:
     /// @brief Forward/backward connection with associated FORWARD cost
     class CHConnection {
     public:
-        CHConnection(CHInfo* t, double c, SVCPermissions p, int u):
-            target(t), cost(c), permissions(p), underlying(u) {}
+        CHConnection(CHInfo* t, double c, SVCPermissions p, int u, int term):
+            target(t), cost(c), permissions(p), underlying(u), term(term) {}
         CHInfo* target;
         double cost;
         SVCPermissions permissions;
         /// the number of connections underlying this connection
         int underlying;
+        /// the index of the cost term (the numerical id of the edge for original connections)
+        int term;
     };
 
     typedef std::vector<CHConnection> CHConnections;
@@ -284,7 +344,7 @@ private:
                         const int underlying = aInfo.underlying + fInfo.underlying;
                         underlyingTotal += underlying;
                         shortcuts.push_back(Shortcut(ConstEdgePair(aInfo.target->edge, fInfo.target->edge),
-                                                     viaCost, underlying, viaPermissions));
+                                                     viaCost, underlying, viaPermissions, std::make_pair(aInfo.term, fInfo.term)));
 
                     } else if (validatePermissions) {
                         if ((fInfo.target->permissions & viaPermissions) != viaPermissions) {
@@ -313,7 +373,7 @@ private:
                     const int underlying = aInfo->underlying + fInfo->underlying;
                     underlyingTotal += underlying;
                     shortcuts.push_back(Shortcut(ConstEdgePair(aInfo->target->edge, fInfo->target->edge),
-                                                 viaCost, underlying, viaPermissions));
+                                                 viaCost, underlying, viaPermissions, std::make_pair(aInfo->term, fInfo->term)));
                 }
             }
         }
@@ -442,8 +502,8 @@ private:
             }
             CHInfo* follower = getCHInfo(fEdge);
             SVCPermissions permissions = (edge->getPermissions() & follower->edge->getPermissions());
-            info.followers.push_back(CHConnection(follower, cost, permissions, 1));
-            follower->approaching.push_back(CHConnection(&info, cost, permissions, 1));
+            info.followers.push_back(CHConnection(follower, cost, permissions, 1, edge->getNumericalID()));
+            follower->approaching.push_back(CHConnection(&info, cost, permissions, 1, edge->getNumericalID()));
         }
 #ifdef CHRouter_DEBUG_WEIGHTS
         std::cout << time << ": " << edge->getID() << " cost: " << cost << "\n";
@@ -452,6 +512,14 @@ private:
     }
 
 
+    /// @brief sets the costs of the given uplinks from the recomputed cost terms
+    void customizeUplinks(std::vector<Connection>& uplinks, const std::vector<int>& terms) const {
+        for (int i = 0; i < (int)uplinks.size(); i++) {
+            uplinks[i].cost = myTermCosts[terms[i]];
+        }
+    }
+
+
     /// @brief remove all connections to/from the given edge (assume it exists only once)
     void disconnect(CHConnections& connections, CHInfo* other) {
         for (typename CHConnections::iterator it = connections.begin(); it != connections.end(); it++) {
@@ -513,6 +581,16 @@ private:
     /// @brief counters for performance logging
     int myUpdateCount;
 
+    /// @brief the cost terms of the shortcuts of the last build (offset by the number of edges)
+    std::vector<std::pair<int, int> > myShortcutTerms;
+
+    /// @brief the cost terms of the uplinks of the last build
+    std::vector<std::vector<int> > myForwardTerms;
+    std::vector<std::vector<int> > myBackwardTerms;
+
+    /// @brief the costs of the terms during customization
+    std::vector<double> myTermCosts;
+
 private:
     /// @brief Invalidated assignment operator
     CHBuilder& operator=(const CHBuilder& s);
@@ -260,11 +260,14 @@ public:
      * @param[in] validatePermissions Whether a multi-permission hierarchy shall be built
      *            If set to false, the net is pruned in synchronize() and the
      *            hierarchy is tailored to the svc
+     * @param[in] customize Whether the hierarchy is only customized (keeping the contraction order)
+     *            instead of being rebuilt when the weight period expires
      */
     CHRouter(const std::vector<E*>& edges, bool unbuildIsWarning, Operation operation,
              const SUMOVehicleClass svc,
              SUMOTime weightPeriod,
-             bool validatePermissions):
+             bool validatePermissions,
+             bool customize = false):
         SUMOAbstractRouter<E, V>(operation, "CHRouter"),
         myEdges(edges),
         myErrorMsgHandler(unbuildIsWarning ? MsgHandler::getWarningInstance() : MsgHandler::getErrorInstance()),
@@ -274,7 +277,8 @@ public:
         myHierarchy(0),
         myWeightPeriod(weightPeriod),
         myValidUntil(0),
-        mySVC(svc) {
+        mySVC(svc),
+        myCustomize(customize) {
     }
 
     /** @brief Cloning constructor
@@ -292,7 +296,8 @@ public:
         myHierarchy(hierarchy),
         myWeightPeriod(weightPeriod),
         myValidUntil(0),
-        mySVC(svc) {
+        mySVC(svc),
+        myCustomize(false) {
     }
 
     /// Destructor
@@ -412,8 +417,14 @@ public:
 
     void buildContractionHierarchy(SUMOTime time, const V* const vehicle) {
         if (myHierarchyBuilder != 0) {
-            delete myHierarchy;
-            myHierarchy = myHierarchyBuilder->buildContractionHierarchy(time, vehicle, this);
+            // the old hierarchy is kept until the new one is complete
+            const typename CHBuilder<E, V>::Hierarchy* const old = myHierarchy;
+            if (myCustomize && old != 0 && myHierarchyBuilder->canCustomize()) {
+                myHierarchy = myHierarchyBuilder->customizeContractionHierarchy(time, vehicle, this, old);
+            } else {
+                myHierarchy = myHierarchyBuilder->buildContractionHierarchy(time, vehicle, this);
+            }
+            delete old;
         }
         // declare new validUntil (prevent overflow)
         if (myWeightPeriod < std::numeric_limits<int>::max()) {
@@ -458,6 +469,9 @@ private:
 
     /// @brief the permissions for which the hierarchy was constructed
     const SUMOVehicleClass mySVC;
+
+    /// @brief whether later hierarchies are customized instead of rebuilt
+    const bool myCustomize;
 };
 
 
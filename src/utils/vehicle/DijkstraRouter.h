@@ -62,6 +62,11 @@
  *  and whether a missing connection between two given edges (unbuild route) shall
  *  be reported as an error or as a warning.
  *
+ * The search state is kept in compact arrays indexed by the numerical edge id.
+ *  Instead of resetting the touched entries after each query, every query gets a
+ *  new stamp and entries with an older stamp count as unreached. The frontier
+ *  is a heap of (effort, edge id) pairs where improved edges are pushed again
+ *  and outdated entries are skipped when they come to the front.
  */
 template<class E, class V, class PF>
 class DijkstraRouter : public SUMOAbstractRouter<E, V>, public PF {
@@ -69,73 +74,23 @@ class DijkstraRouter : public SUMOAbstractRouter<E, V>, public PF {
 public:
     typedef double(* Operation)(const E* const, const V* const, double);
 
-    /**
-     * @class EdgeInfo
-     * A definition about a route's edge with the effort needed to reach it and
-     *  the information about the previous edge.
-     */
-    class EdgeInfo {
-    public:
-        /// Constructor
-        EdgeInfo(const E* const e)
-            : edge(e), effort(std::numeric_limits<double>::max()), leaveTime(0), prev(0), visited(false) {}
-
-        /// The current edge
-        const E* const edge;
-
-        /// Effort to reach the edge
-        double effort;
-
-        /// The time the vehicle leaves the edge
-        double leaveTime;
-
-        /// The previous edge
-        const EdgeInfo* prev;
-
-        /// The previous edge
-        bool visited;
-
-        inline void reset() {
-            effort = std::numeric_limits<double>::max();
-            visited = false;
-        }
-
-    private:
-        /// @brief Invalidated assignment operator
-        EdgeInfo& operator=(const EdgeInfo& s) = delete;
-
-    };
-
-    /**
-     * @class EdgeInfoByEffortComparator
-     * Class to compare (and so sort) nodes by their effort
-     */
-    class EdgeInfoByEffortComparator {
-    public:
-        /// Comparing method
-        bool operator()(const EdgeInfo* nod1, const EdgeInfo* nod2) const {
-            if (nod1->effort == nod2->effort) {
-                return nod1->edge->getNumericalID() > nod2->edge->getNumericalID();
-            }
-            return nod1->effort > nod2->effort;
-        }
-    };
-
-
     /// Constructor
     DijkstraRouter(const std::vector<E*>& edges, bool unbuildIsWarning, Operation effortOperation, Operation ttOperation = nullptr) :
         SUMOAbstractRouter<E, V>(effortOperation, "DijkstraRouter"), myTTOperation(ttOperation),
+        myEdges(edges),
+        myEfforts(edges.size()),
+        myLeaveTimes(edges.size()),
+        myPrev(edges.size(), -1),
+        myStamps(edges.size(), 0),
+        myQueryStamp(0),
         myErrorMsgHandler(unbuildIsWarning ?  MsgHandler::getWarningInstance() : MsgHandler::getErrorInstance()) {
-        for (typename std::vector<E*>::const_iterator i = edges.begin(); i != edges.end(); ++i) {
-            myEdgeInfos.push_back(EdgeInfo(*i));
-        }
     }
 
     /// Destructor
     virtual ~DijkstraRouter() { }
 
     virtual SUMOAbstractRouter<E, V>* clone() {
-        return new DijkstraRouter<E, V, PF>(myEdgeInfos, myErrorMsgHandler == MsgHandler::getWarningInstance(), this->myOperation, myTTOperation);
+        return new DijkstraRouter<E, V, PF>(myEdges, myErrorMsgHandler == MsgHandler::getWarningInstance(), this->myOperation, myTTOperation);
     }
 
     inline double getTravelTime(const E* const e, const V* const v, const double t, const double effort) const {
@@ -143,15 +98,14 @@ public:
     }
 
     void init() {
-        // all EdgeInfos touched in the previous query are either in myFrontierList or myFound: clean those up
-        for (typename std::vector<EdgeInfo*>::iterator i = myFrontierList.begin(); i != myFrontierList.end(); i++) {
-            (*i)->reset();
+        // entries stamped by previous queries are invalidated by the new stamp
+        myFrontier.clear();
+        myQueryStamp += 2;
+        if (myQueryStamp == 0) {
+            // the stamp wrapped around, so old stamps may look current
+            std::fill(myStamps.begin(), myStamps.end(), 0);
+            myQueryStamp = 2;
         }
-        myFrontierList.clear();
-        for (typename std::vector<EdgeInfo*>::iterator i = myFound.begin(); i != myFound.end(); i++) {
-            (*i)->reset();
-        }
-        myFound.clear();
     }
 
 
@@ -175,75 +129,70 @@ public:
 #endif
         const SUMOVehicleClass vClass = vehicle == 0 ? SVC_IGNORING : vehicle->getVClass();
         if (this->myBulkMode) {
-            const EdgeInfo& toInfo = myEdgeInfos[to->getNumericalID()];
-            if (toInfo.visited) {
-                buildPathFrom(&toInfo, into);
+            const int toID = to->getNumericalID();
+            if (myStamps[toID] == myQueryStamp + 1) {
+                buildPathFrom(toID, into);
                 this->endQuery(1);
                 return true;
             }
         } else {
-            init();
-            // add begin node
-            EdgeInfo* const fromInfo = &(myEdgeInfos[from->getNumericalID()]);
-            fromInfo->effort = 0;
-            fromInfo->prev = 0;
-            fromInfo->leaveTime = STEPS2TIME(msTime);
-            myFrontierList.push_back(fromInfo);
+            initSearch(from, msTime);
         }
         // loop
         int num_visited = 0;
-        while (!myFrontierList.empty()) {
-            num_visited += 1;
+        while (!myFrontier.empty()) {
             // use the node with the minimal length
-            EdgeInfo* const minimumInfo = myFrontierList.front();
-            const E* const minEdge = minimumInfo->edge;
+            const int minID = myFrontier.front().second;
+            if (myStamps[minID] != myQueryStamp || myFrontier.front().first != myEfforts[minID]) {
+                // already visited or reached again with a smaller effort
+                pop_heap(myFrontier.begin(), myFrontier.end(), myComparator);
+                myFrontier.pop_back();
+                continue;
+            }
+            num_visited += 1;
+            const E* const minEdge = myEdges[minID];
             // check whether the destination node was already reached
             if (minEdge == to) {
-                buildPathFrom(minimumInfo, into);
+                buildPathFrom(minID, into);
                 this->endQuery(num_visited);
 #ifdef DijkstraRouter_DEBUG_QUERY_PERF
                 std::cout << "visited " + toString(num_visited) + " edges (final path length=" + toString(into.size()) + " edges=" + toString(into) + ")\n";
 #endif
                 return true;
             }
-            pop_heap(myFrontierList.begin(), myFrontierList.end(), myComparator);
-            myFrontierList.pop_back();
-            myFound.push_back(minimumInfo);
-            minimumInfo->visited = true;
+            pop_heap(myFrontier.begin(), myFrontier.end(), myComparator);
+            myFrontier.pop_back();
+            myStamps[minID] = myQueryStamp + 1;
+            const double minLeaveTime = myLeaveTimes[minID];
 #ifdef DijkstraRouter_DEBUG_QUERY
-            std::cout << "DEBUG: hit '" << minEdge->getID() << "' Eff: " << minimumInfo->effort << ", TT: " << minimumInfo->leaveTime << " Q: ";
-            for (typename std::vector<EdgeInfo*>::iterator it = myFrontierList.begin(); it != myFrontierList.end(); it++) {
-                std::cout << (*it)->effort << "," << (*it)->edge->getID() << " ";
+            std::cout << "DEBUG: hit '" << minEdge->getID() << "' Eff: " << myEfforts[minID] << ", TT: " << minLeaveTime << " Q: ";
+            for (typename std::vector<FrontierEntry>::iterator it = myFrontier.begin(); it != myFrontier.end(); it++) {
+                std::cout << it->first << "," << myEdges[it->second]->getID() << " ";
             }
             std::cout << "\n";
 #endif
-            const double effortDelta = this->getEffort(minEdge, vehicle, minimumInfo->leaveTime);
-            const double effort = minimumInfo->effort + effortDelta;
-            const double leaveTime = minimumInfo->leaveTime + getTravelTime(minEdge, vehicle, minimumInfo->leaveTime, effortDelta);
-            assert(effort >= minimumInfo->effort);
-            assert(leaveTime >= minimumInfo->leaveTime);
+            const double effortDelta = this->getEffort(minEdge, vehicle, minLeaveTime);
+            const double effort = myEfforts[minID] + effortDelta;
+            const double leaveTime = minLeaveTime + getTravelTime(minEdge, vehicle, minLeaveTime, effortDelta);
+            assert(effort >= myEfforts[minID]);
+            assert(leaveTime >= minLeaveTime);
             // check all ways from the node with the minimal length
             const std::vector<E*>& successors = minEdge->getSuccessors(vClass);
             for (typename std::vector<E*>::const_iterator it = successors.begin(); it != successors.end(); ++it) {
                 const E* const follower = *it;
-                EdgeInfo* const followerInfo = &(myEdgeInfos[follower->getNumericalID()]);
+                const int followerID = follower->getNumericalID();
                 // check whether it can be used
                 if (PF::operator()(follower, vehicle)) {
                     continue;
                 }
-                const double oldEffort = followerInfo->effort;
-                if (!followerInfo->visited && effort < oldEffort) {
-                    followerInfo->effort = effort;
-                    followerInfo->leaveTime = leaveTime;
-                    followerInfo->prev = minimumInfo;
-                    if (oldEffort == std::numeric_limits<double>::max()) {
-                        myFrontierList.push_back(followerInfo);
-                        push_heap(myFrontierList.begin(), myFrontierList.end(), myComparator);
-                    } else {
-                        push_heap(myFrontierList.begin(),
-                                  find(myFrontierList.begin(), myFrontierList.end(), followerInfo) + 1,
-                                  myComparator);
-                    }
+                const unsigned int stamp = myStamps[followerID];
+                if (stamp < myQueryStamp || (stamp == myQueryStamp && effort < myEfforts[followerID])) {
+                    myStamps[followerID] = myQueryStamp;
+                    myEfforts[followerID] = effort;
+                    myLeaveTimes[followerID] = leaveTime;
+                    myPrev[followerID] = minID;
+                    myFrontier.push_back(std::make_pair(effort, followerID));
+                    push_heap(myFrontier.begin(), myFrontier.end(), myComparator);
                 }
             }
         }
@@ -273,41 +222,62 @@ public:
     }
 
     /// Builds the path from marked edges
-    void buildPathFrom(const EdgeInfo* rbegin, std::vector<const E*>& edges) {
+    void buildPathFrom(int index, std::vector<const E*>& edges) const {
         std::vector<const E*> tmp;
-        while (rbegin != 0) {
-            tmp.push_back(rbegin->edge);
-            rbegin = rbegin->prev;
+        while (index >= 0) {
+            tmp.push_back(myEdges[index]);
+            index = myPrev[index];
         }
         std::copy(tmp.rbegin(), tmp.rend(), std::back_inserter(edges));
     }
 
-    const EdgeInfo& getEdgeInfo(int index) const {
-        return myEdgeInfos[index];
+    /// @brief Returns the effort to reach the edge with the given index in the last query (max if it was not reached)
+    double getEffortFromStart(int index) const {
+        return myStamps[index] >= myQueryStamp && myQueryStamp > 0 ? myEfforts[index] : std::numeric_limits<double>::max();
     }
 
 private:
-    DijkstraRouter(const std::vector<EdgeInfo>& edgeInfos, bool unbuildIsWarning, Operation effortOperation, Operation ttOperation) :
-        SUMOAbstractRouter<E, V>(effortOperation, "DijkstraRouter"), myTTOperation(ttOperation),
-        myErrorMsgHandler(unbuildIsWarning ? MsgHandler::getWarningInstance() : MsgHandler::getErrorInstance()) {
-        for (const EdgeInfo& ei : edgeInfos) {
-            myEdgeInfos.push_back(EdgeInfo(ei.edge));
-        }
+    /// @brief starts a new query at the given edge
+    void initSearch(const E* from, SUMOTime msTime) {
+        init();
+        const int fromID = from->getNumericalID();
+        myStamps[fromID] = myQueryStamp;
+        myEfforts[fromID] = 0;
+        myPrev[fromID] = -1;
+        myLeaveTimes[fromID] = STEPS2TIME(msTime);
+        myFrontier.push_back(std::make_pair(0., fromID));
     }
 
 private:
+    /// @brief an edge in the frontier with the effort it was reached with
+    typedef std::pair<double, int> FrontierEntry;
+
     /// @brief The object's operation to perform for travel times
     Operation myTTOperation;
 
-    /// The container of edge information
-    std::vector<EdgeInfo> myEdgeInfos;
+    /// @brief all edges with numerical ids
+    const std::vector<E*>& myEdges;
+
+    /// @brief Effort to reach the edge
+    std::vector<double> myEfforts;
+
+    /// @brief The time the vehicle leaves the edge
+    std::vector<double> myLeaveTimes;
+
+    /// @brief The index of the previous edge (-1 for the start)
+    std::vector<int> myPrev;
+
+    /// @brief The query stamp of the edge (the current stamp if reached, the next if visited)
+    std::vector<unsigned int> myStamps;
+
+    /// @brief The stamp of the current query
+    unsigned int myQueryStamp;
 
     /// A container for reusage of the min edge heap
-    std::vector<EdgeInfo*> myFrontierList;
-    /// @brief list of visited Edges (for resetting)
-    std::vector<EdgeInfo*> myFound;
+    std::vector<FrontierEntry> myFrontier;
 
-    EdgeInfoByEffortComparator myComparator;
+    /// @brief orders the heap by effort and numerical id, the smallest one first
+    std::greater<FrontierEntry> myComparator;
 
     /// @brief the handler for routing errors
     MsgHandler* const myErrorMsgHandler;
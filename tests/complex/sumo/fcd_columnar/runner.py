@@ -0,0 +1,53 @@
+#!/usr/bin/env python
+# Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+# Copyright (C) 2018-2018 German Aerospace Center (DLR) and others.
+# This program and the accompanying materials
+# are made available under the terms of the Eclipse Public License v2.0
+# which accompanies this distribution, and is available at
+# http://www.eclipse.org/legal/epl-v20.html
+# SPDX-License-Identifier: EPL-2.0
+
+# @file    runner.py
+# @author  Michael Behrisch
+# @date    2018-11-20
+# @version $Id$
+
+from __future__ import absolute_import
+from __future__ import print_function
+
+import os
+import subprocess
+import sys
+import difflib
+toolDir = os.path.join(
+    os.path.dirname(__file__), '..', '..', '..', '..', "tools")
+if 'SUMO_HOME' in os.environ:
+    toolDir = os.path.join(os.environ['SUMO_HOME'], "tools")
+sys.path.append(toolDir)
+import sumolib  # noqa
+
+
+def body(fileName):
+    # skip the header comment and the attributes of the root element
+    lines = open(fileName).readlines()
+    for i, line in enumerate(lines):
+        if line.startswith("<fcd-export"):
+            return lines[i + 1:]
+    return []
+
+
+sumoBinary = sumolib.checkBinary('sumo')
+columnar2xml = os.path.join(toolDir, 'output', 'fcdColumnar2xml.py')
+
+# write the xml and the columnar output in the same run
+subprocess.call([sumoBinary, "-c", "sumo.sumocfg"], stdout=sys.stdout, stderr=sys.stderr)
+sys.stdout.flush()
+# convert the columnar output back to xml
+subprocess.call([sys.executable, columnar2xml, "-o", "roundtrip.xml", "fcd.bin"], stdout=sys.stdout, stderr=sys.stderr)
+sys.stdout.flush()
+
+direct = body("fcd.xml")
+if not direct:
+    print("empty fcd output")
+for line in difflib.unified_diff(direct, body("roundtrip.xml"), n=0):
+    sys.stdout.write(line)
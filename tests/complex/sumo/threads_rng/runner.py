@@ -0,0 +1,68 @@
+#!/usr/bin/env python
+# Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+# Copyright (C) 2018-2018 German Aerospace Center (DLR) and others.
+# This program and the accompanying materials
+# are made available under the terms of the Eclipse Public License v2.0
+# which accompanies this distribution, and is available at
+# http://www.eclipse.org/legal/epl-v20.html
+# SPDX-License-Identifier: EPL-2.0
+
+# @file    runner.py
+# @author  Michael Behrisch
+# @date    2018-11-27
+# @version $Id$
+
+"""
+Runs a junction with foes ignored by probability (jmIgnoreFoeProb) and drivers
+with a reduced awareness (driver state noise after a ToC) once with a single
+thread and once with four threads and compares the trajectories.
+"""
+
+from __future__ import absolute_import
+from __future__ import print_function
+
+import os
+import sys
+import difflib
+toolDir = os.path.join(
+    os.path.dirname(__file__), '..', '..', '..', '..', "tools")
+if 'SUMO_HOME' in os.environ:
+    toolDir = os.path.join(os.environ['SUMO_HOME'], "tools")
+sys.path.append(toolDir)
+import sumolib  # noqa
+import traci  # noqa
+
+
+def body(fileName):
+    # skip the header comment which contains the options
+    lines = open(fileName).readlines()
+    for i, line in enumerate(lines):
+        if line.startswith("<fcd-export"):
+            return lines[i + 1:]
+    return []
+
+
+def run(threads):
+    fcd = "fcd%s.xml" % threads
+    traci.start([sumolib.checkBinary('sumo'), "-n", "input_net.net.xml", "-r", "input_routes.rou.xml",
+                 "--threads", str(threads), "--fcd-output", fcd, "--seed", "42",
+                 "--no-step-log", "--duration-log.disable"])
+    numToC = 0
+    while traci.simulation.getMinExpectedNumber() > 0:
+        traci.simulationStep()
+        for vehID in traci.simulation.getDepartedIDList():
+            if vehID.startswith("toc"):
+                # the driver takes over with a reduced awareness which is perturbed by the driver state
+                traci.vehicle.setParameter(vehID, "device.toc.requestToC", "2")
+                numToC += 1
+    traci.close()
+    return fcd, numToC
+
+
+serial, numToC = run(1)
+parallel, numToC4 = run(4)
+print("requested %s ToCs with one thread and %s with four threads" % (numToC, numToC4))
+if not body(serial):
+    print("empty fcd output")
+for line in difflib.unified_diff(body(serial), body(parallel), n=0):
+    sys.stdout.write(line)
@@ -0,0 +1,68 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+# Copyright (C) 2008-2018 German Aerospace Center (DLR) and others.
+# This program and the accompanying materials
+# are made available under the terms of the Eclipse Public License v2.0
+# which accompanies this distribution, and is available at
+# http://www.eclipse.org/legal/epl-v20.html
+# SPDX-License-Identifier: EPL-2.0
+
+# @file    runner.py
+# @author  Michael Behrisch
+# @date    2018-11-26
+# @version $Id$
+
+
+from __future__ import print_function
+from __future__ import absolute_import
+import os
+import subprocess
+import sys
+sys.path.append(os.path.join(os.environ['SUMO_HOME'], 'tools'))
+import traci
+import sumolib  # noqa
+
+SLOT_MASK = (1 << 24) - 1
+
+sumoBinary = sumolib.checkBinary('sumo')
+
+PORT = sumolib.miscutils.getFreeSocketPort()
+sumoProcess = subprocess.Popen([sumoBinary,
+                                '-c', 'sumo.sumocfg',
+                                '--remote-port', str(PORT)], stdout=sys.stdout)
+traci.init(PORT)
+traci.simulationStep()
+
+traci.vehicle.add("v0", "vertical")
+traci.simulationStep()
+h0 = traci.vehicle.getHandle("v0")
+print("handle valid", h0 >= 0)
+print("speed by handle", traci.vehicle.getSpeed("#%s" % h0) == traci.vehicle.getSpeed("v0"))
+print("road by handle", traci.vehicle.getRoadID("#%s" % h0))
+
+step = 0
+while "v0" in traci.vehicle.getIDList() and step < 1000:
+    traci.simulationStep()
+    step += 1
+print("v0 arrived", "v0" not in traci.vehicle.getIDList())
+try:
+    traci.vehicle.getSpeed("#%s" % h0)
+    print("stale handle resolved")
+except traci.TraCIException:
+    print("stale handle rejected")
+
+traci.vehicle.add("v1", "vertical")
+traci.simulationStep()
+h1 = traci.vehicle.getHandle("v1")
+print("slot reused", h1 & SLOT_MASK == h0 & SLOT_MASK)
+print("generation changed", h1 != h0)
+print("new handle road", traci.vehicle.getRoadID("#%s" % h1))
+try:
+    traci.vehicle.getSpeed("#%s" % h0)
+    print("stale handle resolved")
+except traci.TraCIException:
+    print("stale handle rejected")
+
+traci.close()
+sumoProcess.wait()
@@ -0,0 +1,60 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+# Copyright (C) 2018-2018 German Aerospace Center (DLR) and others.
+# This program and the accompanying materials
+# are made available under the terms of the Eclipse Public License v2.0
+# which accompanies this distribution, and is available at
+# http://www.eclipse.org/legal/epl-v20.html
+# SPDX-License-Identifier: EPL-2.0
+
+# @file    fcdColumnar2xml.py
+# @author  Michael Behrisch
+# @date    2018-11-20
+# @version $Id$
+
+"""
+Converts the columnar binary FCD output (sumo option --fcd-output.columnar)
+into the xml format of --fcd-output.
+"""
+
+from __future__ import print_function
+from __future__ import absolute_import
+import os
+import sys
+from optparse import OptionParser
+sys.path.append(os.path.join(os.path.dirname(sys.argv[0]), '..'))
+from sumolib.output.fcdcolumnar import FCDFile
+
+
+def main():
+    optParser = OptionParser(usage="usage: %prog [options] <columnar fcd file>")
+    optParser.add_option("-o", "--output-file", dest="output", help="name of the xml output file (default stdout)")
+    optParser.add_option("-b", "--begin", type="float", default=0., help="first time step to convert [s]")
+    optParser.add_option("-e", "--end", type="float", help="last time step to convert [s]")
+    options, args = optParser.parse_args()
+    if len(args) != 1:
+        optParser.error("exactly one input file is needed")
+    fcd = FCDFile(args[0])
+    out = open(options.output, "w") if options.output else sys.stdout
+    out.write('<fcd-export>\n')
+    for time, rows in fcd.timesteps():
+        if time < options.begin:
+            continue
+        if options.end is not None and time > options.end:
+            break
+        if rows:
+            out.write('    <timestep time="%.2f">\n' % time)
+            for r in rows:
+                out.write(r.toXML(8 * " ", fcd.elevation, fcd.signals, fcd.posDigits, fcd.digits))
+            out.write('    </timestep>\n')
+        else:
+            out.write('    <timestep time="%.2f"/>\n' % time)
+    out.write('</fcd-export>\n')
+    fcd.close()
+    if options.output:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
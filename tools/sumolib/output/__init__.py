@@ -17,7 +17,7 @@ from __future__ import print_function
 from __future__ import absolute_import
 from xml.sax import make_parser
 from xml.sax.handler import ContentHandler
-from . import dump, inductionloop, convert
+from . import dump, inductionloop, convert, fcdcolumnar
 from sumolib.xml import *
 
 
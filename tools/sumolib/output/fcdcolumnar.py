@@ -0,0 +1,172 @@
+# -*- coding: utf-8 -*-
+# Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+# Copyright (C) 2018-2018 German Aerospace Center (DLR) and others.
+# This program and the accompanying materials
+# are made available under the terms of the Eclipse Public License v2.0
+# which accompanies this distribution, and is available at
+# http://www.eclipse.org/legal/epl-v20.html
+# SPDX-License-Identifier: EPL-2.0
+
+# @file    fcdcolumnar.py
+# @author  Michael Behrisch
+# @date    2018-11-20
+# @version $Id$
+
+"""
+Reader for the columnar binary FCD output of sumo (option --fcd-output.columnar).
+See src/microsim/output/MSFCDColumnarExport.h for a description of the format.
+"""
+
+from __future__ import print_function
+from __future__ import absolute_import
+import struct
+
+KINDS = ("vehicle", "person", "container")
+
+
+class FCDRow:
+
+    """A single row of the fcd output with the attributes of the xml output."""
+
+    __slots__ = ("kind", "id", "x", "y", "z", "angle", "type", "speed", "pos", "lane", "slope", "signals")
+
+    def edge(self):
+        return self.lane
+
+    def toXML(self, indent="", elevation=False, signals=False, posDigits=2, digits=2):
+        pf = "%%.%sf" % posDigits
+        f = "%%.%sf" % digits
+        attrs = [("id", self.id), ("x", pf % self.x), ("y", pf % self.y)]
+        if elevation:
+            attrs.append(("z", f % self.z))
+        attrs.append(("angle", f % self.angle))
+        if self.kind == "vehicle":
+            attrs += [("type", self.type), ("speed", f % self.speed), ("pos", f % self.pos)]
+            if self.lane:
+                attrs.append(("lane", self.lane))
+            attrs.append(("slope", f % self.slope))
+            if signals and self.lane:
+                attrs.append(("signals", str(self.signals)))
+        else:
+            attrs += [("speed", f % self.speed), ("pos", f % self.pos),
+                      ("edge", self.lane), ("slope", f % self.slope)]
+        return '%s<%s %s/>\n' % (indent, self.kind, " ".join(['%s="%s"' % a for a in attrs]))
+
+
+class _Buffer:
+
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def varint(self):
+        result = 0
+        shift = 0
+        while True:
+            b = ord(self.data[self.pos:self.pos + 1])
+            self.pos += 1
+            result |= (b & 0x7f) << shift
+            if b < 0x80:
+                return result
+            shift += 7
+
+    def signedVarint(self):
+        v = self.varint()
+        return (v >> 1) ^ -(v & 1)
+
+    def bytes(self, n):
+        result = self.data[self.pos:self.pos + n]
+        self.pos += n
+        return result
+
+
+def _indices(buf, numRows):
+    column = _Buffer(buf.bytes(buf.varint()))
+    return [column.varint() for _ in range(numRows)]
+
+
+def _values(buf, ids, scale):
+    column = _Buffer(buf.bytes(buf.varint()))
+    last = {}
+    result = []
+    for i in ids:
+        q = last.get(i, 0) + column.signedVarint()
+        last[i] = q
+        result.append(q / scale)
+    return result
+
+
+class FCDFile:
+
+    """Gives access to the header information and the time steps of a columnar fcd file."""
+
+    def __init__(self, filename):
+        self._file = open(filename, "rb")
+        header = self._file.read(8)
+        if len(header) < 8 or header[:4] != b"SFCD":
+            raise ValueError("'%s' is not a columnar fcd file" % filename)
+        version, flags, self.posDigits, self.digits = struct.unpack("<BBBB", header[4:])
+        if version != 1:
+            raise ValueError("Unsupported version %s of columnar fcd file '%s'" % (version, filename))
+        self.elevation = bool(flags & 1)
+        self.signals = bool(flags & 2)
+        self.geo = bool(flags & 4)
+
+    def close(self):
+        self._file.close()
+
+    def chunks(self):
+        """yields the raw chunks as tuples (steps, columns), steps being a list of (time, numRows)"""
+        while True:
+            size = self._file.read(4)
+            if len(size) < 4:
+                return
+            buf = _Buffer(self._file.read(struct.unpack("<I", size)[0]))
+            strings = [buf.bytes(buf.varint()).decode("utf8") for _ in range(buf.varint())]
+            steps = []
+            time = 0
+            for _ in range(buf.varint()):
+                time += buf.signedVarint()
+                steps.append((time, buf.varint()))
+            numRows = sum([s[1] for s in steps])
+            posScale = 10. ** self.posDigits
+            scale = 10. ** self.digits
+            columns = {}
+            columns["kind"] = [KINDS[k] for k in _indices(buf, numRows)]
+            ids = _indices(buf, numRows)
+            columns["id"] = [strings[i] for i in ids]
+            columns["x"] = _values(buf, ids, posScale)
+            columns["y"] = _values(buf, ids, posScale)
+            columns["z"] = _values(buf, ids, scale) if self.elevation else [0.] * numRows
+            columns["angle"] = _values(buf, ids, scale)
+            columns["type"] = [strings[i] for i in _indices(buf, numRows)]
+            columns["speed"] = _values(buf, ids, scale)
+            columns["pos"] = _values(buf, ids, scale)
+            columns["lane"] = [strings[i] for i in _indices(buf, numRows)]
+            columns["slope"] = _values(buf, ids, scale)
+            columns["signals"] = _indices(buf, numRows) if self.signals else [0] * numRows
+            yield steps, columns
+
+    def timesteps(self):
+        """yields tuples (time in s, list of FCDRow)"""
+        for steps, columns in self.chunks():
+            row = 0
+            for time, numRows in steps:
+                rows = []
+                for i in range(row, row + numRows):
+                    r = FCDRow()
+                    for attr in FCDRow.__slots__:
+                        setattr(r, attr, columns[attr][i])
+                    rows.append(r)
+                row += numRows
+                yield time / 1000., rows
+
+
+def parse(filename):
+    """yields tuples (time in s, list of FCDRow) for all time steps of the given file"""
+    f = FCDFile(filename)
+    try:
+        for step in f.timesteps():
+            yield step
+    finally:
+        f.close()
@@ -69,6 +69,7 @@ def _readNextTLS(result):
 
 
 _RETURN_VALUE_FUNC = {tc.VAR_SPEED: Storage.readDouble,
+                      tc.VAR_HANDLE: Storage.readInt,
                       tc.VAR_SPEED_WITHOUT_TRACI: Storage.readDouble,
                       tc.VAR_ACCELERATION: Storage.readDouble,
                       tc.VAR_POSITION: lambda result: result.read("!dd"),
@@ -161,6 +162,16 @@ class VehicleDomain(Domain):
                         tc.CMD_SUBSCRIBE_VEHICLE_CONTEXT, tc.RESPONSE_SUBSCRIBE_VEHICLE_CONTEXT,
                         _RETURN_VALUE_FUNC)
 
+    def getHandle(self, vehID):
+        """getHandle(string) -> integer
+
+        Returns the numerical handle of the named vehicle. While the vehicle
+        exists, "#<handle>" may be used instead of its id in all vehicle commands.
+        The handle of a removed vehicle becomes invalid and does not refer to
+        a vehicle added later.
+        """
+        return self._getUniversal(tc.VAR_HANDLE, vehID)
+
     def getSpeed(self, vehID):
         """getSpeed(string) -> double
 
@@ -588,6 +588,12 @@ VAR_ACTIONSTEPLENGTH = 0x7d
 #  last action time (get: vehicles)
 VAR_LASTACTIONTIME = 0x7f
 
+#  typed platooning data exchange, see PLEXE_DATA_* in CC_Const.h (get & set: vehicles)
+VAR_PLEXE_DATA = 0x1b
+
+#  numerical handle, usable as id "#<handle>" while the vehicle exists (get: vehicles)
+VAR_HANDLE = 0x1c
+
 #  driver's desired headway (get: vehicle types)
 VAR_TAU = 0x48
 
@@ -0,0 +1,146 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    MSLinkTest.cpp
+/// @author  Michael Behrisch
+/// @date    2018-11-24
+/// @version $Id$
+///
+// Tests the registry of approaching vehicles of MSLink
+/****************************************************************************/
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <chrono>
+#include <iostream>
+#include <gtest/gtest.h>
+#include <utils/common/ToString.h>
+#include <microsim/MSLink.h>
+#include "SUMOVehicleMock.h"
+
+
+class MSLinkTest : public testing::Test {
+protected :
+    MSLink* link;
+    std::vector<SUMOVehicle*> vehicles;
+
+    virtual void SetUp() {
+        // a minor link without lanes, opened() cannot be called but blockedAtTime can
+        link = new MSLink(0, 0, 0, LINKDIR_STRAIGHT, LINKSTATE_MINOR, 10., 4.5, false, 0, -1);
+        for (int i = 0; i < 64; ++i) {
+            vehicles.push_back(new SUMOVehicleMock("veh" + toString(i), 10.));
+        }
+    }
+
+    virtual void TearDown() {
+        delete link;
+        for (std::vector<SUMOVehicle*>::iterator i = vehicles.begin(); i != vehicles.end(); ++i) {
+            delete *i;
+        }
+        vehicles.clear();
+    }
+
+    static MSLink::ApproachingVehicleInformation info(const SUMOTime arrival, const bool willPass = true) {
+        return MSLink::ApproachingVehicleInformation(arrival, arrival + 2000, 10., 10., willPass, arrival + 1000, 5., 0, 50.);
+    }
+};
+
+
+/* Test the method 'setApproaching'. The vehicles are kept sorted by id and a second registration is ignored.*/
+TEST_F(MSLinkTest, test_method_setApproaching) {
+    for (int i = 9; i >= 0; --i) {
+        link->setApproaching(vehicles[i * 3], info(i * 1000));
+    }
+    const MSLink::ApproachInfos& approaching = link->getApproaching();
+    ASSERT_EQ(10, (int)approaching.size());
+    for (int i = 1; i < 10; ++i) {
+        EXPECT_LT(approaching[i - 1].first->getID(), approaching[i].first->getID());
+    }
+    link->setApproaching(vehicles[9], info(99000));
+    EXPECT_EQ(10, (int)approaching.size());
+    EXPECT_EQ(3000, link->getApproaching(vehicles[9]).arrivalTime);
+}
+
+
+/* Test the method 'removeApproaching'.*/
+TEST_F(MSLinkTest, test_method_removeApproaching) {
+    link->setApproaching(vehicles[0], info(1000));
+    link->setApproaching(vehicles[1], info(2000));
+    link->removeApproaching(vehicles[0]);
+    EXPECT_EQ(1, (int)link->getApproaching().size());
+    EXPECT_EQ(-1000, link->getApproaching(vehicles[0]).arrivalTime);
+    EXPECT_EQ(2000, link->getApproaching(vehicles[1]).arrivalTime);
+    // removing an unknown vehicle does nothing
+    link->removeApproaching(vehicles[0]);
+    EXPECT_EQ(1, (int)link->getApproaching().size());
+    EXPECT_TRUE(link->isBlockingAnyone());
+    link->removeApproaching(vehicles[1]);
+    EXPECT_FALSE(link->isBlockingAnyone());
+}
+
+
+/* Test the method 'blockedAtTime'.*/
+TEST_F(MSLinkTest, test_method_blockedAtTime) {
+    link->setApproaching(vehicles[0], info(5000));
+    // the foe has left when we arrive
+    EXPECT_FALSE(link->blockedAtTime(20000, 21000, 10., 10., false, 0., 4.5, 0));
+    // the foe is still on the link when we arrive
+    EXPECT_TRUE(link->blockedAtTime(5500, 6500, 10., 10., false, 0., 4.5, 0));
+    std::vector<const SUMOVehicle*> foes;
+    EXPECT_FALSE(link->blockedAtTime(5500, 6500, 10., 10., false, 0., 4.5, 0, &foes));
+    ASSERT_EQ(1, (int)foes.size());
+    EXPECT_EQ(vehicles[0], foes.front());
+    // foes which do not want to pass do not block
+    link->removeApproaching(vehicles[0]);
+    link->setApproaching(vehicles[0], info(5000, false));
+    EXPECT_FALSE(link->blockedAtTime(5500, 6500, 10., 10., false, 0., 4.5, 0));
+}
+
+
+/* A micro benchmark for the registry of approaching vehicles. Each step all
+ * vehicles register anew (as MSVehicle does) and a number of requests check
+ * the link with blockedAtTime (which opened() calls for every foe link).
+ * It is disabled by default, run it with --gtest_also_run_disabled_tests.*/
+TEST_F(MSLinkTest, DISABLED_benchmark_approaching) {
+    const int steps = 20000;
+    const int sizes[] = {1, 4, 16, 64};
+    for (int n : sizes) {
+        int blocked = 0;
+        const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        for (int s = 0; s < steps; ++s) {
+            const SUMOTime t = s * 1000;
+            for (int i = 0; i < n; ++i) {
+                link->removeApproaching(vehicles[i]);
+            }
+            for (int i = 0; i < n; ++i) {
+                const int v = (i * 7) % n;
+                link->setApproaching(vehicles[v], info(t + v * 250, v % 4 != 0));
+            }
+            for (int q = 0; q < 8; ++q) {
+                const SUMOTime arrival = t + q * 2000;
+                if (link->blockedAtTime(arrival, arrival + 1000, 10., 10., false, 0., 4.5, 0)) {
+                    blocked++;
+                }
+            }
+        }
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        std::cout << "approaching vehicles: " << n << ", steps: " << steps << ", blocked requests: " << blocked << ", time: " << ms << "ms\n";
+        EXPECT_GT(blocked, 0);
+        for (int i = 0; i < n; ++i) {
+            link->removeApproaching(vehicles[i]);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    MSVehicleControlTest.cpp
+/// @author  Michael Behrisch
+/// @date    2018-11-26
+/// @version $Id$
+///
+// Tests the numerical vehicle handles of MSVehicleControl
+/****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <utils/common/ToString.h>
+#include <utils/options/Option.h>
+#include <utils/options/OptionsCont.h>
+#include <microsim/MSVehicleControl.h>
+#include "SUMOVehicleMock.h"
+
+
+class MSVehicleControlTest : public testing::Test {
+protected :
+    static void SetUpTestCase() {
+        // the vehicle control reads the scaling on construction
+        OptionsCont& oc = OptionsCont::getOptions();
+        if (!oc.exists("scale")) {
+            oc.doRegister("scale", new Option_Float(1.));
+        }
+    }
+
+    /// @brief the slot of a handle (the generation is stored above the lower 24 bits)
+    static int slot(const int handle) {
+        return handle & ((1 << 24) - 1);
+    }
+};
+
+
+/* Test that handles and ids resolve to the same vehicle. */
+TEST_F(MSVehicleControlTest, test_method_getVehicleByHandle) {
+    MSVehicleControl control;
+    SUMOVehicleMock* a = new SUMOVehicleMock("a");
+    SUMOVehicleMock* b = new SUMOVehicleMock("b");
+    EXPECT_TRUE(control.addVehicle("a", a));
+    EXPECT_TRUE(control.addVehicle("b", b));
+    EXPECT_FALSE(control.addVehicle("a", a));
+    const int ha = control.getHandle("a");
+    const int hb = control.getHandle("b");
+    EXPECT_LE(0, ha);
+    EXPECT_LE(0, hb);
+    EXPECT_NE(ha, hb);
+    EXPECT_EQ(a, control.getVehicleByHandle(ha));
+    EXPECT_EQ(b, control.getVehicleByHandle(hb));
+    EXPECT_EQ(a, control.getVehicle("a"));
+    EXPECT_EQ(-1, control.getHandle("c"));
+    EXPECT_EQ(0, control.getVehicleByHandle(-1));
+    EXPECT_EQ(0, control.getVehicleByHandle(slot(hb) + 1));
+}
+
+
+/* Test that a reused slot gets a new generation, so the handle of a deleted vehicle stays invalid. */
+TEST_F(MSVehicleControlTest, test_handle_reuse) {
+    MSVehicleControl control;
+    EXPECT_TRUE(control.addVehicle("keep", new SUMOVehicleMock("keep")));
+    SUMOVehicleMock* first = new SUMOVehicleMock("first");
+    EXPECT_TRUE(control.addVehicle("first", first));
+    const int hFirst = control.getHandle("first");
+    control.deleteVehicle(first);
+    EXPECT_EQ(-1, control.getHandle("first"));
+    EXPECT_EQ(0, control.getVehicleByHandle(hFirst));
+
+    std::vector<int> stale(1, hFirst);
+    for (int i = 0; i < 5; ++i) {
+        const std::string id = "next" + toString(i);
+        SUMOVehicleMock* next = new SUMOVehicleMock(id);
+        EXPECT_TRUE(control.addVehicle(id, next));
+        const int h = control.getHandle(id);
+        EXPECT_EQ(slot(hFirst), slot(h)) << "the freed slot should be reused";
+        EXPECT_EQ(next, control.getVehicleByHandle(h));
+        for (std::vector<int>::const_iterator it = stale.begin(); it != stale.end(); ++it) {
+            EXPECT_NE(*it, h);
+            EXPECT_EQ(0, control.getVehicleByHandle(*it)) << "stale handle " << *it << " resolves to '" << id << "'";
+        }
+        stale.push_back(h);
+        control.deleteVehicle(next);
+    }
+    EXPECT_EQ("keep", control.getVehicleByHandle(control.getHandle("keep"))->getID());
+}
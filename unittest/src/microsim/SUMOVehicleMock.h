@@ -0,0 +1,203 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    SUMOVehicleMock.h
+/// @author  Michael Behrisch
+/// @date    2018-11-24
+/// @version $Id$
+///
+// A vehicle which only knows its id, speed and lateral position
+/****************************************************************************/
+
+#ifndef SUMOVehicle_Mock_h
+#define SUMOVehicle_Mock_h
+
+#include <utils/common/UtilExceptions.h>
+#include <utils/geom/Position.h>
+#include <utils/vehicle/SUMOVehicle.h>
+#include <utils/vehicle/SUMOVehicleParameter.h>
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class SUMOVehicleMock
+ * Mock Implementation for Unit Tests, everything besides the id, the speed,
+ *  the lateral position and the (default) parameters either returns a default or throws
+ */
+class SUMOVehicleMock : public SUMOVehicle {
+public:
+    /// @brief Constructor
+    SUMOVehicleMock(const std::string& id, const double speed = 0., const double posLat = 0.)
+        : myID(id), mySpeed(speed), myPosLat(posLat) {}
+
+    /// @brief Destructor
+    ~SUMOVehicleMock() {}
+
+    const std::string& getID() const {
+        return myID;
+    }
+    double getSpeed() const {
+        return mySpeed;
+    }
+    double getPreviousSpeed() const {
+        return mySpeed;
+    }
+    double getLateralPositionOnLane() const {
+        return myPosLat;
+    }
+
+    double getPositionOnLane() const {
+        return 0.;
+    }
+    double getBackPositionOnLane(const MSLane* /* lane */) const {
+        return 0.;
+    }
+    double getAngle() const {
+        return 0.;
+    }
+    Position getPosition(const double /* offset */ = 0) const {
+        return Position::INVALID;
+    }
+    double getMaxSpeed() const {
+        return mySpeed;
+    }
+    MSLane* getLane() const {
+        return 0;
+    }
+    const MSVehicleType& getVehicleType() const {
+        throw ProcessError("SUMOVehicleMock has no type");
+    }
+    SUMOVehicleClass getVClass() const {
+        return SVC_PASSENGER;
+    }
+    const MSRoute& getRoute() const {
+        throw ProcessError("SUMOVehicleMock has no route");
+    }
+    const MSEdge* succEdge(int /* nSuccs */) const {
+        return 0;
+    }
+    bool replaceRouteEdges(ConstMSEdgeVector& /* edges */, bool /* onInit */ = false, bool /* check */ = false, bool /* removeStops */ = true) {
+        return false;
+    }
+    bool replaceRoute(const MSRoute* /* route */, bool /* onInit */ = false, int /* offset */ = 0, bool /* addStops */ = true, bool /* removeStops */ = true) {
+        return false;
+    }
+    void reroute(SUMOTime /* t */, SUMOAbstractRouter<MSEdge, SUMOVehicle>& /* router */, const bool /* onInit */ = false, const bool /* withTaz */ = false) {}
+    bool hasValidRoute(std::string& /* msg */, const MSRoute* /* route */ = 0) const {
+        return false;
+    }
+    const ConstMSEdgeVector::const_iterator& getCurrentRouteEdge() const {
+        throw ProcessError("SUMOVehicleMock has no route");
+    }
+    double getAcceleration() const {
+        return 0.;
+    }
+    double getSlope() const {
+        return 0.;
+    }
+    const MSEdge* getEdge() const {
+        return 0;
+    }
+    const SUMOVehicleParameter& getParameter() const {
+        return myParameter;
+    }
+    void onDepart() {}
+    bool isOnRoad() const {
+        return true;
+    }
+    bool isFrontOnLane(const MSLane*) const {
+        return false;
+    }
+    bool isParking() const {
+        return false;
+    }
+    bool isRemoteControlled() const {
+        return false;
+    }
+    SUMOTime getDeparture() const {
+        return 0;
+    }
+    double getDepartPos() const {
+        return 0.;
+    }
+    double getArrivalPos() const {
+        return 0.;
+    }
+    void setArrivalPos(double /* arrivalPos */) {}
+    bool hasDeparted() const {
+        return true;
+    }
+    bool hasArrived() const {
+        return false;
+    }
+    int getNumberReroutes() const {
+        return 0;
+    }
+    const std::vector<MSDevice*>& getDevices() const {
+        return myDevices;
+    }
+    void addPerson(MSTransportable* /* person */) {}
+    void addContainer(MSTransportable* /* container */) {}
+    bool addStop(const SUMOVehicleParameter::Stop& /* stopPar */, std::string& /* errorMsg */, SUMOTime /* untilOffset */ = 0, bool /* collision */ = false,
+                 ConstMSEdgeVector::const_iterator* /* searchStart */ = 0) {
+        return false;
+    }
+    MSParkingArea* getNextParkingArea() {
+        return 0;
+    }
+    bool replaceParkingArea(MSParkingArea* /* parkingArea */, std::string& /* errorMsg */) {
+        return false;
+    }
+    bool isStopped() const {
+        return false;
+    }
+    SUMOTime remainingStopDuration() const {
+        return 0;
+    }
+    bool isStoppedTriggered() const {
+        return false;
+    }
+    bool isStoppedInRange(double /* pos */) const {
+        return false;
+    }
+    MSDevice* getDevice(const std::type_info& /* type */) const {
+        return 0;
+    }
+    double getChosenSpeedFactor() const {
+        return 1.;
+    }
+    void setChosenSpeedFactor(const double /* factor */) {}
+    SUMOTime getWaitingTime() const {
+        return 0;
+    }
+    SUMOTime getAccumulatedWaitingTime() const {
+        return 0;
+    }
+    SUMOTime getDepartDelay() const {
+        return 0;
+    }
+    double getImpatience() const {
+        return 0.;
+    }
+    bool isSelected() const {
+        return false;
+    }
+    void saveState(OutputDevice& /* out */) {}
+    void loadState(const SUMOSAXAttributes& /* attrs */, const SUMOTime /* offset */) {}
+
+private:
+    const std::string myID;
+    const double mySpeed;
+    const double myPosLat;
+    const std::vector<MSDevice*> myDevices;
+    const SUMOVehicleParameter myParameter;
+};
+
+#endif
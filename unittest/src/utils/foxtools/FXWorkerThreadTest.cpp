@@ -25,6 +25,8 @@
 #include <config.h>
 #endif
 
+#include <set>
+#include <vector>
 #include <gtest/gtest.h>
 #include <utils/common/StdDefs.h>
 #include <utils/foxtools/FXWorkerThread.h>
@@ -35,6 +37,17 @@ public:
     }
 };
 
+class SleepTask : public FXWorkerThread::Task {
+public:
+    SleepTask(const FXlong duration) : myDuration(duration), myContext(0) {}
+    void run(FXWorkerThread* context) {
+        FXThread::sleep(myDuration);
+        myContext = context;
+    }
+    const FXlong myDuration;
+    FXWorkerThread* myContext;
+};
+
 // ===========================================================================
 // test definitions
 // ===========================================================================
@@ -57,3 +70,29 @@ TEST(FXWorkerThread, test_get_all) {
     g.waitAll();
 }
 
+/* Test that idle workers take over the pending tasks of a busy one.*/
+TEST(FXWorkerThread, test_work_stealing) {
+    FXWorkerThread::Pool g(4, true);
+    std::vector<SleepTask*> slow;
+    for (int i = 0; i < 8; i++) {
+        slow.push_back(new SleepTask(20000000));
+        g.add(slow.back(), 0);
+    }
+    // wake up the other workers, they steal when running out of their own tasks
+    std::vector<SleepTask*> fast;
+    for (int i = 1; i < 4; i++) {
+        fast.push_back(new SleepTask(0));
+        g.add(fast.back(), i);
+    }
+    g.waitAll(false);
+    std::set<FXWorkerThread*> workers;
+    for (SleepTask* const t : slow) {
+        EXPECT_TRUE(t->myContext != 0);
+        workers.insert(t->myContext);
+        delete t;
+    }
+    for (SleepTask* const t : fast) {
+        delete t;
+    }
+    EXPECT_LT(1, (int)workers.size());
+}
@@ -0,0 +1,116 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    BinaryInputDeviceTest.cpp
+/// @author  Michael Behrisch
+/// @date    2018-11-22
+/// @version $Id$
+///
+// Tests the class BinaryInputDevice
+/****************************************************************************/
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <utils/common/FileHelpers.h>
+#include <utils/common/UtilExceptions.h>
+#include <utils/geom/Position.h>
+#include <utils/iodevices/BinaryFormatter.h>
+#include <utils/iodevices/BinaryInputDevice.h>
+
+
+// ===========================================================================
+// test definitions
+// ===========================================================================
+class BinaryInputDeviceTest : public testing::Test {
+protected:
+    virtual void TearDown() {
+        std::remove(FILE_NAME);
+    }
+
+    static const char* const FILE_NAME;
+};
+
+const char* const BinaryInputDeviceTest::FILE_NAME = "BinaryInputDeviceTest.bin";
+
+
+/* Test reading scaled 3D positions, the z value has to be read and the following values must not be shifted. */
+TEST_F(BinaryInputDeviceTest, test_scaled_position_3d) {
+    {
+        std::ofstream out(FILE_NAME, std::ios::binary);
+        FileHelpers::writeByte(out, BinaryFormatter::BF_SCALED2INT_POSITION_3D);
+        FileHelpers::writeInt(out, 150);
+        FileHelpers::writeInt(out, -250);
+        FileHelpers::writeInt(out, 1025);
+        FileHelpers::writeByte(out, BinaryFormatter::BF_SCALED2INT_POSITION_2D);
+        FileHelpers::writeInt(out, 300);
+        FileHelpers::writeInt(out, 400);
+        FileHelpers::writeByte(out, BinaryFormatter::BF_INTEGER);
+        FileHelpers::writeInt(out, 42);
+    }
+    BinaryInputDevice in(FILE_NAME, true, false);
+    Position p;
+    in >> p;
+    EXPECT_DOUBLE_EQ(1.5, p.x());
+    EXPECT_DOUBLE_EQ(-2.5, p.y());
+    EXPECT_DOUBLE_EQ(10.25, p.z());
+    in >> p;
+    EXPECT_DOUBLE_EQ(3., p.x());
+    EXPECT_DOUBLE_EQ(4., p.y());
+    EXPECT_DOUBLE_EQ(0., p.z());
+    int i;
+    in >> i;
+    EXPECT_EQ(42, i);
+}
+
+
+/* Test that reading beyond the end of a truncated file raises an error instead of returning garbage. */
+TEST_F(BinaryInputDeviceTest, test_truncated_input) {
+    {
+        std::ofstream out(FILE_NAME, std::ios::binary);
+        FileHelpers::writeByte(out, BinaryFormatter::BF_INTEGER);
+        FileHelpers::writeInt(out, 7);
+        FileHelpers::writeByte(out, BinaryFormatter::BF_FLOAT);
+        out.write("ab", 2);
+    }
+    BinaryInputDevice in(FILE_NAME, true, false);
+    int i;
+    in >> i;
+    EXPECT_EQ(7, i);
+    double d;
+    EXPECT_THROW(in >> d, ProcessError);
+}
+
+
+/* Test that a string whose length exceeds the remaining file raises an error. */
+TEST_F(BinaryInputDeviceTest, test_truncated_string) {
+    {
+        std::ofstream out(FILE_NAME, std::ios::binary);
+        FileHelpers::writeByte(out, BinaryFormatter::BF_STRING);
+        FileHelpers::writeInt(out, 10);
+        out.write("short", 5);
+    }
+    BinaryInputDevice in(FILE_NAME, true, false);
+    std::string s;
+    EXPECT_THROW(in >> s, ProcessError);
+}
+
+
+/* Test that a missing type byte at the end of the file raises an error. */
+TEST_F(BinaryInputDeviceTest, test_missing_type) {
+    {
+        std::ofstream out(FILE_NAME, std::ios::binary);
+    }
+    BinaryInputDevice in(FILE_NAME, true, false);
+    int i;
+    EXPECT_THROW(in >> i, ProcessError);
+}
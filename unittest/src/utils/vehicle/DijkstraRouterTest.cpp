@@ -0,0 +1,165 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    DijkstraRouterTest.cpp
+/// @author  Michael Behrisch
+/// @date    2018-11-25
+/// @version $Id$
+///
+// Tests the class DijkstraRouter
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <utils/common/ToString.h>
+#include <utils/vehicle/DijkstraRouter.h>
+
+
+// ===========================================================================
+// helper classes
+// ===========================================================================
+class TestVehicle {
+public:
+    const std::string& getID() const {
+        return myID;
+    }
+    SUMOVehicleClass getVClass() const {
+        return SVC_PASSENGER;
+    }
+private:
+    const std::string myID = "veh";
+};
+
+
+class TestEdge {
+public:
+    TestEdge(int numericalID, double length) :
+        myID("e" + toString(numericalID)), myNumericalID(numericalID), myLength(length) {}
+    const std::string& getID() const {
+        return myID;
+    }
+    int getNumericalID() const {
+        return myNumericalID;
+    }
+    const std::vector<TestEdge*>& getSuccessors(SUMOVehicleClass /* vClass */) const {
+        return mySuccessors;
+    }
+    static double getLength(const TestEdge* const edge, const TestVehicle* const /* veh */, double /* time */) {
+        return edge->myLength;
+    }
+    std::vector<TestEdge*> mySuccessors;
+private:
+    const std::string myID;
+    const int myNumericalID;
+    const double myLength;
+};
+
+
+typedef DijkstraRouter<TestEdge, TestVehicle, noProhibitions<TestEdge, TestVehicle> > TestRouter;
+
+
+class DijkstraRouterTest : public testing::Test {
+protected :
+    std::vector<TestEdge*> edges;
+
+    /* A grid of 6x6 nodes with edges in both directions and strongly varying lengths,
+     * so edges are often reached first on a longer route. The last edge has no connections. */
+    virtual void SetUp() {
+        const int size = 6;
+        std::vector<std::vector<TestEdge*> > outgoing(size * size);
+        std::vector<int> targets;
+        for (int node = 0; node < size * size; ++node) {
+            const int x = node % size;
+            const int y = node / size;
+            const int neighbors[] = {x > 0 ? node - 1 : -1, x < size - 1 ? node + 1 : -1, y > 0 ? node - size : -1, y < size - 1 ? node + size : -1};
+            for (int n : neighbors) {
+                if (n >= 0) {
+                    const int id = (int)edges.size();
+                    TestEdge* e = new TestEdge(id, 1. + (id * 37) % 47 * (id % 5 == 0 ? 10 : 1));
+                    edges.push_back(e);
+                    outgoing[node].push_back(e);
+                    targets.push_back(n);
+                }
+            }
+        }
+        for (int i = 0; i < (int)edges.size(); ++i) {
+            edges[i]->mySuccessors = outgoing[targets[i]];
+        }
+        edges.push_back(new TestEdge((int)edges.size(), 10.));
+    }
+
+    virtual void TearDown() {
+        for (std::vector<TestEdge*>::iterator i = edges.begin(); i != edges.end(); ++i) {
+            delete *i;
+        }
+        edges.clear();
+    }
+};
+
+
+/* Test that routes computed in bulk mode (continuing the search of the first query
+ * from the same origin) equal the routes of separate queries.*/
+TEST_F(DijkstraRouterTest, test_bulk_mode) {
+    TestVehicle veh;
+    TestRouter single(edges, true, &TestEdge::getLength);
+    TestRouter bulk(edges, true, &TestEdge::getLength);
+    const int numEdges = (int)edges.size();
+    const int origins[] = {0, 17, numEdges / 2, numEdges - 2};
+    for (int origin : origins) {
+        const TestEdge* const from = edges[origin];
+        // destinations in an order which needs both continued searches and already visited edges
+        std::vector<const TestEdge*> destinations;
+        for (int i = 0; i < numEdges; i += 3) {
+            destinations.push_back(edges[(origin * 13 + i * 29) % numEdges]);
+        }
+        destinations.push_back(edges.back());
+        destinations.push_back(edges[(origin + 1) % (numEdges - 1)]);
+        bulk.setBulkMode(false);
+        for (const TestEdge* const to : destinations) {
+            std::vector<const TestEdge*> expected;
+            const bool found = single.compute(from, to, &veh, 0, expected);
+            std::vector<const TestEdge*> route;
+            EXPECT_EQ(found, bulk.compute(from, to, &veh, 0, route));
+            EXPECT_EQ(to != edges.back(), found);
+            EXPECT_EQ(expected, route);
+            EXPECT_DOUBLE_EQ(single.recomputeCosts(expected, &veh, 0), bulk.recomputeCosts(route, &veh, 0));
+            bulk.setBulkMode(true);
+        }
+    }
+}
+
+
+/* Test that a new query after a bulk does not see the search state of the bulk.*/
+TEST_F(DijkstraRouterTest, test_new_query_after_bulk) {
+    TestVehicle veh;
+    TestRouter router(edges, true, &TestEdge::getLength);
+    std::vector<const TestEdge*> route;
+    EXPECT_TRUE(router.compute(edges[0], edges[40], &veh, 0, route));
+    router.setBulkMode(true);
+    route.clear();
+    EXPECT_TRUE(router.compute(edges[0], edges[50], &veh, 0, route));
+    router.setBulkMode(false);
+    route.clear();
+    EXPECT_TRUE(router.compute(edges[50], edges[0], &veh, 0, route));
+    ASSERT_FALSE(route.empty());
+    EXPECT_EQ(edges[50], route.front());
+    EXPECT_EQ(edges[0], route.back());
+}
+